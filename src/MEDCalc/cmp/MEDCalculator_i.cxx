@@ -23,10 +23,183 @@
 #include "SALOME_KernelServices.hxx"
 #include "Basics_Utils.hxx"
 #include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <pthread.h>
 
+#include "MEDLoader.hxx"
 #include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingFieldFloat.hxx"
+#include "MCAuto.hxx"
+#include "MEDCalculatorDBCompiledExpr.hxx"
 using namespace MEDCoupling;
 
+namespace
+{
+  // Number of threads reading and merging the steps in reduceOverTime
+  const std::size_t NB_OF_REDUCTION_THREADS = 4;
+
+  // One step of a reduction over time: the field if it is already
+  // loaded in the data manager, else where to read it from.
+  typedef struct
+  {
+    const MEDCouplingFieldDouble * loaded;
+    std::string filePath;
+    std::string meshName;
+    std::string fieldName;
+    TypeOfField type;
+    int iteration;
+    int order;
+    double weight;
+  } reductionstep_st;
+
+  // State of a reduction over time shared by the threads. acc holds
+  // the running result (the rank of the step reaching best for
+  // TIME_ARGMAX). The MED file reads are serialized by ioMutex, the
+  // file mutex of the data manager shared with its prefetch thread.
+  typedef struct
+  {
+    const std::vector<reductionstep_st> * steps;
+    MEDCALC::TimeReduction reduction;
+    std::size_t next;
+    pthread_mutex_t mutex;
+    pthread_mutex_t * ioMutex;
+    MCAuto<MEDCouplingFieldDouble> acc;
+    MCAuto<DataArrayDouble> best;
+    std::string error;
+  } reduction_st;
+
+  // Merges the step of rank i in the running result. Expects the
+  // mutex of st to be held. Returns false if the step does not have
+  // the same number of values than the previous ones.
+  bool mergeStep(reduction_st * st, std::size_t i, const MEDCouplingFieldDouble * f)
+  {
+    const DataArrayDouble * arr = f->getArray();
+    if ( st->acc.isNull() ) {
+      MCAuto<DataArrayDouble> acc(DataArrayDouble::New());
+      acc->alloc(arr->getNumberOfTuples(),arr->getNumberOfComponents());
+      acc->copyStringInfoFrom(*arr);
+      double init = 0.;
+      if ( st->reduction == MEDCALC::TIME_MIN )
+        init = std::numeric_limits<double>::max();
+      if ( st->reduction == MEDCALC::TIME_MAX )
+        init = -std::numeric_limits<double>::max();
+      acc->fillWithValue(init);
+      if ( st->reduction == MEDCALC::TIME_ARGMAX ) {
+        st->best = DataArrayDouble::New();
+        st->best->alloc(arr->getNumberOfTuples(),arr->getNumberOfComponents());
+        st->best->fillWithValue(-std::numeric_limits<double>::max());
+      }
+      st->acc = f->clone(false);
+      st->acc->setArray(acc);
+    }
+    DataArrayDouble * accArr = st->acc->getArray();
+    if ( accArr->getNumberOfTuples() != arr->getNumberOfTuples() ||
+         accArr->getNumberOfComponents() != arr->getNumberOfComponents() )
+      return false;
+    double * a = accArr->getPointer();
+    const double * p = arr->begin();
+    const double * pe = arr->end();
+    double w = (*st->steps)[i].weight;
+    switch ( st->reduction ) {
+    case MEDCALC::TIME_MEAN:
+    case MEDCALC::TIME_INTEGRAL:
+      for ( ; p != pe; p++, a++ )
+        *a += w*(*p);
+      break;
+    case MEDCALC::TIME_RMS:
+      for ( ; p != pe; p++, a++ )
+        *a += w*(*p)*(*p);
+      break;
+    case MEDCALC::TIME_MIN:
+      for ( ; p != pe; p++, a++ )
+        *a = std::min(*a,*p);
+      break;
+    case MEDCALC::TIME_MAX:
+      for ( ; p != pe; p++, a++ )
+        *a = std::max(*a,*p);
+      break;
+    case MEDCALC::TIME_ARGMAX:
+      {
+        // On equality the first step wins, whatever the merge order
+        double * b = st->best->getPointer();
+        for ( ; p != pe; p++, a++, b++ ) {
+          if ( *p > *b || (*p == *b && (double)i < *a) ) {
+            *b = *p;
+            *a = (double)i;
+          }
+        }
+        break;
+      }
+    default:
+      break;
+    }
+    return true;
+  }
+
+  // Body of the threads of reduceOverTime: each thread holds only the
+  // step it is merging. The steps that are not loaded in the data
+  // manager are read from file and released after the merge.
+  void * th_reduceovertime(void * s)
+  {
+    reduction_st * st = (reduction_st *)s;
+    while ( true ) {
+      pthread_mutex_lock(&st->mutex);
+      std::size_t i = st->next++;
+      bool stop = !st->error.empty() || i >= st->steps->size();
+      pthread_mutex_unlock(&st->mutex);
+      if ( stop )
+        break;
+      const reductionstep_st & step = (*st->steps)[i];
+      std::string error;
+      try {
+        MCAuto<MEDCouplingFieldDouble> read;
+        const MEDCouplingFieldDouble * f = step.loaded;
+        if ( !f ) {
+          MCAuto<MEDCouplingField> tmpp;
+          pthread_mutex_lock(st->ioMutex);
+          try {
+            tmpp = ReadField(step.type, step.filePath, step.meshName, 0, step.fieldName, step.iteration, step.order);
+          }
+          catch (std::exception &) {
+            pthread_mutex_unlock(st->ioMutex);
+            throw;
+          }
+          pthread_mutex_unlock(st->ioMutex);
+          read = DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(tmpp);
+          if ( read.isNull() ) {
+            MCAuto<MEDCouplingFieldFloat> readFloat(DynamicCast<MEDCouplingField,MEDCouplingFieldFloat>(tmpp));
+            if ( !readFloat.isNull() )
+              read = readFloat->convertToDblField();
+          }
+          if ( read.isNull() )
+            throw INTERP_KERNEL::Exception("ERROR: the field "+step.fieldName+" is neither a double nor a float field");
+          f = read;
+        }
+        if ( !f->getArray() || !f->getArray()->isAllocated() )
+          throw INTERP_KERNEL::Exception("ERROR: a step of the field has no values");
+        pthread_mutex_lock(&st->mutex);
+        bool ok = mergeStep(st, i, f);
+        pthread_mutex_unlock(&st->mutex);
+        if ( !ok )
+          throw INTERP_KERNEL::Exception("ERROR: the steps of the field do not have the same number of values");
+      }
+      catch (std::exception &ex) {
+        error = ex.what();
+      }
+      if ( !error.empty() ) {
+        pthread_mutex_lock(&st->mutex);
+        if ( st->error.empty() )
+          st->error = error;
+        pthread_mutex_unlock(&st->mutex);
+      }
+    }
+    return 0;
+  }
+}
+
 MEDCalculator_i * MEDCalculator_i::_instance = NULL;
 
 MEDCalculator_i * MEDCalculator_i::getInstance() {
@@ -248,7 +421,8 @@ MEDCALC::FieldHandler * MEDCalculator_i::pow(const MEDCALC::FieldHandler & f_hdl
   try {
     field_result = field->clone(true);
     std::string functionToApply = "u^"+ToString(power);
-    field_result->applyFunc(functionToApply.c_str());
+    MCAuto<MEDCalculatorDBCompiledExpr> expr = MEDCalculatorDBCompiledExpr::New(functionToApply);
+    expr->apply(field_result);
   }
   catch (INTERP_KERNEL::Exception &ex) {
     throw KERNEL::createSalomeException(ex.what());
@@ -287,7 +461,8 @@ MEDCALC::FieldHandler * MEDCalculator_i::lin(const MEDCALC::FieldHandler & f_hdl
   try {
     field_result = field->clone(true);
     std::string functionToApply = "u*"+ToString(factor)+"+"+ToString(offset);
-    field_result->applyFunc(functionToApply.c_str());
+    MCAuto<MEDCalculatorDBCompiledExpr> expr = MEDCalculatorDBCompiledExpr::New(functionToApply);
+    expr->apply(field_result);
   }
   catch (INTERP_KERNEL::Exception &ex) {
     throw KERNEL::createSalomeException(ex.what());
@@ -364,12 +539,16 @@ MEDCALC::FieldHandler * MEDCalculator_i::fct(const MEDCALC::FieldHandler & f_hdl
   MEDCouplingFieldDouble* field_result;
   try {
     field_result = field->clone(true);
+    // The function is compiled once and evaluated on blocks of tuples
+    // (see MEDCalculatorDBCompiledExpr), with the same results as the
+    // MEDCoupling interpreter.
+    MCAuto<MEDCalculatorDBCompiledExpr> expr = MEDCalculatorDBCompiledExpr::New(function);
     if ( (nbResComponents == MEDCALC::NBCOMP_DEFAULT ) ||
 	 (nbResComponents < 1) || (nbResComponents > (int)field_result->getNumberOfComponents()) ) {
-      field_result->applyFunc(function);
+      expr->apply(field_result);
     }
     else {
-      field_result->applyFunc(nbResComponents,function);
+      expr->apply(nbResComponents,field_result);
     }
   }
   catch (INTERP_KERNEL::Exception &ex) {
@@ -386,3 +565,104 @@ MEDCALC::FieldHandler * MEDCalculator_i::fct(const MEDCALC::FieldHandler & f_hdl
                        meshHandlerId);
   return fieldResultHandler;
 }
+
+/*!
+ * This function realizes a reduction over time (mean, min, max, root
+ * mean square, integral or rank of the max) of the steps of a
+ * fieldseries, sorted by timestamp, from the rank firstStep to the
+ * rank lastStep excluded (LASTSTEP_DEFAULT for all the steps up to the
+ * last one).
+ *
+ * The steps are streamed: the ones that are not already loaded in the
+ * MEDDataManager are read from file by a few threads, merged in the
+ * result and released, so that the memory footprint does not depend
+ * on the number of steps. Only the resulting field is registered in
+ * the MEDDataManager.
+ */
+MEDCALC::FieldHandler * MEDCalculator_i::reduceOverTime(CORBA::Long fieldseriesId,
+             CORBA::Long firstStep, CORBA::Long lastStep, MEDCALC::TimeReduction reduction)
+{
+  MEDCALC::FieldHandlerList_var fieldHandlerList = _medDataManager->getFieldListInFieldseries(fieldseriesId);
+  std::vector< std::pair<double,CORBA::ULong> > sortedSteps;
+  for ( CORBA::ULong i = 0; i < fieldHandlerList->length(); i++ ) {
+    double timestamp = _medDataManager->getFieldTimestamp(fieldHandlerList[i].id);
+    sortedSteps.push_back(std::make_pair(timestamp,i));
+  }
+  std::stable_sort(sortedSteps.begin(),sortedSteps.end());
+
+  long nbOfSteps = sortedSteps.size();
+  if ( lastStep == MEDCALC::LASTSTEP_DEFAULT ) {
+    lastStep = nbOfSteps;
+  }
+  if ( firstStep < 0 || lastStep > nbOfSteps || firstStep >= lastStep ) {
+    std::string message =
+      std::string("ERROR: invalid range of steps [") + ToString(firstStep) + std::string(",") +
+      ToString(lastStep) + std::string("[ for a fieldseries of ") + ToString(nbOfSteps) + std::string(" steps");
+    throw KERNEL::createSalomeException(message.c_str());
+  }
+
+  std::size_t nbOfReducedSteps = lastStep-firstStep;
+  std::vector<reductionstep_st> steps(nbOfReducedSteps);
+  std::vector<double> timestamps(nbOfReducedSteps);
+  for ( std::size_t i = 0; i < nbOfReducedSteps; i++ ) {
+    timestamps[i] = sortedSteps[firstStep+i].first;
+    const MEDCALC::FieldHandler & fieldHandler = fieldHandlerList[sortedSteps[firstStep+i].second];
+    reductionstep_st & step = steps[i];
+    step.loaded = _medDataManager->getLoadedFieldDouble(fieldHandler.id);
+    step.type = (TypeOfField)fieldHandler.type;
+    step.iteration = fieldHandler.iteration;
+    step.order = fieldHandler.order;
+    step.fieldName = fieldHandler.fieldname;
+    if ( !step.loaded ) {
+      step.filePath = _medDataManager->getFieldFilePath(&fieldHandler);
+      step.meshName = _medDataManager->getUMesh(fieldHandler.meshid)->getName();
+    }
+    step.weight = 1./(double)nbOfReducedSteps;
+  }
+  if ( reduction == MEDCALC::TIME_INTEGRAL ) {
+    // Trapezoid rule: each step weights half of its two adjacent time intervals
+    for ( std::size_t i = 0; i < nbOfReducedSteps; i++ ) {
+      double before = i > 0 ? timestamps[i-1] : timestamps[i];
+      double after = i+1 < nbOfReducedSteps ? timestamps[i+1] : timestamps[i];
+      steps[i].weight = (after-before)/2.;
+    }
+  }
+
+  reduction_st st;
+  st.steps = &steps;
+  st.reduction = reduction;
+  st.next = 0;
+  pthread_mutex_init(&st.mutex,NULL);
+  st.ioMutex = _medDataManager->getFileMutex();
+  std::size_t nbOfThreads = std::min(nbOfReducedSteps,NB_OF_REDUCTION_THREADS);
+  std::vector<pthread_t> threads(nbOfThreads);
+  for ( std::size_t i = 0; i < nbOfThreads; i++ )
+    pthread_create(&threads[i],NULL,th_reduceovertime,(void*)&st);
+  for ( std::size_t i = 0; i < nbOfThreads; i++ )
+    pthread_join(threads[i],NULL);
+  pthread_mutex_destroy(&st.mutex);
+  if ( !st.error.empty() ) {
+    throw KERNEL::createSalomeException(st.error.c_str());
+  }
+
+  DataArrayDouble * resultArray = st.acc->getArray();
+  if ( reduction == MEDCALC::TIME_RMS ) {
+    double * pt = resultArray->getPointer();
+    for ( std::size_t i = 0; i < resultArray->getNbOfElems(); i++ )
+      pt[i] = sqrt(pt[i]);
+  }
+  resultArray->declareAsNew();
+
+  static const char * reductionNames[6] = { "mean", "min", "max", "rms", "integral", "argmax" };
+  const MEDCALC::FieldHandler & firstHandler = fieldHandlerList[sortedSteps[firstStep].second];
+  long meshHandlerId = firstHandler.meshid;
+  MEDCouplingFieldDouble * field_result = st.acc.retn();
+  field_result->setMesh(_medDataManager->getUMesh(meshHandlerId));
+  field_result->setTime(timestamps[0],firstHandler.iteration,firstHandler.order);
+  std::string name = std::string(reductionNames[reduction]) + "(" + std::string(firstHandler.fieldname) + ")";
+  field_result->setName(name.c_str());
+
+  MEDCALC::FieldHandler * fieldResultHandler = _medDataManager->addField(field_result,
+                       meshHandlerId);
+  return fieldResultHandler;
+}
@@ -51,6 +51,9 @@ public:
   MEDCALC_EXPORT MEDCALC::FieldHandler * fct(const MEDCALC::FieldHandler & f_hdl,
           const char * function, CORBA::Long nbResComponents);
 
+  MEDCALC_EXPORT MEDCALC::FieldHandler * reduceOverTime(CORBA::Long fieldseriesId,
+          CORBA::Long firstStep, CORBA::Long lastStep, MEDCALC::TimeReduction reduction);
+
   //
   // ===========================================================
   // Other public functions (non available via CORBA)
@@ -25,12 +25,49 @@
 #include "Basics_Utils.hxx"
 
 #include "MEDLoader.hxx"
+#include "MEDFileField.hxx"
 using namespace MEDCoupling;
 
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <limits>
 using namespace std;
 
+namespace
+{
+  // Holds the mutex of the MED files as long as it exists
+  class FileLock
+  {
+  public:
+    FileLock(pthread_mutex_t * mutex):_mutex(mutex) { pthread_mutex_lock(_mutex); }
+    ~FileLock() { pthread_mutex_unlock(_mutex); }
+  private:
+    pthread_mutex_t * _mutex;
+  };
+
+  std::size_t FieldMemorySize(const MEDCouplingFieldDouble * field)
+  {
+    std::size_t nbOfBytes = 0;
+    std::vector<DataArrayDouble *> arrays = field->getArrays();
+    for (std::size_t i = 0; i < arrays.size(); i++) {
+      if ( arrays[i] != NULL && arrays[i]->isAllocated() ) {
+        nbOfBytes += arrays[i]->getNbOfElems()*sizeof(double);
+      }
+    }
+    return nbOfBytes;
+  }
+
+  // Memory of the values of a step read from a file, and of their
+  // description
+  std::size_t FileFieldMemorySize(const MEDFileAnyTypeField1TS * field)
+  {
+    return field->getHeapMemorySize();
+  }
+}
+
 MEDDataManager_i * MEDDataManager_i::_instance = NULL;
 long MEDDataManager_i::LONG_UNDEFINED = -1;
 
@@ -51,11 +88,47 @@ MEDDataManager_i::MEDDataManager_i()
   _sourceLastId = 0;
   _meshLastId = 0;
   _fieldseriesLastId = 0;
+  _memoryBudget = 0;
+  _memoryInUse = 0;
+  _scratch = NULL;
+  _scratchSize = 0;
+  _nbOfHits = 0;
+  _nbOfMisses = 0;
+  _nbOfEvictions = 0;
+  _nbOfSpills = 0;
+  _nbOfReloads = 0;
+  pthread_mutex_init(&_fileMutex,NULL);
+  pthread_mutex_init(&_prefetchMutex,NULL);
+  pthread_cond_init(&_prefetchCond,NULL);
+  _prefetchThreadStarted = false;
+  _prefetchStop = false;
+  _prefetchDepth = 0;
+  _prefetchInProgress = LONG_UNDEFINED;
+  _prefetchGeneration = 0;
+  _prefetchedMemory = 0;
+  _prefetchAllowance = 0;
+  _prefetchStepSize = 0;
+  _nbOfPrefetched = 0;
+  _nbOfPrefetchHits = 0;
 }
 
 MEDDataManager_i::~MEDDataManager_i()
 {
   LOG("Deleting MEDDataManager_i instance");
+  if ( _prefetchThreadStarted ) {
+    pthread_mutex_lock(&_prefetchMutex);
+    _prefetchStop = true;
+    pthread_cond_broadcast(&_prefetchCond);
+    pthread_mutex_unlock(&_prefetchMutex);
+    pthread_join(_prefetchThread,NULL);
+  }
+  discardPrefetchedFields();
+  pthread_cond_destroy(&_prefetchCond);
+  pthread_mutex_destroy(&_prefetchMutex);
+  pthread_mutex_destroy(&_fileMutex);
+  if ( _scratch != NULL ) {
+    std::fclose(_scratch);
+  }
 }
 
 void MEDDataManager_i::cleanUp()
@@ -73,6 +146,24 @@ void MEDDataManager_i::cleanUp()
   _fieldDoubleMap.clear();
   _meshMap.clear();
   _fieldPersistencyMap.clear();
+  _meshIdsOfDatasource.clear();
+  _fieldseriesIdsOfMesh.clear();
+  _fieldIdsOfFieldseries.clear();
+  _datasourceIdOfUri.clear();
+  _meshIdOfUMesh.clear();
+  _fieldTimestampMap.clear();
+  _sortedTimestampsOfFieldseries.clear();
+  discardPrefetchedFields();
+  _memoryInUse = 0;
+  _fieldLRU.clear();
+  _fieldLRUPos.clear();
+  _fieldsReadFromFile.clear();
+  _spilledFieldMap.clear();
+  if ( _scratch != NULL ) {
+    std::fclose(_scratch);
+    _scratch = NULL;
+  }
+  _scratchSize = 0;
 }
 
 
@@ -117,8 +208,40 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
       return new MEDCALC::DatasourceHandler(*_datasourceHandlerMap[sourceid]);
   }
 
-  // Then we check that the file is readable by MEDLoader
-  CheckFileForRead(filepath);
+  // We start by reading the metadata of the file: the list of meshes
+  // (spatial supports of fields) and the structure of all the fields
+  // (names, meshes, spatial discretizations, iterations and times,
+  // without any value), each in one single opening of the file, after
+  // checking that the file is readable by MEDLoader.
+  vector<string> meshNames;
+  MCAuto<MEDFileFields> fields;
+  {
+    FileLock lock(&_fileMutex);
+    CheckFileForRead(filepath);
+    meshNames = GetMeshNames(filepath);
+    fields = MEDFileFields::New(filepath,false);
+  }
+  // A field may lie on several meshes: it is listed under each of them,
+  // with the positions of its time steps lying on it.
+  typedef std::vector< std::pair< int, std::vector<std::size_t> > > FieldStepsVec;
+  std::map< std::string, FieldStepsVec > fieldsOfMesh;
+  for (int i = 0; i < fields->getNumberOfFields(); i++) {
+    MCAuto<MEDFileAnyTypeFieldMultiTS> field(fields->getFieldAtPos(i));
+    std::vector<std::string> fieldMeshNames(field->getMeshesNames());
+    std::map< std::string, std::vector<std::size_t> > stepsOfMesh;
+    if (fieldMeshNames.size() <= 1) {
+      for (int j = 0; j < field->getNumberOfTS(); j++)
+        stepsOfMesh[field->getMeshName()].push_back(j);
+    }
+    else {
+      for (int j = 0; j < field->getNumberOfTS(); j++) {
+        MCAuto<MEDFileAnyTypeField1TS> step(field->getTimeStepAtPos(j));
+        stepsOfMesh[step->getMeshName()].push_back(j);
+      }
+    }
+    for (std::map< std::string, std::vector<std::size_t> >::const_iterator it = stepsOfMesh.begin(); it != stepsOfMesh.end(); ++it)
+      fieldsOfMesh[it->first].push_back(std::pair< int, std::vector<std::size_t> >(i, it->second));
+  }
 
   // Initialise the datasource handler
   MEDCALC::DatasourceHandler * datasourceHandler = new MEDCALC::DatasourceHandler();
@@ -127,11 +250,11 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
   std::string tmp(file_to_source(filepath));
   datasourceHandler->uri = CORBA::string_dup(tmp.c_str());
   _datasourceHandlerMap[datasourceHandler->id] = datasourceHandler;
+  _datasourceIdOfUri[tmp] = datasourceHandler->id;
 
-  // We start by read the list of meshes (spatial supports of fields)
-  vector<string> meshNames = GetMeshNames(filepath);
-  int nbOfMeshes = meshNames.size();
-  for (int iMesh = 0; iMesh < nbOfMeshes; iMesh++) {
+  // All the handlers are then built from these metadata, without
+  // opening the file again.
+  for (int iMesh = 0; iMesh < (int)meshNames.size(); iMesh++) {
       const char * meshName = meshNames[iMesh].c_str();
       LOG("name of mesh " << iMesh << " = " << meshName);
 
@@ -141,17 +264,26 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
       meshHandler->sourceid = datasourceHandler->id;
 
       _meshHandlerMap[meshHandler->id] = meshHandler;
+      _meshIdsOfDatasource[datasourceHandler->id].push_back(meshHandler->id);
 
-      // For each mesh, we can read the list of the names of the
-      // associated fields, i.e. fields whose spatial support is this
-      // mesh.
-      vector<string> fieldNames = GetAllFieldNamesOnMesh(filepath,
-          meshName);
-      int nbOfFields = fieldNames.size();
-      for (int iField = 0; iField < nbOfFields; iField++) {
-          const char * fieldName = fieldNames[iField].c_str();
+      // For each mesh, the fields whose spatial support is this mesh,
+      // in the order of the file, restricted to their steps on it.
+      std::map< std::string, FieldStepsVec >::const_iterator fieldsIt = fieldsOfMesh.find(meshNames[iMesh]);
+      if ( fieldsIt == fieldsOfMesh.end() ) {
+        continue;
+      }
+      const FieldStepsVec& fieldsOnMesh = fieldsIt->second;
+      for (std::size_t iField = 0; iField < fieldsOnMesh.size(); iField++) {
+          MCAuto<MEDFileAnyTypeFieldMultiTS> field(fields->getFieldAtPos(fieldsOnMesh[iField].first));
+          const std::vector<std::size_t>& stepsOnMesh = fieldsOnMesh[iField].second;
+          std::string fieldNameStr(field->getName());
+          const char * fieldName = fieldNameStr.c_str();
           LOG("-- name of field " << iField << " = " << fieldName);
 
+          // The iterations of the field, with their times
+          std::vector<double> times;
+          std::vector< std::pair<int,int> > allIterations(field->getTimeSteps(times));
+
           // A field name could identify several MEDCoupling fields, that
           // differ by their spatial discretization on the mesh (values on
           // cells, values on nodes, ...). This spatial discretization is
@@ -164,29 +296,32 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
 
           // As a consequence, before loading values of a field, we have
           // to determine the types of spatial discretization defined for
-          // this field and to choose one.
-
-          vector<TypeOfField> listOfTypes = GetTypesOfField(filepath,
-              meshName,
-              fieldName);
+          // this field (on each of its iterations) and to choose one.
+          std::vector< std::vector<TypeOfField> > typesOfIterations(field->getTypesOfFieldAvailable());
+          std::set<TypeOfField> setOfTypes;
+          for (std::size_t i = 0; i < stepsOnMesh.size(); i++)
+            setOfTypes.insert(typesOfIterations[stepsOnMesh[i]].begin(), typesOfIterations[stepsOnMesh[i]].end());
+          vector<TypeOfField> listOfTypes(setOfTypes.begin(), setOfTypes.end());
           int nbOfTypes = listOfTypes.size();
           for (int iType = 0; iType < nbOfTypes; iType++) {
               LOG("---- type "<<iType<<" of field "<<iField<< " = " << listOfTypes[iType]);
 
               // Then, we can get the iterations associated to this field on
-              // this type of spatial discretization:
-              std::vector< std::pair<int,int> > fieldIterations;
+              // this type of spatial discretization, with their times:
+              std::vector<std::size_t> fieldIterations;
 
               if (listOfTypes[iType] == MEDCoupling::ON_CELLS || listOfTypes[iType] == MEDCoupling::ON_NODES)
-                fieldIterations = GetFieldIterations(listOfTypes[iType],
-                      filepath, meshName, fieldName);
+                {
+                  for (std::size_t i = 0; i < stepsOnMesh.size(); i++) {
+                    const std::vector<TypeOfField>& types = typesOfIterations[stepsOnMesh[i]];
+                    if (std::find(types.begin(), types.end(), listOfTypes[iType]) != types.end())
+                      fieldIterations.push_back(stepsOnMesh[i]);
+                  }
+                }
               else
                 {
                   LOG("---- WARNING - field " << fieldName << " is not on CELLS or on NODES");
-                  typedef std::vector< std::pair< std::pair<int,int>, double> > TimeVec;
-                  TimeVec fieldIterTime = GetAllFieldIterations(filepath, fieldName);
-                  for (TimeVec::const_iterator it = fieldIterTime.begin(); it != fieldIterTime.end(); ++it)
-                    fieldIterations.push_back(it->first);
+                  fieldIterations = stepsOnMesh;
                 }
 
               int nbFieldIterations = fieldIterations.size();
@@ -202,12 +337,18 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
               fieldseriesHandler->meshid = meshHandler->id;
               fieldseriesHandler->nbIter = nbFieldIterations;
               _fieldseriesHandlerMap[fieldseriesHandler->id] = fieldseriesHandler;
+              _fieldseriesIdsOfMesh[meshHandler->id].push_back(fieldseriesHandler->id);
+              std::vector<long>& fieldIds = _fieldIdsOfFieldseries[fieldseriesHandler->id];
+              fieldIds.reserve(nbFieldIterations);
+              TimestampIdList& timestamps = _sortedTimestampsOfFieldseries[fieldseriesHandler->id];
+              timestamps.reserve(nbFieldIterations);
 
               // We can then load meta-data concerning all iterations
               for (int iterationIdx=0; iterationIdx<nbFieldIterations; iterationIdx++) {
 
-                  int iteration = fieldIterations[iterationIdx].first;
-                  int order = fieldIterations[iterationIdx].second;
+                  std::size_t pos = fieldIterations[iterationIdx];
+                  int iteration = allIterations[pos].first;
+                  int order = allIterations[pos].second;
 
                   const char * source = datasourceHandler->uri;
                   MEDCALC::FieldHandler * fieldHandler = newFieldHandler(fieldName,
@@ -220,8 +361,15 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
                   fieldHandler->meshid = meshHandler->id;
                   fieldHandler->fieldseriesId = fieldseriesHandler->id;
                   _fieldHandlerMap[fieldHandler->id] = fieldHandler;
+                  fieldIds.push_back(fieldHandler->id);
+                  // The times are kept, so that no request on the time of
+                  // a step (typically from the animation of a
+                  // presentation) has to open the file again.
+                  _fieldTimestampMap[fieldHandler->id] = times[pos];
+                  timestamps.push_back(std::pair<double,long>(times[pos], fieldHandler->id));
                   //    LOG("=== Storing " << fieldName << " (" << fieldHandler->id << ")");
               }
+              std::sort(timestamps.begin(), timestamps.end());
           }
       }
   }
@@ -230,29 +378,21 @@ MEDCALC::DatasourceHandler * MEDDataManager_i::loadDatasource(const char *filepa
 }
 
 long MEDDataManager_i::getDatasourceId(const char *filepath) {
-  std::string uri(file_to_source(filepath));
-  DatasourceHandlerMapIterator it = _datasourceHandlerMap.begin();
-  while ( it != _datasourceHandlerMap.end() ) {
-    if ( strcmp(it->second->uri,uri.c_str()) == 0 ) {
-      return it->first;
-    }
-    ++it;
+  DatasourceIdMapIterator it = _datasourceIdOfUri.find(file_to_source(filepath));
+  if ( it == _datasourceIdOfUri.end() ) {
+    return LONG_UNDEFINED;
   }
-  return LONG_UNDEFINED;
+  return it->second;
 }
 
 MEDCALC::DatasourceHandler*
 MEDDataManager_i::getDatasourceHandler(const char *filepath)
 {
-  std::string uri(file_to_source(filepath));
-  DatasourceHandlerMapIterator it = _datasourceHandlerMap.begin();
-  while ( it != _datasourceHandlerMap.end() ) {
-    if ( strcmp(it->second->uri,uri.c_str()) == 0 ) {
-      return it->second;
-    }
-    ++it;
+  long sourceid = getDatasourceId(filepath);
+  if ( sourceid == LONG_UNDEFINED ) {
+    return NULL;
   }
-  return NULL;
+  return getDatasourceHandlerFromID(sourceid);
 }
 
 MEDCALC::DatasourceHandler*
@@ -285,22 +425,18 @@ MEDCALC::MeshHandler * MEDDataManager_i::getMeshHandler(CORBA::Long meshId) {
  */
 MEDCALC::MeshHandlerList * MEDDataManager_i::getMeshHandlerList(CORBA::Long datasourceId) {
 
-  // We initiate a list with the maximum length
   MEDCALC::MeshHandlerList_var meshHandlerList = new MEDCALC::MeshHandlerList();
-  meshHandlerList->length(_meshHandlerMap.size());
-
-  // Scan the map looking for meshes associated to the specified datasource
-  int itemIdx = 0;
-  MeshHandlerMapIterator meshIt;
-  for ( meshIt=_meshHandlerMap.begin(); meshIt != _meshHandlerMap.end(); meshIt++) {
-    if ( meshIt->second->sourceid == datasourceId ) {
-      meshHandlerList[itemIdx] = *(meshIt->second);
-      itemIdx++;
-    }
+  ChildrenIdsMapIterator it = _meshIdsOfDatasource.find(datasourceId);
+  if ( it == _meshIdsOfDatasource.end() ) {
+    return meshHandlerList._retn();
   }
 
-  // Adjust the length to the real number of elements
-  meshHandlerList->length(itemIdx);
+  // The index gives the meshes of the datasource in increasing id order
+  const std::vector<long>& meshIds = it->second;
+  meshHandlerList->length(meshIds.size());
+  for (std::size_t i = 0; i < meshIds.size(); i++) {
+    meshHandlerList[i] = *(_meshHandlerMap[meshIds[i]]);
+  }
   return meshHandlerList._retn();
 }
 
@@ -309,23 +445,18 @@ MEDCALC::MeshHandlerList * MEDDataManager_i::getMeshHandlerList(CORBA::Long data
  * specified mesh.
  */
 MEDCALC::FieldseriesHandlerList * MEDDataManager_i::getFieldseriesListOnMesh(CORBA::Long meshId) {
-  // We initiate a list with the maximum length
   MEDCALC::FieldseriesHandlerList_var
     fieldseriesHandlerList = new MEDCALC::FieldseriesHandlerList();
-  fieldseriesHandlerList->length(_fieldseriesHandlerMap.size());
-
-  // Scan the map looking for fieldseries defined on the specified mesh
-  int itemIdx = 0;
-  FieldseriesHandlerMapIterator it;
-  for ( it=_fieldseriesHandlerMap.begin(); it != _fieldseriesHandlerMap.end(); it++) {
-    if ( it->second->meshid == meshId ) {
-      fieldseriesHandlerList[itemIdx] = *(it->second);
-      itemIdx++;
-    }
+  ChildrenIdsMapIterator it = _fieldseriesIdsOfMesh.find(meshId);
+  if ( it == _fieldseriesIdsOfMesh.end() ) {
+    return fieldseriesHandlerList._retn();
   }
 
-  // Adjust the length to the real number of elements
-  fieldseriesHandlerList->length(itemIdx);
+  const std::vector<long>& fieldseriesIds = it->second;
+  fieldseriesHandlerList->length(fieldseriesIds.size());
+  for (std::size_t i = 0; i < fieldseriesIds.size(); i++) {
+    fieldseriesHandlerList[i] = *(_fieldseriesHandlerMap[fieldseriesIds[i]]);
+  }
   return fieldseriesHandlerList._retn();
 }
 
@@ -334,22 +465,17 @@ MEDCALC::FieldseriesHandlerList * MEDDataManager_i::getFieldseriesListOnMesh(COR
  * the different time iterations defined for the specified field id.
  */
 MEDCALC::FieldHandlerList * MEDDataManager_i::getFieldListInFieldseries(CORBA::Long fieldseriesId) {
-  // We initiate a list with the maximum length
   MEDCALC::FieldHandlerList_var fieldHandlerList = new MEDCALC::FieldHandlerList();
-  fieldHandlerList->length(_fieldHandlerMap.size());
-
-  // Scan the map looking for field defined on the specified mesh
-  int itemIdx = 0;
-  FieldHandlerMapIterator it;
-  for ( it=_fieldHandlerMap.begin(); it != _fieldHandlerMap.end(); it++) {
-    if ( it->second->fieldseriesId == fieldseriesId ) {
-      fieldHandlerList[itemIdx] = *(it->second);
-      itemIdx++;
-    }
+  ChildrenIdsMapIterator it = _fieldIdsOfFieldseries.find(fieldseriesId);
+  if ( it == _fieldIdsOfFieldseries.end() ) {
+    return fieldHandlerList._retn();
   }
 
-  // Adjust the length to the real number of elements
-  fieldHandlerList->length(itemIdx);
+  const std::vector<long>& fieldIds = it->second;
+  fieldHandlerList->length(fieldIds.size());
+  for (std::size_t i = 0; i < fieldIds.size(); i++) {
+    fieldHandlerList[i] = *(_fieldHandlerMap[fieldIds[i]]);
+  }
   return fieldHandlerList._retn();
 }
 
@@ -357,24 +483,33 @@ MEDCALC::FieldHandlerList * MEDDataManager_i::getFieldListInFieldseries(CORBA::L
  *  Get the field id of a field series at a given timestep
  */
 CORBA::Long MEDDataManager_i::getFieldIdAtTimestamp(CORBA::Long fieldseriesId, double timestampOfPvAnimation) {
-  // Scan the map looking for field defined on the specified mesh at given timestep
-  int itemIdx = 0;
   CORBA::Long fieldId = 0;
-  double timestampOfField;
-  FieldHandlerMapIterator it;
-  for ( it=_fieldHandlerMap.begin(); it != _fieldHandlerMap.end(); it++) {
-    if ( it->second->fieldseriesId == fieldseriesId ) {
-      if (itemIdx == 0) {
-        // set the fieldId to the first one in case it is not found
-        fieldId = it->second->id;
-      }
-      timestampOfField = getFieldTimestamp(it->second->id);
-      if (timestampOfField == timestampOfPvAnimation) {
-        fieldId = it->second->id;
-        break;
-      }
-      itemIdx++;
+  ChildrenIdsMapIterator it = _fieldIdsOfFieldseries.find(fieldseriesId);
+  if ( it == _fieldIdsOfFieldseries.end() || it->second.empty() ) {
+    return fieldId;
+  }
+  // set the fieldId to the first one in case it is not found
+  fieldId = it->second[0];
+
+  // The (time, id) pairs of the fieldseries are sorted, the first pair
+  // not lower than (timestamp, -inf) is the field of lowest id at this
+  // timestamp if any. They are computed again if a field of the series
+  // has been modified since the loading.
+  SortedTimestampsMapIterator tsIt = _sortedTimestampsOfFieldseries.find(fieldseriesId);
+  if ( tsIt == _sortedTimestampsOfFieldseries.end() ) {
+    TimestampIdList timestamps;
+    const std::vector<long>& fieldIds = it->second;
+    for (std::size_t i = 0; i < fieldIds.size(); i++) {
+      timestamps.push_back(std::pair<double,long>(getFieldTimestamp(fieldIds[i]), fieldIds[i]));
     }
+    std::sort(timestamps.begin(), timestamps.end());
+    tsIt = _sortedTimestampsOfFieldseries.insert(std::make_pair((long)fieldseriesId, timestamps)).first;
+  }
+  const TimestampIdList& timestamps = tsIt->second;
+  TimestampIdList::const_iterator found = std::lower_bound(timestamps.begin(), timestamps.end(),
+      std::pair<double,long>(timestampOfPvAnimation, std::numeric_limits<long>::min()));
+  if ( found != timestamps.end() && found->first == timestampOfPvAnimation ) {
+    fieldId = found->second;
   }
   return fieldId;
 }
@@ -455,13 +590,17 @@ void MEDDataManager_i::saveFields(const char * filepath,
 
   try {
     bool writeFromScratch = true;
-    WriteField(filepath, fieldDouble, writeFromScratch);
+    {
+      FileLock lock(&_fileMutex);
+      WriteField(filepath, fieldDouble, writeFromScratch);
+    }
 
     writeFromScratch = false;
     for(CORBA::ULong i=1; i<fieldIdList.length(); i++) {
       fieldHandlerId = fieldIdList[i];
       fieldHandler = getFieldHandler(fieldHandlerId);
       fieldDouble = getFieldDouble(fieldHandler);
+      FileLock lock(&_fileMutex);
       WriteField(filepath, fieldDouble, writeFromScratch);
     }
   }
@@ -573,6 +712,11 @@ MEDCALC::FieldHandler * MEDDataManager_i::updateFieldHandler(CORBA::Long fieldHa
     fieldIt->second->iteration = iteration;
     fieldIt->second->order     = order;
     fieldIt->second->source    = source;
+    // The time of the step may have changed
+    _fieldTimestampMap.erase(fieldHandlerId);
+    if ( _fieldIdsOfFieldseries.count(fieldIt->second->fieldseriesId) > 0 ) {
+      _sortedTimestampsOfFieldseries.erase(fieldIt->second->fieldseriesId);
+    }
     // Return a copy
     return new MEDCALC::FieldHandler(*fieldIt->second);
   }
@@ -601,8 +745,12 @@ MEDCouplingUMesh * MEDDataManager_i::getUMesh(long meshHandlerId) {
     std::string filepath(source_to_file((_datasourceHandlerMap[sourceid])->uri));
     const char * meshName = _meshHandlerMap[meshHandlerId]->name;
     int meshDimRelToMax = 0;
-    myMesh = ReadUMeshFromFile(filepath,meshName,meshDimRelToMax);
+    {
+      FileLock lock(&_fileMutex);
+      myMesh = ReadUMeshFromFile(filepath,meshName,meshDimRelToMax);
+    }
     _meshMap[meshHandlerId] = myMesh;
+    _meshIdOfUMesh[myMesh] = meshHandlerId;
   }
   return myMesh;
 }
@@ -612,16 +760,11 @@ MEDCouplingUMesh * MEDDataManager_i::getUMesh(long meshHandlerId) {
  * registered with in the internal meshes map.
  */
 long MEDDataManager_i::getUMeshId(const MEDCouplingMesh * mesh) {
-  bool found = false;
-  MeshMapIterator it = _meshMap.begin();
-  while ( it != _meshMap.end() ) {
-    found = (it->second == mesh);
-    if (found) {
-      return it->first;
-    }
-    ++it;
+  MeshIdMapIterator it = _meshIdOfUMesh.find(mesh);
+  if ( it == _meshIdOfUMesh.end() ) {
+    return LONG_UNDEFINED;
   }
-  return LONG_UNDEFINED;
+  return it->second;
 }
 
 /**
@@ -630,6 +773,10 @@ long MEDDataManager_i::getUMeshId(const MEDCouplingMesh * mesh) {
 double MEDDataManager_i::getFieldTimestamp(CORBA::Long fieldHandlerId)
 {
   LOG("getFieldTimestamp(" << fieldHandlerId << ")");
+  FieldTimestampMapIterator cached = _fieldTimestampMap.find(fieldHandlerId);
+  if ( cached != _fieldTimestampMap.end() ) {
+    return cached->second;
+  }
   double timestamp(0);
   MEDCALC::FieldHandler * fieldHandler = getFieldHandler(fieldHandlerId);
 
@@ -642,8 +789,12 @@ double MEDDataManager_i::getFieldTimestamp(CORBA::Long fieldHandlerId)
     std::string fileName(source_to_file(meshSourceUri));
     const char * fieldName = fieldHandler->fieldname;
     //const char * meshName = _meshHandlerMap[meshHandlerId]->name; // todo: unused
-    timestamp = GetTimeAttachedOnFieldIteration(fileName.c_str(), fieldName, fieldHandler->iteration, fieldHandler->order);
+    {
+      FileLock lock(&_fileMutex);
+      timestamp = GetTimeAttachedOnFieldIteration(fileName.c_str(), fieldName, fieldHandler->iteration, fieldHandler->order);
+    }
     LOG("timestamp in med file is " << timestamp);
+    _fieldTimestampMap[fieldHandlerId] = timestamp;
   }
   else
   {
@@ -677,9 +828,18 @@ MEDCouplingFieldDouble * MEDDataManager_i::getFieldDouble(const MEDCALC::FieldHa
   if ( _fieldDoubleMap.count(fieldHandler->id) > 0 ) {
   // The MEDCoupling field data are already loaded. Just return the
   // reference of the MEDCouplingFieldDouble pointer
+    _nbOfHits++;
+    touchField(fieldHandler->id);
+    schedulePrefetch(fieldHandler->id);
     return _fieldDoubleMap[fieldHandler->id];
   }
 
+  // The field may have been evicted from memory after a computation
+  // or a modification, its values are then in the scratch file
+  if ( _spilledFieldMap.count(fieldHandler->id) > 0 ) {
+    return reloadSpilledField(fieldHandler->id);
+  }
+
   // The MEDCoupling field data are not loaded yet. Load the data and
   // register the MEDCoupling field in our internal map an all the
   // associated data if needed (i.e. the underlying mesh).
@@ -711,30 +871,78 @@ MEDCouplingFieldDouble * MEDDataManager_i::getFieldDouble(const MEDCALC::FieldHa
 
   std::string filepath(source_to_file((_datasourceHandlerMap[sourceid])->uri));
   std::string meshName(myMesh->getName());
-  LOG("getFieldDouble: field "<<fieldHandler->fieldname<<" loaded from file "<<filepath);
-  TypeOfField type = (TypeOfField)fieldHandler->type;
-  int meshDimRelToMax = 0;
-  MCAuto<MEDCouplingField> myFieldTmpp(ReadField(type,
+
+  // The step may have been read in the background
+  MCAuto<MEDCouplingFieldDouble> myField(takePrefetchedField(fieldHandler->id,myMesh));
+  if ( !myField.isNull() ) {
+    LOG("getFieldDouble: field "<<fieldHandler->fieldname<<" prefetched from file "<<filepath);
+    _nbOfPrefetchHits++;
+  }
+  else {
+    LOG("getFieldDouble: field "<<fieldHandler->fieldname<<" loaded from file "<<filepath);
+    TypeOfField type = (TypeOfField)fieldHandler->type;
+    int meshDimRelToMax = 0;
+    MCAuto<MEDCouplingField> myFieldTmpp;
+    {
+      FileLock lock(&_fileMutex);
+      myFieldTmpp = ReadField(type,
                 filepath,
                 meshName,
                 meshDimRelToMax,
                 std::string(fieldHandler->fieldname),
                 fieldHandler->iteration,
-                fieldHandler->order));
-  MCAuto<MEDCouplingFieldDouble> myField(DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(myFieldTmpp));
-
-  // trying float field
-  if (!myField){
-    MCAuto<MEDCouplingFieldFloat> myFieldFloat(DynamicCast<MEDCouplingField,MEDCouplingFieldFloat>(myFieldTmpp));
-    if (myFieldFloat){
-      myField = myFieldFloat->convertToDblField();
-      LOG("getFieldDouble: field "<<fieldHandler->fieldname<<" was read as float and converted to double.");
+                fieldHandler->order);
+    }
+    myField = DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(myFieldTmpp);
+
+    // trying float field
+    if (!myField){
+      MCAuto<MEDCouplingFieldFloat> myFieldFloat(DynamicCast<MEDCouplingField,MEDCouplingFieldFloat>(myFieldTmpp));
+      if (myFieldFloat){
+        myField = myFieldFloat->convertToDblField();
+        LOG("getFieldDouble: field "<<fieldHandler->fieldname<<" was read as float and converted to double.");
+      }
     }
+    _nbOfMisses++;
   }
 
   myField->setMesh(myMesh);
   _fieldDoubleMap[fieldHandler->id] = myField.retn();
-  return myField;
+  _fieldsReadFromFile.insert(fieldHandler->id);
+  touchField(fieldHandler->id);
+  enforceMemoryBudget();
+  schedulePrefetch(fieldHandler->id);
+  return _fieldDoubleMap[fieldHandler->id];
+}
+
+/*!
+ * This returns the MEDCoupling field associated to the specified
+ * field handler if it is already in memory, NULL otherwise. Contrary
+ * to getFieldDouble, nothing is loaded.
+ */
+MEDCouplingFieldDouble * MEDDataManager_i::getLoadedFieldDouble(long fieldHandlerId)
+{
+  FieldDoubleMapIterator it = _fieldDoubleMap.find(fieldHandlerId);
+  if ( it == _fieldDoubleMap.end() ) {
+    return NULL;
+  }
+  return it->second;
+}
+
+/*!
+ * This returns the path of the file the data of the specified field
+ * can be read from, i.e. the file of the datasource of its mesh.
+ */
+std::string MEDDataManager_i::getFieldFilePath(const MEDCALC::FieldHandler * fieldHandler)
+{
+  long meshid = fieldHandler->meshid;
+  if ( _meshHandlerMap.count(meshid) == 0 ) {
+    std::string message =
+      std::string("No mesh for id=") + ToString(meshid);
+    throw KERNEL::createSalomeException(message.c_str());
+  }
+  long sourceid = _meshHandlerMap[meshid]->sourceid;
+  return source_to_file((_datasourceHandlerMap[sourceid])->uri);
 }
 
 /*!
@@ -798,6 +1006,8 @@ MEDCALC::FieldHandler * MEDDataManager_i::addField(MEDCouplingFieldDouble * fiel
 
   _fieldHandlerMap[fieldHandler->id] = fieldHandler;
   _fieldDoubleMap[fieldHandler->id] = fieldDouble;
+  touchField(fieldHandler->id);
+  enforceMemoryBudget();
   // >>> WARNING: CORBA structure assignment specification ==> return
   // >>> a deep copy to avoid the destruction of the fieldHandler
   // >>> registered in the map (assignment acts as a destructor for
@@ -822,6 +1032,8 @@ void MEDDataManager_i::updateFieldMetadata(CORBA::Long  fieldHandlerId,
 
   MEDCouplingFieldDouble* fieldDouble = getFieldDouble(fieldHandler);
   fieldDouble->setName(fieldname);
+  // The field in memory differs from the one in the file from now on
+  _fieldsReadFromFile.erase(fieldHandlerId);
 
   // _GBO_ TO BE IMPLEMENTED: iteration and order
 }
@@ -851,6 +1063,7 @@ void MEDDataManager_i::changeUnderlyingMesh(CORBA::Long fieldHandlerId, CORBA::L
   }
 
   // The change of mesh is OK, then we can update the meta-data
+  _fieldsReadFromFile.erase(fieldHandlerId);
   _fieldHandlerMap[fieldHandlerId]->meshid = meshHandlerId;
   _fieldHandlerMap[fieldHandlerId]->meshname = _meshHandlerMap[meshHandlerId]->name;
 
@@ -974,6 +1187,425 @@ void MEDDataManager_i::serverlog() {
   }
 }
 
+/*!
+ * This sets the memory budget (in bytes, 0 meaning no limit) of the
+ * values of the fields kept in memory, and evicts the least recently
+ * used fields if needed.
+ */
+void MEDDataManager_i::setMemoryBudget(CORBA::LongLong nbOfBytes) {
+  if ( nbOfBytes < 0 ) {
+    throw KERNEL::createSalomeException("The memory budget must be positive or null");
+  }
+  _memoryBudget = (std::size_t)nbOfBytes;
+  enforceMemoryBudget();
+  // The prefetched steps may not fit anymore, they are read again on
+  // the next request
+  discardPrefetchedFields();
+}
+
+/*!
+ * This sets the number of steps following a requested step of a
+ * fieldseries that are read in the background (0 to stop).
+ */
+void MEDDataManager_i::setPrefetchDepth(CORBA::Long nbOfSteps) {
+  if ( nbOfSteps < 0 ) {
+    throw KERNEL::createSalomeException("The prefetch depth must be positive or null");
+  }
+  _prefetchDepth = nbOfSteps;
+  if ( _prefetchDepth == 0 ) {
+    discardPrefetchedFields();
+    return;
+  }
+  if ( !_prefetchThreadStarted ) {
+    if ( pthread_create(&_prefetchThread,NULL,th_prefetch,(void*)this) != 0 ) {
+      throw KERNEL::createSalomeException("Impossible to start the prefetch thread");
+    }
+    _prefetchThreadStarted = true;
+  }
+}
+
+MEDCALC::FieldCacheStatistics MEDDataManager_i::getFieldCacheStatistics() {
+  MEDCALC::FieldCacheStatistics stats;
+  stats.budget          = _memoryBudget;
+  stats.memoryInUse     = _memoryInUse;
+  stats.nbOfFields      = _fieldDoubleMap.size();
+  stats.nbOfHits        = _nbOfHits;
+  stats.nbOfMisses      = _nbOfMisses;
+  stats.nbOfEvictions   = _nbOfEvictions;
+  stats.nbOfSpills      = _nbOfSpills;
+  stats.nbOfReloads     = _nbOfReloads;
+  stats.scratchFileSize = _scratchSize;
+  pthread_mutex_lock(&_prefetchMutex);
+  stats.nbOfPrefetched  = _nbOfPrefetched;
+  pthread_mutex_unlock(&_prefetchMutex);
+  stats.nbOfPrefetchHits = _nbOfPrefetchHits;
+  return stats;
+}
+
+/*!
+ * Moves the specified field at the front of the LRU list, and updates
+ * the size of its values.
+ */
+void MEDDataManager_i::touchField(long fieldHandlerId) {
+  std::size_t nbOfBytes = FieldMemorySize(_fieldDoubleMap[fieldHandlerId]);
+  FieldLRUPosMapIterator it = _fieldLRUPos.find(fieldHandlerId);
+  if ( it != _fieldLRUPos.end() ) {
+    _memoryInUse -= it->second.second;
+    _fieldLRU.erase(it->second.first);
+  }
+  _fieldLRU.push_front(fieldHandlerId);
+  _fieldLRUPos[fieldHandlerId] = std::make_pair(_fieldLRU.begin(), nbOfBytes);
+  _memoryInUse += nbOfBytes;
+}
+
+void MEDDataManager_i::forgetField(long fieldHandlerId) {
+  FieldLRUPosMapIterator it = _fieldLRUPos.find(fieldHandlerId);
+  if ( it != _fieldLRUPos.end() ) {
+    _memoryInUse -= it->second.second;
+    _fieldLRU.erase(it->second.first);
+    _fieldLRUPos.erase(it);
+  }
+}
+
+/*!
+ * Evicts the least recently used fields while the memory budget is
+ * exceeded. The NB_OF_PROTECTED_FIELDS most recently used ones, that
+ * the current operation may still be using through the pointers
+ * returned by getFieldDouble, are never evicted.
+ */
+void MEDDataManager_i::enforceMemoryBudget() {
+  if ( _memoryBudget == 0 ) {
+    return;
+  }
+  std::size_t rank = _fieldLRU.size();
+  FieldLRUList::iterator it = _fieldLRU.end();
+  while ( _memoryInUse > _memoryBudget && it != _fieldLRU.begin() ) {
+    --it; rank--;
+    if ( rank < NB_OF_PROTECTED_FIELDS ) {
+      break;
+    }
+    long fieldHandlerId = *it;
+    ++it;
+    bool spilled = false;
+    if ( evictField(fieldHandlerId, spilled) ) {
+      forgetField(fieldHandlerId);
+      _nbOfEvictions++;
+      if ( spilled ) {
+        _nbOfSpills++;
+      }
+    }
+    else {
+      --it;
+    }
+  }
+}
+
+/*!
+ * Releases the values of the specified field. A field read from a
+ * file is released, to be read again by getFieldDouble. The values of
+ * any other field are written in the scratch file, the field itself
+ * being kept so that it is the same instance once reloaded. Fields
+ * marked as persistent and fields referenced elsewhere are kept.
+ */
+bool MEDDataManager_i::evictField(long fieldHandlerId, bool & spilled) {
+  MEDCouplingFieldDouble * field = _fieldDoubleMap[fieldHandlerId];
+  if ( field->getRCValue() > 1 ) {
+    return false;
+  }
+  if ( _fieldsReadFromFile.count(fieldHandlerId) > 0 ) {
+    _fieldsReadFromFile.erase(fieldHandlerId);
+    _fieldDoubleMap.erase(fieldHandlerId);
+    field->decrRef();
+    return true;
+  }
+  FieldPersistencyMapIterator persistIt = _fieldPersistencyMap.find(fieldHandlerId);
+  if ( persistIt != _fieldPersistencyMap.end() && persistIt->second ) {
+    return false;
+  }
+
+  if ( _scratch == NULL ) {
+    // Anonymous temporary file, removed at exit
+    _scratch = std::tmpfile();
+    if ( _scratch == NULL ) {
+      LOG("evictField: impossible to create the scratch file");
+      return false;
+    }
+  }
+  spilledfield_st spill;
+  spill.field = field;
+  std::vector<DataArrayDouble *> arrays = field->getArrays();
+  for (std::size_t i = 0; i < arrays.size(); i++) {
+    long offset = -1;
+    mcIdType nbOfTuples = 0;
+    if ( arrays[i] != NULL ) {
+      nbOfTuples = arrays[i]->getNumberOfTuples();
+      std::size_t nbOfElems = arrays[i]->getNbOfElems();
+      if ( std::fseek(_scratch, 0, SEEK_END) != 0 ) {
+        return false;
+      }
+      offset = std::ftell(_scratch);
+      if ( std::fwrite(arrays[i]->begin(), sizeof(double), nbOfElems, _scratch) != nbOfElems ) {
+        LOG("evictField: write failed in the scratch file");
+        return false;
+      }
+      _scratchSize += nbOfElems*sizeof(double);
+    }
+    spill.offsets.push_back(offset);
+    spill.nbOfTuples.push_back(nbOfTuples);
+  }
+  // The arrays keep their names and components infos
+  for (std::size_t i = 0; i < arrays.size(); i++) {
+    if ( arrays[i] != NULL ) {
+      arrays[i]->alloc(0, arrays[i]->getNumberOfComponents());
+    }
+  }
+  _spilledFieldMap[fieldHandlerId] = spill;
+  _fieldDoubleMap.erase(fieldHandlerId);
+  spilled = true;
+  return true;
+}
+
+MEDCouplingFieldDouble * MEDDataManager_i::reloadSpilledField(long fieldHandlerId) {
+  SpilledFieldMapIterator it = _spilledFieldMap.find(fieldHandlerId);
+  spilledfield_st & spill = it->second;
+  std::vector<DataArrayDouble *> arrays = spill.field->getArrays();
+  for (std::size_t i = 0; i < arrays.size(); i++) {
+    if ( arrays[i] == NULL ) {
+      continue;
+    }
+    arrays[i]->alloc(spill.nbOfTuples[i], arrays[i]->getNumberOfComponents());
+    std::size_t nbOfElems = arrays[i]->getNbOfElems();
+    if ( std::fseek(_scratch, spill.offsets[i], SEEK_SET) != 0 ||
+         std::fread(arrays[i]->getPointer(), sizeof(double), nbOfElems, _scratch) != nbOfElems ) {
+      std::string message =
+        std::string("Error when reading back the field of id=") + ToString(fieldHandlerId) +
+        std::string(" from the scratch file");
+      throw KERNEL::createSalomeException(message.c_str());
+    }
+    arrays[i]->declareAsNew();
+  }
+  MEDCouplingFieldDouble * field = spill.field;
+  _spilledFieldMap.erase(it);
+  _fieldDoubleMap[fieldHandlerId] = field;
+  _nbOfReloads++;
+  touchField(fieldHandlerId);
+  enforceMemoryBudget();
+  return field;
+}
+
+/*!
+ * Queues the steps following the specified one in its fieldseries, in
+ * time order, that are neither in memory nor in the scratch file. The
+ * previous queue is replaced, and the prefetched steps out of the new
+ * window are released since the user has moved elsewhere.
+ */
+void MEDDataManager_i::schedulePrefetch(long fieldHandlerId) {
+  if ( _prefetchDepth == 0 ) {
+    return;
+  }
+  long fieldseriesId = _fieldHandlerMap[fieldHandlerId]->fieldseriesId;
+  ChildrenIdsMapIterator it = _fieldIdsOfFieldseries.find(fieldseriesId);
+  if ( it == _fieldIdsOfFieldseries.end() ) {
+    return;
+  }
+
+  // The steps are in time order if the times of the series are known,
+  // in the order of the file (increasing ids) otherwise. The times are
+  // not computed here since it could load fields.
+  std::vector<long> nextIds;
+  SortedTimestampsMapIterator tsIt = _sortedTimestampsOfFieldseries.find(fieldseriesId);
+  FieldTimestampMapIterator timeIt = _fieldTimestampMap.find(fieldHandlerId);
+  if ( tsIt != _sortedTimestampsOfFieldseries.end() && timeIt != _fieldTimestampMap.end() ) {
+    const TimestampIdList& timestamps = tsIt->second;
+    TimestampIdList::const_iterator pos = std::upper_bound(timestamps.begin(), timestamps.end(),
+        std::pair<double,long>(timeIt->second, fieldHandlerId));
+    for ( ; pos != timestamps.end() && (long)nextIds.size() < _prefetchDepth; pos++ ) {
+      nextIds.push_back(pos->second);
+    }
+  }
+  else {
+    const std::vector<long>& fieldIds = it->second;
+    std::vector<long>::const_iterator pos = std::upper_bound(fieldIds.begin(), fieldIds.end(), fieldHandlerId);
+    for ( ; pos != fieldIds.end() && (long)nextIds.size() < _prefetchDepth; pos++ ) {
+      nextIds.push_back(*pos);
+    }
+  }
+
+  std::vector<prefetchstep_st> queue;
+  for (std::size_t i = 0; i < nextIds.size(); i++) {
+    const MEDCALC::FieldHandler * fieldHandler = _fieldHandlerMap[nextIds[i]];
+    if ( _fieldDoubleMap.count(nextIds[i]) > 0 || _spilledFieldMap.count(nextIds[i]) > 0 ||
+         _meshHandlerMap.count(fieldHandler->meshid) == 0 ) {
+      continue;
+    }
+    prefetchstep_st step;
+    step.id = nextIds[i];
+    step.filePath = getFieldFilePath(fieldHandler);
+    step.fieldName = fieldHandler->fieldname;
+    step.iteration = fieldHandler->iteration;
+    step.order = fieldHandler->order;
+    queue.push_back(step);
+  }
+  std::set<long> window(nextIds.begin(), nextIds.end());
+
+  pthread_mutex_lock(&_prefetchMutex);
+  PrefetchedFieldMapIterator fieldIt = _prefetchedFieldMap.begin();
+  while ( fieldIt != _prefetchedFieldMap.end() ) {
+    if ( window.count(fieldIt->first) == 0 ) {
+      _prefetchedMemory -= FileFieldMemorySize(fieldIt->second);
+      fieldIt->second->decrRef();
+      _prefetchedFieldMap.erase(fieldIt++);
+    }
+    else {
+      fieldIt++;
+    }
+  }
+  if ( _prefetchInProgress != LONG_UNDEFINED && window.count(_prefetchInProgress) == 0 ) {
+    // The step being read is dropped once read
+    _prefetchGeneration++;
+  }
+  _prefetchQueue.clear();
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    if ( _prefetchedFieldMap.count(queue[i].id) == 0 && _prefetchInProgress != queue[i].id ) {
+      _prefetchQueue.push_back(queue[i]);
+    }
+  }
+  // The memory budget is shared with the fields in memory, and the
+  // steps of a fieldseries are assumed to have the same size
+  _prefetchStepSize = FieldMemorySize(_fieldDoubleMap[fieldHandlerId]);
+  if ( _memoryBudget == 0 ) {
+    _prefetchAllowance = std::numeric_limits<std::size_t>::max();
+  }
+  else {
+    _prefetchAllowance = _memoryBudget > _memoryInUse ? _memoryBudget - _memoryInUse : 0;
+  }
+  pthread_cond_broadcast(&_prefetchCond);
+  pthread_mutex_unlock(&_prefetchMutex);
+}
+
+/*!
+ * Returns the specified step on the specified mesh if its values have
+ * been prefetched (NULL otherwise), the caller getting the reference.
+ * If the step is being read, this waits for the end of the reading
+ * rather than reading it a second time.
+ */
+MEDCouplingFieldDouble * MEDDataManager_i::takePrefetchedField(long fieldHandlerId, const MEDCouplingUMesh * mesh) {
+  if ( !_prefetchThreadStarted ) {
+    return NULL;
+  }
+  MCAuto<MEDFileAnyTypeField1TS> fileField;
+  pthread_mutex_lock(&_prefetchMutex);
+  for (std::size_t i = 0; i < _prefetchQueue.size(); i++) {
+    if ( _prefetchQueue[i].id == fieldHandlerId ) {
+      _prefetchQueue.erase(_prefetchQueue.begin()+i);
+      break;
+    }
+  }
+  while ( _prefetchInProgress == fieldHandlerId ) {
+    pthread_cond_wait(&_prefetchCond,&_prefetchMutex);
+  }
+  PrefetchedFieldMapIterator it = _prefetchedFieldMap.find(fieldHandlerId);
+  if ( it != _prefetchedFieldMap.end() ) {
+    fileField = it->second;
+    _prefetchedMemory -= FileFieldMemorySize(fileField);
+    _prefetchedFieldMap.erase(it);
+  }
+  pthread_mutex_unlock(&_prefetchMutex);
+  if ( fileField.isNull() ) {
+    return NULL;
+  }
+
+  // The values are put on the mesh already loaded, that is not read
+  // again from the file
+  TypeOfField type = (TypeOfField)_fieldHandlerMap[fieldHandlerId]->type;
+  MCAuto<MEDCouplingFieldDouble> field;
+  try {
+    MEDFileField1TS * fileFieldDouble = dynamic_cast<MEDFileField1TS *>((MEDFileAnyTypeField1TS *)fileField);
+    MEDFileFloatField1TS * fileFieldFloat = dynamic_cast<MEDFileFloatField1TS *>((MEDFileAnyTypeField1TS *)fileField);
+    if ( fileFieldDouble != NULL ) {
+      field = fileFieldDouble->getFieldOnMeshAtLevel(type,mesh);
+    }
+    else if ( fileFieldFloat != NULL ) {
+      MCAuto<MEDCouplingFieldFloat> fieldFloat(fileFieldFloat->getFieldOnMeshAtLevel(type,mesh));
+      field = fieldFloat->convertToDblField();
+    }
+  }
+  catch (std::exception &) {
+    // Read again by the caller, that reports the error
+    field = 0;
+  }
+  return field.retn();
+}
+
+/*!
+ * Releases the prefetched steps and empties the queue. A step being
+ * read is dropped once read.
+ */
+void MEDDataManager_i::discardPrefetchedFields() {
+  pthread_mutex_lock(&_prefetchMutex);
+  _prefetchQueue.clear();
+  _prefetchGeneration++;
+  for (PrefetchedFieldMapIterator it = _prefetchedFieldMap.begin(); it != _prefetchedFieldMap.end(); it++) {
+    it->second->decrRef();
+  }
+  _prefetchedFieldMap.clear();
+  _prefetchedMemory = 0;
+  pthread_mutex_unlock(&_prefetchMutex);
+}
+
+void * MEDDataManager_i::th_prefetch(void * s) {
+  ((MEDDataManager_i *)s)->prefetchLoop();
+  return 0;
+}
+
+/*!
+ * Body of the prefetch thread: reads the values of the queued steps
+ * one by one, as long as they fit in the memory allowance. The mesh
+ * is not read, the values being put on the mesh already loaded when
+ * the step is requested. A step that can not be read is skipped,
+ * getFieldDouble reporting the error when it is requested.
+ */
+void MEDDataManager_i::prefetchLoop() {
+  pthread_mutex_lock(&_prefetchMutex);
+  while ( true ) {
+    while ( !_prefetchStop && _prefetchQueue.empty() ) {
+      pthread_cond_wait(&_prefetchCond,&_prefetchMutex);
+    }
+    if ( _prefetchStop ) {
+      break;
+    }
+    prefetchstep_st step = _prefetchQueue.front();
+    _prefetchQueue.erase(_prefetchQueue.begin());
+    if ( _prefetchedMemory > _prefetchAllowance ||
+         _prefetchStepSize > _prefetchAllowance - _prefetchedMemory ) {
+      _prefetchQueue.clear();
+      continue;
+    }
+    long generation = _prefetchGeneration;
+    _prefetchInProgress = step.id;
+    pthread_mutex_unlock(&_prefetchMutex);
+
+    MCAuto<MEDFileAnyTypeField1TS> field;
+    try {
+      FileLock lock(&_fileMutex);
+      field = MEDFileAnyTypeField1TS::New(step.filePath, step.fieldName, step.iteration, step.order);
+    }
+    catch (std::exception &) {
+      field = 0;
+    }
+
+    pthread_mutex_lock(&_prefetchMutex);
+    _prefetchInProgress = LONG_UNDEFINED;
+    if ( !field.isNull() && generation == _prefetchGeneration ) {
+      _prefetchedMemory += FileFieldMemorySize(field);
+      _prefetchedFieldMap[step.id] = field.retn();
+      _nbOfPrefetched++;
+    }
+    pthread_cond_broadcast(&_prefetchCond);
+  }
+  pthread_mutex_unlock(&_prefetchMutex);
+}
+
 /*!
  * The event listener is created inside the GUI by the
  * WorkspaceController. This function is called by the WorkspaceController to
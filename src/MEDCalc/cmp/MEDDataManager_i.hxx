@@ -56,6 +56,56 @@ typedef std::map<long,MEDCouplingFieldDouble*>::iterator FieldDoubleMapIterator;
 typedef std::map<long,MEDCouplingUMesh*> MeshMap;
 typedef std::map<long,MEDCouplingUMesh*>::iterator MeshMapIterator;
 
+/*! Secondary indexes, so that browsing the data does not scan the whole maps above */
+#include <vector>
+typedef std::map<long,std::vector<long> > ChildrenIdsMap;
+typedef std::map<long,std::vector<long> >::iterator ChildrenIdsMapIterator;
+typedef std::map<std::string,long> DatasourceIdMap;
+typedef std::map<std::string,long>::iterator DatasourceIdMapIterator;
+typedef std::map<const MEDCouplingMesh*,long> MeshIdMap;
+typedef std::map<const MEDCouplingMesh*,long>::iterator MeshIdMapIterator;
+
+/*! Times of the fields read from files, and per fieldseries the (time, field id) sorted pairs */
+typedef std::map<long,double> FieldTimestampMap;
+typedef std::map<long,double>::iterator FieldTimestampMapIterator;
+typedef std::vector< std::pair<double,long> > TimestampIdList;
+typedef std::map<long,TimestampIdList> SortedTimestampsMap;
+typedef std::map<long,TimestampIdList>::iterator SortedTimestampsMapIterator;
+
+/*! Memory budget of the loaded fields: least recently used first at the back of the list */
+#include <list>
+#include <set>
+#include <cstdio>
+typedef std::list<long> FieldLRUList;
+typedef std::map<long, std::pair<FieldLRUList::iterator,std::size_t> > FieldLRUPosMap;
+typedef std::map<long, std::pair<FieldLRUList::iterator,std::size_t> >::iterator FieldLRUPosMapIterator;
+/*! Field whose arrays have been released after being written in the scratch file, at the given offsets */
+typedef struct
+{
+  MEDCouplingFieldDouble * field;
+  std::vector<long> offsets;
+  std::vector<mcIdType> nbOfTuples;
+} spilledfield_st;
+typedef std::map<long,spilledfield_st> SpilledFieldMap;
+typedef std::map<long,spilledfield_st>::iterator SpilledFieldMapIterator;
+
+/*! Background reads of the values of the steps following a requested one in its fieldseries */
+#include <pthread.h>
+namespace MEDCoupling
+{
+  class MEDFileAnyTypeField1TS;
+}
+typedef struct
+{
+  long id;
+  std::string filePath;
+  std::string fieldName;
+  int iteration;
+  int order;
+} prefetchstep_st;
+typedef std::map<long,MEDFileAnyTypeField1TS*> PrefetchedFieldMap;
+typedef std::map<long,MEDFileAnyTypeField1TS*>::iterator PrefetchedFieldMapIterator;
+
 #include "MEDCALC.hxx"
 class MEDDataManager_i: public POA_MEDCALC::MEDDataManager,
                                        public SALOME::GenericObj_i
@@ -84,6 +134,7 @@ public:
   MEDCALC_EXPORT MEDCALC::FieldHandlerList * getFieldListInFieldseries(CORBA::Long fieldseriesId);
 
   MEDCALC_EXPORT CORBA::Long getFieldIdAtTimestamp(CORBA::Long fieldseriesId, double timestamp);
+  MEDCALC_EXPORT double getFieldTimestamp(CORBA::Long fieldHandlerId);
 
   MEDCALC_EXPORT MEDCALC::FieldHandler *     getFieldHandler(CORBA::Long fieldHandlerId);
   MEDCALC_EXPORT char *                    getFieldRepresentation(CORBA::Long fieldHandlerId);
@@ -109,6 +160,10 @@ public:
 
   MEDCALC_EXPORT void serverlog();
 
+  MEDCALC_EXPORT void setMemoryBudget(CORBA::LongLong nbOfBytes);
+  MEDCALC_EXPORT MEDCALC::FieldCacheStatistics getFieldCacheStatistics();
+  MEDCALC_EXPORT void setPrefetchDepth(CORBA::Long nbOfSteps);
+
   MEDCALC_EXPORT void cleanUp();
 
   //
@@ -121,6 +176,10 @@ public:
   MEDCALC_EXPORT MEDCouplingFieldDouble *  getFieldDouble(const MEDCALC::FieldHandler * fieldHandler);
   MEDCALC_EXPORT MEDCALC::FieldHandler *     addField(MEDCouplingFieldDouble * fieldDouble,
 		                                       long meshHandlerId=LONG_UNDEFINED);
+  MEDCALC_EXPORT MEDCouplingFieldDouble *  getLoadedFieldDouble(long fieldHandlerId);
+  MEDCALC_EXPORT std::string               getFieldFilePath(const MEDCALC::FieldHandler * fieldHandler);
+  MEDCALC_EXPORT MEDCouplingUMesh *        getUMesh(long meshHandlerId);
+  MEDCALC_EXPORT pthread_mutex_t *         getFileMutex() { return &_fileMutex; }
 
 private:
   MEDDataManager_i();
@@ -142,6 +201,61 @@ private:
   MeshMap _meshMap;
   FieldPersistencyMap _fieldPersistencyMap;
 
+  // Memory budget of the fields in _fieldDoubleMap (0 means no
+  // limit). The fields read from a file and not modified since
+  // (_fieldsReadFromFile) are released when evicted, the other ones
+  // (not persistent) are spilled in a scratch file.
+  std::size_t _memoryBudget;
+  std::size_t _memoryInUse;
+  FieldLRUList _fieldLRU;
+  FieldLRUPosMap _fieldLRUPos;
+  std::set<long> _fieldsReadFromFile;
+  SpilledFieldMap _spilledFieldMap;
+  std::FILE * _scratch;
+  std::size_t _scratchSize;
+  long _nbOfHits;
+  long _nbOfMisses;
+  long _nbOfEvictions;
+  long _nbOfSpills;
+  long _nbOfReloads;
+  // The most recently used fields, typically the operands of the
+  // current operation, are never evicted
+  static const std::size_t NB_OF_PROTECTED_FIELDS = 2;
+  // The prefetch thread reads the values of the queued steps in
+  // _prefetchedFieldMap, as long as their memory fits in
+  // _prefetchAllowance. The meshes are loaded and put under the values
+  // by the CORBA thread only, when a step is requested. Everything
+  // below is protected by _prefetchMutex, except _prefetchDepth and
+  // the thread itself that are only used by the CORBA thread. The MED
+  // files are accessed by one thread at a time, under _fileMutex.
+  pthread_mutex_t _fileMutex;
+  pthread_mutex_t _prefetchMutex;
+  pthread_cond_t _prefetchCond;
+  pthread_t _prefetchThread;
+  bool _prefetchThreadStarted;
+  bool _prefetchStop;
+  long _prefetchDepth;
+  std::vector<prefetchstep_st> _prefetchQueue;
+  long _prefetchInProgress;
+  long _prefetchGeneration;
+  PrefetchedFieldMap _prefetchedFieldMap;
+  std::size_t _prefetchedMemory;
+  std::size_t _prefetchAllowance;
+  std::size_t _prefetchStepSize;
+  long _nbOfPrefetched;
+  long _nbOfPrefetchHits;
+  // ids of the meshes of each datasource, of the fieldseries on each
+  // mesh and of the fields in each fieldseries, in increasing order
+  ChildrenIdsMap _meshIdsOfDatasource;
+  ChildrenIdsMap _fieldseriesIdsOfMesh;
+  ChildrenIdsMap _fieldIdsOfFieldseries;
+  // reverse maps from the datasource uri and from the loaded meshes
+  DatasourceIdMap _datasourceIdOfUri;
+  MeshIdMap _meshIdOfUMesh;
+  // times of the steps, read once when the datasource is loaded
+  FieldTimestampMap _fieldTimestampMap;
+  SortedTimestampsMap _sortedTimestampsOfFieldseries;
+
   std::string _medEventListenerIOR;
 
   MEDCALC::FieldHandler * newFieldHandler(const char * fieldname,
@@ -162,10 +276,18 @@ private:
   bool isSourceInFile(const char * sourceName);
   long getDatasourceId(const char *filepath);
 
-  MEDCouplingUMesh * getUMesh(long meshHandlerId);
   long getUMeshId(const MEDCouplingMesh * mesh);
 
-  double getFieldTimestamp(CORBA::Long fieldHandlerId);
+  void touchField(long fieldHandlerId);
+  void forgetField(long fieldHandlerId);
+  void enforceMemoryBudget();
+  bool evictField(long fieldHandlerId, bool & spilled);
+  MEDCouplingFieldDouble * reloadSpilledField(long fieldHandlerId);
+  void schedulePrefetch(long fieldHandlerId);
+  MEDCouplingFieldDouble * takePrefetchedField(long fieldHandlerId, const MEDCouplingUMesh * mesh);
+  void discardPrefetchedFields();
+  static void * th_prefetch(void * s);
+  void prefetchLoop();
 
   INTERP_KERNEL::IntersectionType _getIntersectionType(const char* intersType);
   MEDCoupling::NatureOfField _getNatureOfField(const char* fieldNature);
@@ -276,6 +276,88 @@ def TEST_MEDDataManager_getFieldIdAtTimestamp():
       return False
     if (timestamp9!=requestedTimestamp9):
       return False
+
+    # A timestamp that is not in the fieldseries gives its first field
+    fieldList = dataManager.getFieldListInFieldseries(fieldseriesId)
+    if dataManager.getFieldIdAtTimestamp(fieldseriesId, -1.5) != fieldList[0].id:
+      return False
+    return True
+
+# Size of the datasource of the scaling test: 1000 fieldseries of 100
+# steps, i.e. 100000 field handlers
+scalingNbOfFields = 1000
+scalingNbOfSteps  = 100
+
+def generateScalingFile(filepath):
+    """
+    Writes a file with scalingNbOfFields fields of scalingNbOfSteps
+    steps on a single cell mesh.
+    """
+    import medcoupling as mc
+    coords = mc.DataArrayDouble([0.,0., 1.,0., 0.,1.],3,2)
+    mesh = mc.MEDCouplingUMesh("ScalingMesh",2)
+    mesh.setCoords(coords)
+    mesh.allocateCells(1)
+    mesh.insertNextCell(mc.NORM_TRI3,[0,1,2])
+    mesh.finishInsertingCells()
+    mfmesh = mc.MEDFileUMesh()
+    mfmesh.setMeshAtLevel(0,mesh)
+    mfmesh.write(filepath,2)
+    fields = mc.MEDFileFields()
+    for iField in range(scalingNbOfFields):
+        fieldMTS = mc.MEDFileFieldMultiTS()
+        for iStep in range(scalingNbOfSteps):
+            f = mc.MEDCouplingFieldDouble(mc.ON_CELLS,mc.ONE_TIME)
+            f.setName("field%d"%iField)
+            f.setMesh(mesh)
+            f.setArray(mc.DataArrayDouble([float(iStep)]))
+            f.setTime(float(iStep),iStep,-1)
+            fieldMTS.appendFieldNoProfileSBT(f)
+        fields.pushField(fieldMTS)
+    fields.write(filepath,0)
+
+def TEST_MEDDataManager_indexScaling():
+    """
+    Expands all the nodes of a datasource of 100000 field handlers and
+    checks the handlers got from each node. The time of the expansion is
+    printed beside the time of getting the whole list of handlers at once,
+    for a manual comparison only.
+    """
+    import tempfile, time
+    dataManager = factory.getDataManager()
+    testFilePath = os.path.join(tempfile.mkdtemp(),"scaling.med")
+    generateScalingFile(testFilePath)
+    datasourceHandler = dataManager.loadDatasource(testFilePath)
+    if dataManager.getDatasourceHandler(testFilePath).id != datasourceHandler.id:
+        return False
+
+    t0 = time.time()
+    allFields = dataManager.getFieldHandlerList()
+    tAll = time.time()-t0
+
+    t0 = time.time()
+    meshHandlerList = dataManager.getMeshHandlerList(datasourceHandler.id)
+    if len(meshHandlerList) != 1:
+        return False
+    fieldseriesList = dataManager.getFieldseriesListOnMesh(meshHandlerList[0].id)
+    if len(fieldseriesList) != scalingNbOfFields:
+        return False
+    nbOfFields = 0
+    for fieldseries in fieldseriesList:
+        fieldList = dataManager.getFieldListInFieldseries(fieldseries.id)
+        if len(fieldList) != scalingNbOfSteps:
+            return False
+        ids = [f.id for f in fieldList]
+        if ids != sorted(ids) or [f.fieldseriesId for f in fieldList] != [fieldseries.id]*scalingNbOfSteps:
+            return False
+        nbOfFields += len(fieldList)
+    tExpand = time.time()-t0
+    print("handlers: %d, whole list: %.3f s, expanding all the nodes: %.3f s"%(len(allFields),tAll,tExpand))
+
+    if nbOfFields != scalingNbOfFields*scalingNbOfSteps:
+        return False
+    if len(allFields) < nbOfFields:
+        return False
     return True
 
 #
@@ -330,11 +412,101 @@ def TEST_Calculator_applyFunc():
 
     return True
 
+def TEST_Calculator_reduceOverTime():
+    dataManager = factory.getDataManager()
+    testFilePath  = getFilePath("timeseries.med")
+    datasourceHandler = dataManager.loadDatasource(testFilePath)
+    meshHandlerList = dataManager.getMeshHandlerList(datasourceHandler.id)
+    meshId = meshHandlerList[0].id
+    fieldseriesList = dataManager.getFieldseriesListOnMesh(meshId)
+    fieldseriesId = fieldseriesList[0].id
+
+    calculator = factory.getCalculator()
+    from salome.kernel import MEDCALC
+    for reduction in [MEDCALC.TIME_MEAN, MEDCALC.TIME_MIN, MEDCALC.TIME_MAX,
+                      MEDCALC.TIME_RMS, MEDCALC.TIME_INTEGRAL, MEDCALC.TIME_ARGMAX]:
+        res = calculator.reduceOverTime(fieldseriesId, 0, MEDCALC.LASTSTEP_DEFAULT, reduction)
+        print(res)
+        if res.meshid != meshId:
+            return False
+
+    # The mean over a single step is the step itself
+    fieldList = dataManager.getFieldListInFieldseries(fieldseriesId)
+    res = calculator.reduceOverTime(fieldseriesId, 0, 1, MEDCALC.TIME_MEAN)
+    if dataManager.getFieldTimestamp(res.id) != min([dataManager.getFieldTimestamp(f.id) for f in fieldList]):
+        return False
+    return True
+
 #
 # ==================================================
 # Use cases of the MEDDataManager that need MEDCalculator
 # ==================================================
 #
+def TEST_MEDDataManager_memoryBudget():
+    dataManager = factory.getDataManager()
+    calculator = factory.getCalculator()
+    datasourceHandler = dataManager.loadDatasource(getFilePath("timeseries.med"))
+    meshHandlerList = dataManager.getMeshHandlerList(datasourceHandler.id)
+    fieldseriesList = dataManager.getFieldseriesListOnMesh(meshHandlerList[0].id)
+    fieldList = dataManager.getFieldListInFieldseries(fieldseriesList[0].id)
+
+    # Fields read from the file, and computed ones
+    reprs = [dataManager.getFieldRepresentation(f.id) for f in fieldList]
+    sums = [calculator.add(f, f) for f in fieldList]
+    sumReprs = [dataManager.getFieldRepresentation(f.id) for f in sums]
+
+    # Only the most recently used fields are kept in memory
+    dataManager.setMemoryBudget(1)
+    stats = dataManager.getFieldCacheStatistics()
+    print(stats)
+    if stats.budget != 1 or stats.nbOfEvictions == 0 or stats.nbOfSpills == 0:
+        dataManager.setMemoryBudget(0)
+        return False
+
+    # Evicted fields are read again from their file or from the
+    # scratch file, with the same values
+    ok = True
+    for f, r in zip(fieldList, reprs):
+        ok = ok and dataManager.getFieldRepresentation(f.id) == r
+    for f, r in zip(sums, sumReprs):
+        ok = ok and dataManager.getFieldRepresentation(f.id) == r
+    stats = dataManager.getFieldCacheStatistics()
+    print(stats)
+    ok = ok and stats.nbOfReloads > 0 and stats.scratchFileSize > 0
+    dataManager.setMemoryBudget(0)
+    return ok
+
+def TEST_MEDDataManager_prefetch():
+    import time
+    dataManager = factory.getDataManager()
+    datasourceHandler = dataManager.loadDatasource(getFilePath("timeseries.med"))
+    meshHandlerList = dataManager.getMeshHandlerList(datasourceHandler.id)
+    fieldseriesList = dataManager.getFieldseriesListOnMesh(meshHandlerList[0].id)
+    fieldList = dataManager.getFieldListInFieldseries(fieldseriesList[0].id)
+    reprs = [dataManager.getFieldRepresentation(f.id) for f in fieldList]
+
+    # Release the steps read from the file, but the last two used ones,
+    # then step through the series as the GUI does
+    dataManager.setMemoryBudget(1)
+    dataManager.setMemoryBudget(0)
+    depth = 2
+    dataManager.setPrefetchDepth(depth)
+    before = dataManager.getFieldCacheStatistics()
+    ok = True
+    for i, (f, r) in enumerate(zip(fieldList, reprs)):
+        ok = ok and dataManager.getFieldRepresentation(f.id) == r
+        # Let the prefetch thread read the next steps, as between two
+        # frames: all the steps up to i+depth but the first one and the
+        # last two ones, still in memory
+        expected = before.nbOfPrefetched + max(0, min(i+depth, len(fieldList)-3))
+        timeout = time.time() + 10.
+        while dataManager.getFieldCacheStatistics().nbOfPrefetched < expected and time.time() < timeout:
+            time.sleep(0.01)
+    stats = dataManager.getFieldCacheStatistics()
+    print(stats)
+    dataManager.setPrefetchDepth(0)
+    return ok and stats.nbOfPrefetchHits > before.nbOfPrefetchHits and stats.nbOfPrefetched >= stats.nbOfPrefetchHits
+
 def TEST_markAsPersistent():
     dataManager = factory.getDataManager()
     datasource = dataManager.loadDatasource(testFilePath)
@@ -398,6 +570,9 @@ class MyTestSuite(unittest.TestCase):
     def test_MEDDataManager_getFieldIdAtTimestamp(self):
         self.assertTrue(TEST_MEDDataManager_getFieldIdAtTimestamp())
 
+    def test_MEDDataManager_indexScaling(self):
+        self.assertTrue(TEST_MEDDataManager_indexScaling())
+
     # === MEDCalculator (need MEDDataManager)
     def test_Calculator_basics(self):
         self.assertTrue(TEST_Calculator_basics())
@@ -405,10 +580,19 @@ class MyTestSuite(unittest.TestCase):
     def test_Calculator_applyFunc(self):
         self.assertTrue(TEST_Calculator_applyFunc())
 
+    def test_Calculator_reduceOverTime(self):
+        self.assertTrue(TEST_Calculator_reduceOverTime())
+
     # === MEDDataManager (need MEDCalculator)
     def test_markAsPersistent(self):
         self.assertTrue(TEST_markAsPersistent())
 
+    def test_MEDDataManager_memoryBudget(self):
+        self.assertTrue(TEST_MEDDataManager_memoryBudget())
+
+    def test_MEDDataManager_prefetch(self):
+        self.assertTrue(TEST_MEDDataManager_prefetch())
+
 def myunittests():
     pyunittester.run(MyTestSuite)
 
@@ -20,9 +20,10 @@
 
 #include "MEDCalculatorBrowserStep.hxx"
 #include "MEDCalculatorBrowserField.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
 
-#include "MEDLoader.hxx"
-#include "MEDCouplingFieldDouble.hxx"
+#include "MEDFileField.hxx"
+#include "MCAuto.hxx"
 
 #include <set>
 #include <sstream>
@@ -47,44 +48,54 @@ MEDCalculatorBrowserField::~MEDCalculatorBrowserField()
 //   - fname, the fileName
 //   - fieldname, the fieldname
 //  First set name to fieldname
-//  Then, read the Med structur to fill time steps, components and meshes
+//  Then, read the Med structur (no values) to fill time steps, components and meshes
 MEDCalculatorBrowserField::MEDCalculatorBrowserField(const char *fname, const char *fieldName) : _name(fieldName), _file_name(fname), _selection(false)
 {
-  std::vector< std::string > meshNames=GetMeshNamesOnField(fname,fieldName);
-  std::vector< std::pair< std::pair<int,int>, double > > dtits=GetAllFieldIterations(fname, fieldName);
-  for(std::vector<std::pair< std::pair<int,int>, double > >::const_iterator iter=dtits.begin();iter!=dtits.end();iter++)
-    {
-      _steps.push_back(MEDCalculatorBrowserStep((*iter).first.first,(*iter).first.second,(*iter).second,meshNames[0]));
-    }
-  std::vector<TypeOfField> types=GetTypesOfField(fname,meshNames[0].c_str(),fieldName);
+  MCAuto<MEDFileAnyTypeFieldMultiTS> f;
+  {
+    MEDCalculatorDBIOGuard guard;
+    f=MEDFileAnyTypeFieldMultiTS::New(fname,fieldName,false);
+  }
+  fillFromStructure(f);
+}
+
+//  Constructor with two parameters :
+//   - fname, the fileName
+//   - f, the structure of the field, read without its values (see MEDCalculatorBrowserLiteStruct)
+MEDCalculatorBrowserField::MEDCalculatorBrowserField(const char *fname, const MEDFileAnyTypeFieldMultiTS *f) : _name(f->getName()), _file_name(fname), _selection(false)
+{
+  fillFromStructure(f);
+}
+
+//  Fill time steps, type, components and meshes of this from the structure of the field :
+//  the names and units of components, the time steps and the spatial discretizations are MED metadata,
+//  no value array is read.
+void MEDCalculatorBrowserField::fillFromStructure(const MEDFileAnyTypeFieldMultiTS *f)
+{
+  std::string meshName(f->getMeshName());
+  std::vector<double> times;
+  std::vector< std::pair<int,int> > dtits(f->getTimeSteps(times));
+  for(std::size_t i=0;i<dtits.size();i++)
+    _steps.push_back(MEDCalculatorBrowserStep(dtits[i].first,dtits[i].second,times[i],meshName));
+  // types in the order of GetTypesOfField : first appearance along the time steps
+  std::vector< std::vector<TypeOfField> > typesOfSteps(f->getTypesOfFieldAvailable());
+  std::vector<TypeOfField> types;
+  for(std::vector< std::vector<TypeOfField> >::const_iterator it=typesOfSteps.begin();it!=typesOfSteps.end();it++)
+    for(std::vector<TypeOfField>::const_iterator it2=(*it).begin();it2!=(*it).end();it2++)
+      if(std::find(types.begin(),types.end(),*it2)==types.end())
+        types.push_back(*it2);
   if(types.empty())
     throw INTERP_KERNEL::Exception("MEDCalculatorBrowserField::MEDCalculatorBrowserField : the file is not loadable using MED File 3 API ! Probably presence of field on edges faces...");
   _type=types[0];//To improve
-  MCAuto<MEDCouplingFieldDouble> tmpf;
-  try
-    {
-      MCAuto<MEDCouplingField> tmpf2(ReadField(_type,fname,meshNames[0].c_str(),0,fieldName,dtits[0].first.first,dtits[0].first.second));
-      tmpf=DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(tmpf2);
-    }
-  catch(INTERP_KERNEL::Exception& e)
-    {
-      if(_type==ON_CELLS)
-        {
-          MCAuto<MEDCouplingField> tmpf2(ReadField(_type,fname,meshNames[0].c_str(),-1,fieldName,dtits[0].first.first,dtits[0].first.second));
-          tmpf=DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(tmpf2);
-        }
-      else
-        throw e;
-    }
-  int NumberOfComponents=tmpf->getNumberOfComponents();
-  for(int i=0;i<NumberOfComponents;i++)
+  const std::vector<std::string>& infos(f->getInfo());
+  for(std::vector<std::string>::const_iterator it=infos.begin();it!=infos.end();it++)
     {
-      std::string c=tmpf->getArray()->getInfoOnComponent(i);
+      std::string c(*it);
       if(c=="")
         c="-noname-";
       _components.push_back(c);
     }
-  _corresponding_meshes=GetMeshNamesOnField(fname,fieldName);
+  _corresponding_meshes=f->getMeshesNames();
 }
 
 //  Equal to string operator,
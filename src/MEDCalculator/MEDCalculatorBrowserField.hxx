@@ -36,12 +36,14 @@
 namespace MEDCoupling
 {
   class MEDCalculatorBrowserStep;//  top prevent cross include
+  class MEDFileAnyTypeFieldMultiTS;
   class MEDCALCULATOR_EXPORT MEDCalculatorBrowserField
   {
   public :
     MEDCalculatorBrowserField(const char* nm);
     ~MEDCalculatorBrowserField();
     MEDCalculatorBrowserField(const char *fname, const char *fieldName);
+    MEDCalculatorBrowserField(const char *fname, const MEDFileAnyTypeFieldMultiTS *f);//  Constructor with the structure of the field read without its values
     bool operator==(const std::string&);//  Equal to string operator, to test if fieldname of this field is the same as input argument
     bool operator==(bool);//  Equal to bool operator, to use with std::find on std::vector<CalculatorBrowserField> to find selected fields
     std::string str();//  Return a std::string corresponding to x/o (selected or not) Field fieldname \n steps
@@ -71,6 +73,8 @@ namespace MEDCoupling
     bool isAnySelection() const;
     void setMeshName(const std::string& m);
     MEDCalculatorBrowserField getSelectedTimeSteps() const;
+  private:
+    void fillFromStructure(const MEDFileAnyTypeFieldMultiTS *f);//  Fill time steps, type, components and meshes from MED metadata only
   private:
     std::string _name;// field name
     std::string _file_name;// file name
@@ -19,10 +19,13 @@
 // Author : Anthony Geay (CEA/DEN)
 #include "MEDCalculatorBrowserLiteStruct.hxx"
 #include "MEDCalculatorBrowserStep.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
 
 #include "MEDLoader.hxx"
+#include "MEDFileField.hxx"
 #include "MEDCouplingUMesh.hxx"
 #include "MEDCouplingFieldDouble.hxx"
+#include "MCAuto.hxx"
 
 #include <sstream>
 #include <deque>
@@ -46,16 +49,26 @@ MEDCalculatorBrowserLiteStruct::~MEDCalculatorBrowserLiteStruct()
 //  - n, file name (file.med)
 //  Read the med file to get meshes and fields information
 //  Fill meshes vector with meshes names
-//  Fill fields vector creating using field constructor with MED and fieldname parameters
+//  Fill fields vector from the structure of all the fields, read in one pass without any value
 MEDCalculatorBrowserLiteStruct::MEDCalculatorBrowserLiteStruct(const char *f) : _file(f), _any_selection(false)
 {
   computeBaseName();
-  std::vector<std::string> meshNames=GetMeshNames(_file.c_str());
+  std::vector<std::string> meshNames;
+  MCAuto<MEDFileFields> fields;
+  {
+    MEDCalculatorDBIOGuard guard;
+    meshNames=GetMeshNames(_file.c_str());
+    fields=MEDFileFields::New(_file,false);
+  }
   for(std::vector<std::string>::const_iterator iter=meshNames.begin();iter!=meshNames.end();iter++)
     _meshes.push_back(MEDCalculatorBrowserMesh((*iter).c_str()));
-  std::vector<std::string> fieldNames=GetAllFieldNames(_file.c_str());
-  for(std::vector<std::string>::const_iterator iter=fieldNames.begin();iter!=fieldNames.end();iter++)
-    _fields.push_back(MEDCalculatorBrowserField(_file.c_str(),(*iter).c_str()));
+  int nbOfFields(fields->getNumberOfFields());
+  _fields.reserve(nbOfFields);
+  for(int i=0;i<nbOfFields;i++)
+    {
+      MCAuto<MEDFileAnyTypeFieldMultiTS> field(fields->getFieldAtPos(i));
+      _fields.push_back(MEDCalculatorBrowserField(_file.c_str(),field));
+    }
 }
 
 //  str method
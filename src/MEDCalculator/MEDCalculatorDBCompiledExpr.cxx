@@ -0,0 +1,589 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBCompiledExpr.hxx"
+
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingMemArray.hxx"
+#include "MCAuto.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  //! Number of tuples evaluated by each instruction in one go
+  const std::size_t BLOCK_SIZE=256;
+
+  enum
+  {
+    OP_PUSH_VAR, OP_PUSH_CST,
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_MAX, OP_MIN,
+    OP_ADD_CST, OP_SUB_CST, OP_MUL_CST, OP_DIV_CST, OP_POW_CST,
+    OP_NEG, OP_SQRT, OP_ABS, OP_EXP, OP_LN, OP_LOG10, OP_SIN, OP_COS, OP_TAN,
+    OP_ASIN, OP_ACOS, OP_ATAN, OP_SINH, OP_COSH, OP_TANH
+  };
+
+  int FunctionCode(const std::string& name)
+  {
+    if(name=="sqrt") return OP_SQRT;
+    if(name=="abs") return OP_ABS;
+    if(name=="exp") return OP_EXP;
+    if(name=="ln" || name=="log") return OP_LN;
+    if(name=="log10") return OP_LOG10;
+    if(name=="sin") return OP_SIN;
+    if(name=="cos") return OP_COS;
+    if(name=="tan") return OP_TAN;
+    if(name=="asin") return OP_ASIN;
+    if(name=="acos") return OP_ACOS;
+    if(name=="atan") return OP_ATAN;
+    if(name=="sinh") return OP_SINH;
+    if(name=="cosh") return OP_COSH;
+    if(name=="tanh") return OP_TANH;
+    if(name=="max") return OP_MAX;
+    if(name=="min") return OP_MIN;
+    return -1;
+  }
+
+  bool IsIdentifierChar(char c)
+  {
+    return isalnum((unsigned char)c) || c=='_';
+  }
+}
+
+bool MEDCalculatorDBCompiledExpr::_enabled=true;
+
+pthread_mutex_t MEDCalculatorDBCompiledExpr::_enabled_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+ * Enables (default) or disables the compilation of the expressions created after the call. A disabled
+ * compilation gives all the expressions to the MEDCoupling interpreter.
+ */
+void MEDCalculatorDBCompiledExpr::SetEnabled(bool enabled)
+{
+  pthread_mutex_lock(&_enabled_mutex);
+  _enabled=enabled;
+  pthread_mutex_unlock(&_enabled_mutex);
+}
+
+bool MEDCalculatorDBCompiledExpr::IsEnabled()
+{
+  pthread_mutex_lock(&_enabled_mutex);
+  bool ret=_enabled;
+  pthread_mutex_unlock(&_enabled_mutex);
+  return ret;
+}
+
+MEDCalculatorDBCompiledExpr *MEDCalculatorDBCompiledExpr::New(const std::string& func)
+{
+  return new MEDCalculatorDBCompiledExpr(func);
+}
+
+MEDCalculatorDBCompiledExpr::MEDCalculatorDBCompiledExpr(const std::string& func):_func(func),_depth(0),_max_depth(0),_compiled(false)
+{
+  if(IsEnabled())
+    _compiled=compile();
+  if(!_compiled)
+    {
+      _code.clear();
+      _vars.clear();
+    }
+  _text.clear();
+}
+
+std::size_t MEDCalculatorDBCompiledExpr::getHeapMemorySizeWithoutChildren() const
+{
+  std::size_t ret=sizeof(MEDCalculatorDBCompiledExpr)+_func.capacity()+_code.capacity()*sizeof(instruction_st);
+  for(std::vector<std::string>::const_iterator it=_vars.begin();it!=_vars.end();it++)
+    ret+=sizeof(std::string)+(*it).capacity();
+  return ret;
+}
+
+std::vector<const BigMemoryObject *> MEDCalculatorDBCompiledExpr::getDirectChildrenWithNull() const
+{
+  return std::vector<const BigMemoryObject *>();
+}
+
+/*!
+ * Same as DataArrayDouble::applyFunc(func) : the only variable of the expression is each value of \a arr.
+ */
+DataArrayDouble *MEDCalculatorDBCompiledExpr::apply(const DataArrayDouble *arr) const
+{
+  if(!arr)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBCompiledExpr::apply : null array !");
+  if(!_compiled || _vars.size()>1 || !arr->isAllocated() || arr->getNumberOfComponents()==0)
+    return arr->applyFunc(_func);
+  MCAuto<DataArrayDouble> ret=DataArrayDouble::New();
+  ret->alloc(arr->getNumberOfTuples(),arr->getNumberOfComponents());
+  if(!evaluate(arr->begin(),1,arr->getNbOfElems(),ret->getPointer(),1))
+    return arr->applyFunc(_func);
+  return ret.retn();
+}
+
+/*!
+ * Same as DataArrayDouble::applyFunc(nbOfComp,func) : the variables sorted by name are the components of \a arr
+ * and the value of the expression is set to the \a nbOfComp components of the result.
+ */
+DataArrayDouble *MEDCalculatorDBCompiledExpr::apply(int nbOfComp, const DataArrayDouble *arr) const
+{
+  if(!arr)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBCompiledExpr::apply : null array !");
+  if(!_compiled || nbOfComp<=0 || !arr->isAllocated() || arr->getNumberOfComponents()==0 || _vars.size()>arr->getNumberOfComponents())
+    return arr->applyFunc(nbOfComp,_func);
+  MCAuto<DataArrayDouble> ret=DataArrayDouble::New();
+  ret->alloc(arr->getNumberOfTuples(),nbOfComp);
+  if(!evaluate(arr->begin(),arr->getNumberOfComponents(),arr->getNumberOfTuples(),ret->getPointer(),nbOfComp))
+    return arr->applyFunc(nbOfComp,_func);
+  return ret.retn();
+}
+
+/*!
+ * Same as MEDCouplingFieldDouble::applyFunc(func).
+ */
+void MEDCalculatorDBCompiledExpr::apply(MEDCouplingFieldDouble *f) const
+{
+  if(!_compiled || f->getTimeDiscretization()!=ONE_TIME || !f->getArray())
+    {
+      f->applyFunc(_func);
+      return ;
+    }
+  MCAuto<DataArrayDouble> arr=apply(f->getArray());
+  f->setArray(arr);
+}
+
+/*!
+ * Same as MEDCouplingFieldDouble::applyFunc(nbOfComp,func).
+ */
+void MEDCalculatorDBCompiledExpr::apply(int nbOfComp, MEDCouplingFieldDouble *f) const
+{
+  if(!_compiled || f->getTimeDiscretization()!=ONE_TIME || !f->getArray())
+    {
+      f->applyFunc(nbOfComp,_func);
+      return ;
+    }
+  MCAuto<DataArrayDouble> arr=apply(nbOfComp,f->getArray());
+  f->setArray(arr);
+}
+
+/*!
+ * Grammar compiled (blanks ignored) :
+ *   expr := ['-'] term (('+'|'-') term)*
+ *   term := factor (('*'|'/') factor)*
+ *   factor := primary ['^' primary]
+ *   primary := number | variable | function '(' expr [',' expr] ')' | '(' expr ')'
+ * The constructions whose reading by INTERP_KERNEL::ExprParser could differ (-a^b, a^b^c) are not compiled.
+ */
+bool MEDCalculatorDBCompiledExpr::compile()
+{
+  for(std::string::const_iterator it=_func.begin();it!=_func.end();it++)
+    if(!isspace((unsigned char)*it))
+      _text+=*it;
+  if(_text.empty())
+    return false;
+  std::vector<std::string> vars;
+  std::size_t pos=0;
+  if(!parseExpr(pos,vars) || pos!=_text.size())
+    return false;
+  _vars=vars;
+  std::sort(_vars.begin(),_vars.end());
+  for(std::vector<instruction_st>::iterator it=_code.begin();it!=_code.end();it++)
+    if((*it).code==OP_PUSH_VAR)
+      (*it).var=(int)(std::find(_vars.begin(),_vars.end(),vars[(*it).var])-_vars.begin());
+  return true;
+}
+
+bool MEDCalculatorDBCompiledExpr::parseExpr(std::size_t& pos, std::vector<std::string>& vars)
+{
+  bool neg=false;
+  if(pos<_text.size() && _text[pos]=='-')
+    {
+      neg=true;
+      pos++;
+    }
+  bool hasPow=false;
+  if(!parseTerm(pos,vars,hasPow))
+    return false;
+  if(neg)
+    {
+      if(hasPow)
+        return false;
+      emit(OP_NEG);
+    }
+  while(pos<_text.size() && (_text[pos]=='+' || _text[pos]=='-'))
+    {
+      bool plus=_text[pos++]=='+';
+      if(!parseTerm(pos,vars,hasPow))
+        return false;
+      if(plus)
+        emitBinary(OP_ADD,OP_ADD_CST);
+      else
+        emitBinary(OP_SUB,OP_SUB_CST);
+    }
+  return true;
+}
+
+/*!
+ * \a hasPow is set to true if the first factor of the term is a power.
+ */
+bool MEDCalculatorDBCompiledExpr::parseTerm(std::size_t& pos, std::vector<std::string>& vars, bool& hasPow)
+{
+  if(!parseFactor(pos,vars,hasPow))
+    return false;
+  while(pos<_text.size() && (_text[pos]=='*' || _text[pos]=='/'))
+    {
+      bool mult=_text[pos++]=='*';
+      bool isPow=false;
+      if(!parseFactor(pos,vars,isPow))
+        return false;
+      if(mult)
+        emitBinary(OP_MUL,OP_MUL_CST);
+      else
+        emitBinary(OP_DIV,OP_DIV_CST);
+    }
+  return true;
+}
+
+bool MEDCalculatorDBCompiledExpr::parseFactor(std::size_t& pos, std::vector<std::string>& vars, bool& isPow)
+{
+  isPow=false;
+  if(!parsePrimary(pos,vars))
+    return false;
+  if(pos<_text.size() && _text[pos]=='^')
+    {
+      pos++;
+      if(!parsePrimary(pos,vars))
+        return false;
+      if(pos<_text.size() && _text[pos]=='^')
+        return false;
+      emitBinary(OP_POW,OP_POW_CST);
+      isPow=true;
+    }
+  return true;
+}
+
+bool MEDCalculatorDBCompiledExpr::parsePrimary(std::size_t& pos, std::vector<std::string>& vars)
+{
+  if(pos>=_text.size())
+    return false;
+  char c=_text[pos];
+  if(c=='(')
+    {
+      pos++;
+      if(!parseExpr(pos,vars) || pos>=_text.size() || _text[pos]!=')')
+        return false;
+      pos++;
+      return true;
+    }
+  if(isdigit((unsigned char)c) || c=='.')
+    {
+      std::size_t start=pos;
+      while(pos<_text.size() && isdigit((unsigned char)_text[pos]))
+        pos++;
+      if(pos<_text.size() && _text[pos]=='.')
+        pos++;
+      while(pos<_text.size() && isdigit((unsigned char)_text[pos]))
+        pos++;
+      if(pos<_text.size() && (_text[pos]=='e' || _text[pos]=='E'))
+        {
+          pos++;
+          if(pos<_text.size() && (_text[pos]=='+' || _text[pos]=='-'))
+            pos++;
+          if(pos>=_text.size() || !isdigit((unsigned char)_text[pos]))
+            return false;
+          while(pos<_text.size() && isdigit((unsigned char)_text[pos]))
+            pos++;
+        }
+      std::string number=_text.substr(start,pos-start);
+      if(number==".")
+        return false;
+      emit(OP_PUSH_CST,0,strtod(number.c_str(),0));
+      return true;
+    }
+  if(!isalpha((unsigned char)c) && c!='_')
+    return false;
+  std::size_t start=pos;
+  while(pos<_text.size() && IsIdentifierChar(_text[pos]))
+    pos++;
+  std::string name=_text.substr(start,pos-start);
+  if(pos<_text.size() && _text[pos]=='(')
+    {
+      int code=FunctionCode(name);
+      if(code<0)
+        return false;
+      pos++;
+      if(!parseExpr(pos,vars))
+        return false;
+      if(code==OP_MAX || code==OP_MIN)
+        {
+          if(pos>=_text.size() || _text[pos]!=',')
+            return false;
+          pos++;
+          if(!parseExpr(pos,vars))
+            return false;
+        }
+      if(pos>=_text.size() || _text[pos]!=')')
+        return false;
+      pos++;
+      emit(code);
+      return true;
+    }
+  // unit vectors and constants known by the interpreter are left to it
+  if(name=="IVec" || name=="JVec" || name=="KVec" || name=="pi" || name=="Pi" || name=="PI")
+    return false;
+  std::vector<std::string>::const_iterator it=std::find(vars.begin(),vars.end(),name);
+  if(it==vars.end())
+    {
+      vars.push_back(name);
+      it=vars.end()-1;
+    }
+  emit(OP_PUSH_VAR,(int)(it-vars.begin()));
+  return true;
+}
+
+void MEDCalculatorDBCompiledExpr::emit(int code, int var, double cst)
+{
+  instruction_st ins;
+  ins.code=code;
+  ins.var=var;
+  ins.cst=cst;
+  _code.push_back(ins);
+  switch(code)
+    {
+    case OP_PUSH_VAR:
+    case OP_PUSH_CST:
+      _depth++;
+      _max_depth=std::max(_max_depth,_depth);
+      break;
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_DIV:
+    case OP_POW:
+    case OP_MAX:
+    case OP_MIN:
+      _depth--;
+      break;
+    default:
+      break;
+    }
+}
+
+/*!
+ * Emits the binary operation \a code, or its variant \a cstCode taking the constant right operand in the instruction.
+ */
+void MEDCalculatorDBCompiledExpr::emitBinary(int code, int cstCode)
+{
+  if(!_code.empty() && _code.back().code==OP_PUSH_CST)
+    {
+      double cst=_code.back().cst;
+      _code.pop_back();
+      _depth--;
+      emit(cstCode,0,cst);
+    }
+  else
+    emit(code);
+}
+
+/*!
+ * Evaluates the expression on \a nbOfTuples tuples of \a in (\a inStride values per tuple, variable i being the i-th one)
+ * and sets the value to the \a nbOfCompOut components of the tuples of \a out.
+ * Returns false, \a out being partially filled, if a value is out of the domain checked by the interpreter in safe mode.
+ */
+bool MEDCalculatorDBCompiledExpr::evaluate(const double *in, std::size_t inStride, std::size_t nbOfTuples, double *out, std::size_t nbOfCompOut) const
+{
+  std::vector<double> stack(std::max(_max_depth,(std::size_t)1)*BLOCK_SIZE);
+  for(std::size_t start=0;start<nbOfTuples;start+=BLOCK_SIZE)
+    {
+      std::size_t n=std::min(BLOCK_SIZE,nbOfTuples-start);
+      std::size_t depth=0;
+      bool bad=false;
+      for(std::vector<instruction_st>::const_iterator it=_code.begin();it!=_code.end() && !bad;it++)
+        {
+          double *top=depth>0?&stack[0]+(depth-1)*BLOCK_SIZE:0;
+          double *below=depth>1?top-BLOCK_SIZE:0;
+          const double cst=(*it).cst;
+          std::size_t k;
+          switch((*it).code)
+            {
+            case OP_PUSH_VAR:
+              {
+                const double *src=in+start*inStride+(*it).var;
+                double *dest=&stack[0]+depth*BLOCK_SIZE;
+                for(k=0;k<n;k++)
+                  dest[k]=src[k*inStride];
+                depth++;
+                break;
+              }
+            case OP_PUSH_CST:
+              std::fill(&stack[0]+depth*BLOCK_SIZE,&stack[0]+depth*BLOCK_SIZE+n,cst);
+              depth++;
+              break;
+            case OP_ADD:
+              for(k=0;k<n;k++)
+                below[k]+=top[k];
+              depth--;
+              break;
+            case OP_SUB:
+              for(k=0;k<n;k++)
+                below[k]-=top[k];
+              depth--;
+              break;
+            case OP_MUL:
+              for(k=0;k<n;k++)
+                below[k]*=top[k];
+              depth--;
+              break;
+            case OP_DIV:
+              for(k=0;k<n;k++)
+                bad|=(top[k]==0.);
+              for(k=0;k<n;k++)
+                below[k]/=top[k];
+              depth--;
+              break;
+            case OP_POW:
+              for(k=0;k<n;k++)
+                bad|=(below[k]<0.);
+              for(k=0;k<n;k++)
+                below[k]=pow(below[k],top[k]);
+              depth--;
+              break;
+            case OP_MAX:
+              for(k=0;k<n;k++)
+                below[k]=std::max(below[k],top[k]);
+              depth--;
+              break;
+            case OP_MIN:
+              for(k=0;k<n;k++)
+                below[k]=std::min(below[k],top[k]);
+              depth--;
+              break;
+            case OP_ADD_CST:
+              for(k=0;k<n;k++)
+                top[k]+=cst;
+              break;
+            case OP_SUB_CST:
+              for(k=0;k<n;k++)
+                top[k]-=cst;
+              break;
+            case OP_MUL_CST:
+              for(k=0;k<n;k++)
+                top[k]*=cst;
+              break;
+            case OP_DIV_CST:
+              bad|=(cst==0.);
+              for(k=0;k<n;k++)
+                top[k]/=cst;
+              break;
+            case OP_POW_CST:
+              for(k=0;k<n;k++)
+                bad|=(top[k]<0.);
+              for(k=0;k<n;k++)
+                top[k]=pow(top[k],cst);
+              break;
+            case OP_NEG:
+              for(k=0;k<n;k++)
+                top[k]=-top[k];
+              break;
+            case OP_SQRT:
+              for(k=0;k<n;k++)
+                bad|=(top[k]<0.);
+              for(k=0;k<n;k++)
+                top[k]=sqrt(top[k]);
+              break;
+            case OP_ABS:
+              for(k=0;k<n;k++)
+                top[k]=fabs(top[k]);
+              break;
+            case OP_EXP:
+              for(k=0;k<n;k++)
+                top[k]=exp(top[k]);
+              break;
+            case OP_LN:
+              for(k=0;k<n;k++)
+                bad|=(top[k]<=0.);
+              for(k=0;k<n;k++)
+                top[k]=log(top[k]);
+              break;
+            case OP_LOG10:
+              for(k=0;k<n;k++)
+                bad|=(top[k]<=0.);
+              for(k=0;k<n;k++)
+                top[k]=log10(top[k]);
+              break;
+            case OP_SIN:
+              for(k=0;k<n;k++)
+                top[k]=sin(top[k]);
+              break;
+            case OP_COS:
+              for(k=0;k<n;k++)
+                top[k]=cos(top[k]);
+              break;
+            case OP_TAN:
+              for(k=0;k<n;k++)
+                top[k]=tan(top[k]);
+              break;
+            case OP_ASIN:
+              for(k=0;k<n;k++)
+                bad|=(fabs(top[k])>1.);
+              for(k=0;k<n;k++)
+                top[k]=asin(top[k]);
+              break;
+            case OP_ACOS:
+              for(k=0;k<n;k++)
+                bad|=(fabs(top[k])>1.);
+              for(k=0;k<n;k++)
+                top[k]=acos(top[k]);
+              break;
+            case OP_ATAN:
+              for(k=0;k<n;k++)
+                top[k]=atan(top[k]);
+              break;
+            case OP_SINH:
+              for(k=0;k<n;k++)
+                top[k]=sinh(top[k]);
+              break;
+            case OP_COSH:
+              for(k=0;k<n;k++)
+                top[k]=cosh(top[k]);
+              break;
+            case OP_TANH:
+              for(k=0;k<n;k++)
+                top[k]=tanh(top[k]);
+              break;
+            default:
+              bad=true;
+            }
+        }
+      if(bad)
+        return false;
+      const double *res=&stack[0];
+      double *dest=out+start*nbOfCompOut;
+      if(nbOfCompOut==1)
+        std::copy(res,res+n,dest);
+      else
+        for(std::size_t k=0;k<n;k++)
+          std::fill(dest+k*nbOfCompOut,dest+(k+1)*nbOfCompOut,res[k]);
+    }
+  return true;
+}
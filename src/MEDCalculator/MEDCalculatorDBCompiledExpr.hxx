@@ -0,0 +1,90 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBCOMPILEDEXPR_HXX__
+#define __MEDCALCULATORDBCOMPILEDEXPR_HXX__
+
+#include "MedCalculatorDefines.hxx"
+#include "MEDCouplingRefCountObject.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+namespace MEDCoupling
+{
+  class DataArrayDouble;
+  class MEDCouplingFieldDouble;
+
+  /*!
+   * Expression of applyFunc compiled once into a stack bytecode evaluated on blocks of tuples, each instruction being
+   * a tight loop on the block. Only the arithmetic operators, the unary functions of INTERP_KERNEL::ExprParser, max and min
+   * are compiled. An expression using anything else, or whose evaluation meets a value on which the interpreter
+   * in safe mode could throw (negative square root, division by zero...), is given to the MEDCoupling interpreter
+   * so that the results and the errors are always those of MEDCouplingFieldDouble::applyFunc.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBCompiledExpr : public RefCountObject
+  {
+  public:
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+    static MEDCalculatorDBCompiledExpr *New(const std::string& func);
+    std::size_t getHeapMemorySizeWithoutChildren() const;
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
+    const std::string& getFunc() const { return _func; }
+    bool isCompiled() const { return _compiled; }
+    DataArrayDouble *apply(const DataArrayDouble *arr) const;
+    DataArrayDouble *apply(int nbOfComp, const DataArrayDouble *arr) const;
+    void apply(MEDCouplingFieldDouble *f) const;
+    void apply(int nbOfComp, MEDCouplingFieldDouble *f) const;
+  private:
+    MEDCalculatorDBCompiledExpr(const std::string& func);
+    bool compile();
+    bool parseExpr(std::size_t& pos, std::vector<std::string>& vars);
+    bool parseTerm(std::size_t& pos, std::vector<std::string>& vars, bool& hasPow);
+    bool parseFactor(std::size_t& pos, std::vector<std::string>& vars, bool& isPow);
+    bool parsePrimary(std::size_t& pos, std::vector<std::string>& vars);
+    void emit(int code, int var=0, double cst=0.);
+    void emitBinary(int code, int cstCode);
+    bool evaluate(const double *in, std::size_t inStride, std::size_t nbOfTuples, double *out, std::size_t nbOfCompOut) const;
+  private:
+    typedef struct
+    {
+      int code;
+      int var;
+      double cst;
+    } instruction_st;
+    std::string _func;
+    //! function without blanks, only used while compiling
+    std::string _text;
+    std::vector<instruction_st> _code;
+    //! variables sorted by name as INTERP_KERNEL::ExprParser::getTrueSetOfVars does
+    std::vector<std::string> _vars;
+    std::size_t _depth;
+    std::size_t _max_depth;
+    bool _compiled;
+    static bool _enabled;
+    static pthread_mutex_t _enabled_mutex;
+  };
+}
+
+#endif
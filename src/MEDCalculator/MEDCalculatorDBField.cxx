@@ -20,9 +20,15 @@
 
 #include "MEDCalculatorDBField.hxx"
 #include "MEDCalculatorBrowserField.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+#include "MEDCalculatorDBMeshCorrespondences.hxx"
+#include "MEDCalculatorDBMemoryBudget.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
+#include "MEDCalculatorDBCompiledExpr.hxx"
 
 #include "MEDLoaderBase.hxx"
 #include "MEDLoader.hxx"
+#include "MEDFileField.hxx"
 
 #include "MEDCouplingUMesh.hxx"
 #include "MEDCouplingMemArray.hxx"
@@ -32,10 +38,510 @@
 #include "MEDCouplingFieldOverTimeServant.hxx"
 #include "SALOME_NamingService.hxx"
 
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <limits>
 #include <cmath>
+#include <map>
+#include <set>
 
 using namespace MEDCoupling;
 
+namespace
+{
+  typedef MEDCalculatorDBSliceField *(MEDCalculatorDBSliceField::*SliceArithOp)(const MEDCalculatorDBSliceField *, const DataArrayIdType *, const DataArrayIdType *,
+                                                                                 int, const MEDCalculatorDBRangeSelection&,
+                                                                                 int, const MEDCalculatorDBRangeSelection&) const;
+  typedef MEDCalculatorDBSliceField *(MEDCalculatorDBSliceField::*SliceBinaryOp)(const MEDCalculatorDBSliceField *,
+                                                                                  int, const MEDCalculatorDBRangeSelection&,
+                                                                                  int, const MEDCalculatorDBRangeSelection&) const;
+  typedef MEDCalculatorDBSliceField *(MEDCalculatorDBSliceField::*SliceUnaryOp)(int, const MEDCalculatorDBRangeSelection&) const;
+
+  /*!
+   * Everything a step of an operation needs, handed to the MEDCalculatorDBStepsRunner threads.
+   * Step i works on steps[ids[i]] (and otherSteps[otherIds[i]]) and only writes result[i], so steps are independent.
+   */
+  typedef struct
+  {
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *steps;
+    const std::vector<std::size_t> *ids;
+    int sizeC;
+    const MEDCalculatorDBRangeSelection *c;
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *otherSteps;
+    const std::vector<std::size_t> *otherIds;
+    int otherSizeC;
+    const MEDCalculatorDBRangeSelection *otherC;
+    const DataArrayIdType *cc;
+    const DataArrayIdType *nc;
+    SliceArithOp arithOp;
+    SliceBinaryOp binaryOp;
+    SliceUnaryOp unaryOp;
+    const MEDCalculatorDBCompiledExpr *func;
+    double a;
+    double b;
+    double prec;
+    std::vector< MCAuto<MEDCalculatorDBSliceField> > *result;
+    std::vector<char> *equal;
+  } stepsop_st;
+
+  void ArithOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[(*st->ids)[i]];
+    (*st->result)[i]=(elt->*(st->arithOp))((*st->otherSteps)[(*st->otherIds)[i]],st->cc,st->nc,st->sizeC,*st->c,st->otherSizeC,*st->otherC);
+  }
+
+  void BinaryOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[(*st->ids)[i]];
+    (*st->result)[i]=(elt->*(st->binaryOp))((*st->otherSteps)[(*st->otherIds)[i]],st->sizeC,*st->c,st->otherSizeC,*st->otherC);
+  }
+
+  void UnaryOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[(*st->ids)[i]];
+    (*st->result)[i]=(elt->*(st->unaryOp))(st->sizeC,*st->c);
+  }
+
+  void AssignOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    MEDCalculatorDBSliceField *elt=const_cast<MEDCalculatorDBSliceField *>((const MEDCalculatorDBSliceField *)(*st->steps)[(*st->ids)[i]]);
+    elt->assign((*st->otherSteps)[(*st->otherIds)[i]],st->sizeC,*st->c,st->otherSizeC,*st->otherC);
+  }
+
+  void ApplyFuncOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    MEDCalculatorDBSliceField *elt=const_cast<MEDCalculatorDBSliceField *>((const MEDCalculatorDBSliceField *)(*st->steps)[(*st->ids)[i]]);
+    elt->applyFunc(*st->func,st->sizeC,*st->c);
+  }
+
+  void ApplyLinOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    MEDCalculatorDBSliceField *elt=const_cast<MEDCalculatorDBSliceField *>((const MEDCalculatorDBSliceField *)(*st->steps)[(*st->ids)[i]]);
+    elt->applyLin(st->a,st->b,st->sizeC,*st->c);
+  }
+
+  void IsEqualToCstOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[(*st->ids)[i]];
+    (*st->equal)[i]=elt->isEqualToCst(st->b,st->sizeC,*st->c,st->prec)?1:0;
+  }
+
+  void IsEqualOnStep(std::size_t i, void *s)
+  {
+    stepsop_st *st=(stepsop_st *)s;
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[(*st->ids)[i]];
+    (*st->equal)[i]=elt->isEqual((*st->otherSteps)[(*st->otherIds)[i]],st->cc,st->nc,st->sizeC,*st->c,st->otherSizeC,*st->otherC,st->prec)?1:0;
+  }
+
+  typedef struct
+  {
+    const MEDCalculatorDBFieldExpr *expr;
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *steps;
+    const std::vector<std::size_t> *ids;
+  } deferred_st;
+
+  void EvaluateDeferredOnStep(std::size_t i, void *s)
+  {
+    deferred_st *st=(deferred_st *)s;
+    std::size_t id=(*st->ids)[i];
+    (*st->steps)[id]->setField(st->expr->evaluate(id));
+  }
+
+  /*!
+   * State of a reduction over time. The steps are read (or computed by expr if the field is deferred) by the
+   * MEDCalculatorDBStepsRunner threads, and merged in the order of the steps whatever the order they are read in,
+   * so that the sums do not depend on the number of threads. Step i is weighted by weights[i]. acc holds the running
+   * result, for TIME_ARGMAX the rank of the step reaching best. pending holds the steps read waiting for the previous
+   * ones, nextToMerge is the rank of the next step to merge.
+   */
+  typedef struct
+  {
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *steps;
+    const std::vector<std::size_t> *ids;
+    int sizeC;
+    const MEDCalculatorDBRangeSelection *c;
+    TypeOfField type;
+    const std::string *fileName;
+    const std::string *meshName;
+    const std::string *fieldName;
+    const MEDCalculatorDBFieldExpr *expr;
+    MEDCalculatorDBFieldReal::TimeReduction red;
+    const std::vector<double> *weights;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    std::size_t nextToMerge;
+    bool failed;
+    std::map<std::size_t, MCAuto<MEDCouplingFieldDouble> > pending;
+    MCAuto<MEDCouplingFieldDouble> acc;
+    MCAuto<DataArrayDouble> best;
+  } reduce_st;
+
+  void InitReduction(reduce_st *st, const MEDCouplingFieldDouble *f)
+  {
+    const DataArrayDouble *arr(f->getArray());
+    MCAuto<DataArrayDouble> acc(DataArrayDouble::New());
+    acc->alloc(arr->getNumberOfTuples(),arr->getNumberOfComponents());
+    acc->copyStringInfoFrom(*arr);
+    double init(0.);
+    if(st->red==MEDCalculatorDBFieldReal::TIME_MIN)
+      init=std::numeric_limits<double>::max();
+    if(st->red==MEDCalculatorDBFieldReal::TIME_MAX)
+      init=-std::numeric_limits<double>::max();
+    acc->fillWithValue(init);
+    if(st->red==MEDCalculatorDBFieldReal::TIME_ARGMAX)
+      {
+        st->best=DataArrayDouble::New();
+        st->best->alloc(arr->getNumberOfTuples(),arr->getNumberOfComponents());
+        st->best->fillWithValue(-std::numeric_limits<double>::max());
+      }
+    st->acc=f->clone(false);
+    st->acc->setArray(acc);
+  }
+
+  /*!
+   * Merges step \a i, of values \a f, in the result. Called under the mutex of \a st in the order of the steps.
+   */
+  void MergeReductionStep(reduce_st *st, std::size_t i, const MEDCouplingFieldDouble *f)
+  {
+    const DataArrayDouble *arr(f->getArray());
+    if(st->acc.isNull())
+      InitReduction(st,f);
+    DataArrayDouble *accArr(st->acc->getArray());
+    if(accArr->getNumberOfTuples()!=arr->getNumberOfTuples() || accArr->getNumberOfComponents()!=arr->getNumberOfComponents())
+      throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldReal::reduceOverTime : steps do not have the same number of values !");
+    double *a(accArr->getPointer());
+    const double *p(arr->begin()),*pe(arr->end());
+    double w((*st->weights)[i]);
+    switch(st->red)
+      {
+      case MEDCalculatorDBFieldReal::TIME_MEAN:
+      case MEDCalculatorDBFieldReal::TIME_INTEGRAL:
+        for(;p!=pe;p++,a++)
+          *a+=w*(*p);
+        break;
+      case MEDCalculatorDBFieldReal::TIME_RMS:
+        for(;p!=pe;p++,a++)
+          *a+=w*(*p)*(*p);
+        break;
+      case MEDCalculatorDBFieldReal::TIME_MIN:
+        for(;p!=pe;p++,a++)
+          *a=std::min(*a,*p);
+        break;
+      case MEDCalculatorDBFieldReal::TIME_MAX:
+        for(;p!=pe;p++,a++)
+          *a=std::max(*a,*p);
+        break;
+      case MEDCalculatorDBFieldReal::TIME_ARGMAX:
+        {
+          // steps merged in their order : on equality the first one wins
+          double *b(st->best->getPointer());
+          for(;p!=pe;p++,a++,b++)
+            if(*p>*b)
+              {
+                *b=*p;
+                *a=(double)i;
+              }
+          break;
+        }
+      }
+  }
+
+  /*!
+   * Reads step \a i and merges it with the steps read before it and waiting for it. Then waits for step \a i to be
+   * merged, so that at most one step per thread is in memory in addition to the result.
+   */
+  void ReduceOverTimeOnStep(std::size_t i, void *s)
+  {
+    reduce_st *st=(reduce_st *)s;
+    std::size_t id((*st->ids)[i]);
+    const MEDCalculatorDBSliceField *elt=(*st->steps)[id];
+    try
+      {
+        // only this step is held by this thread : read (or computed) and released after the merge if not fetched
+        MCAuto<MEDCouplingFieldDouble> f;
+        if(st->expr && !elt->isFetched())
+          {
+            f=st->expr->evaluate(id);
+            if(!st->c->isAll())
+              f=f->keepSelectedComponents(st->c->getIds(st->sizeC));
+          }
+        else
+          f=elt->readComponents(st->type,*st->fileName,*st->meshName,*st->fieldName,st->sizeC,*st->c);
+        const DataArrayDouble *arr(f->getArray());
+        if(!arr || !arr->isAllocated())
+          throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldReal::reduceOverTime : a step has no values !");
+        pthread_mutex_lock(&st->mutex);
+        st->pending[i]=f;
+        f=0;
+        try
+          {
+            while(!st->failed && !st->pending.empty() && (*st->pending.begin()).first==st->nextToMerge)
+              {
+                MCAuto<MEDCouplingFieldDouble> next((*st->pending.begin()).second);
+                st->pending.erase(st->pending.begin());
+                MergeReductionStep(st,st->nextToMerge,next);
+                st->nextToMerge++;
+              }
+          }
+        catch(std::exception&)
+          {
+            pthread_mutex_unlock(&st->mutex);
+            throw;
+          }
+        pthread_cond_broadcast(&st->cond);
+        while(!st->failed && st->nextToMerge<=i)
+          pthread_cond_wait(&st->cond,&st->mutex);
+        pthread_mutex_unlock(&st->mutex);
+      }
+    catch(std::exception&)
+      {
+        // the threads waiting for this step to be merged give up
+        pthread_mutex_lock(&st->mutex);
+        st->failed=true;
+        pthread_cond_broadcast(&st->cond);
+        pthread_mutex_unlock(&st->mutex);
+        throw;
+      }
+  }
+
+  //! size in bytes of the chunks of steps written in one go by MEDCalculatorDBFieldReal::write when there is no memory budget
+  const std::size_t WRITE_CHUNK_SIZE=128*1024*1024;
+
+  /*!
+   * Chunks of steps of MEDCalculatorDBFieldReal::write, each one prepared in a background thread while the previous
+   * one is being written. At most one chunk is waiting to be written. The steps of a chunk are handed pinned to the
+   * writer, that holds them until the thread is joined.
+   */
+  typedef struct
+  {
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *steps;
+    const std::vector<std::size_t> *ids;
+    const std::string *name;
+    const std::string *description;
+    std::size_t chunkSize;
+    MCAuto<MEDFileFieldMultiTS> ready;
+    std::vector< MCAuto<MEDCouplingFieldDouble> > readyPins;
+    bool done;
+    bool stop;
+    std::string error;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+  } writechunks_st;
+
+  MEDFileFieldMultiTS *BuildWriteChunk(const writechunks_st *st, std::size_t start, std::vector< MCAuto<MEDCouplingFieldDouble> >& pins)
+  {
+    MCAuto<MEDFileFieldMultiTS> ret(MEDFileFieldMultiTS::New());
+    std::size_t end=std::min(start+st->chunkSize,st->ids->size());
+    for(std::size_t i=start;i<end;i++)
+      {
+        MCAuto<MEDCouplingFieldDouble> f((*st->steps)[(*st->ids)[i]]->pinField());
+        MCAuto<MEDCouplingFieldDouble> f2(f->clone(false));
+        f2->setName(st->name->c_str());
+        f2->setDescription(st->description->c_str());
+        ret->appendFieldNoProfileSBT(f2);
+        pins.push_back(f);
+      }
+    return ret.retn();
+  }
+
+  void *th_writechunks(void *s)
+  {
+    writechunks_st *st=(writechunks_st *)s;
+    for(std::size_t start=0;start<st->ids->size();start+=st->chunkSize)
+      {
+        MCAuto<MEDFileFieldMultiTS> chunk;
+        std::vector< MCAuto<MEDCouplingFieldDouble> > pins;
+        std::string error;
+        try
+          {
+            chunk=BuildWriteChunk(st,start,pins);
+          }
+        catch(std::exception& e)
+          {
+            error=e.what();
+          }
+        pthread_mutex_lock(&st->mutex);
+        while(!st->ready.isNull() && !st->stop)
+          pthread_cond_wait(&st->cond,&st->mutex);
+        bool stop=st->stop || !error.empty();
+        if(!error.empty())
+          st->error=error;
+        else if(!st->stop)
+          {
+            st->ready=chunk;
+            st->readyPins.swap(pins);
+          }
+        pthread_cond_broadcast(&st->cond);
+        pthread_mutex_unlock(&st->mutex);
+        if(stop)
+          break;
+      }
+    pthread_mutex_lock(&st->mutex);
+    st->done=true;
+    pthread_cond_broadcast(&st->cond);
+    pthread_mutex_unlock(&st->mutex);
+    return 0;
+  }
+
+  stepsop_st BuildStepsOp(const std::vector< MCAuto<MEDCalculatorDBSliceField> >& steps, const std::vector<std::size_t>& ids,
+                          int sizeC, const MEDCalculatorDBRangeSelection& c)
+  {
+    stepsop_st st;
+    st.steps=&steps; st.ids=&ids; st.sizeC=sizeC; st.c=&c;
+    st.otherSteps=0; st.otherIds=0; st.otherSizeC=0; st.otherC=0;
+    st.cc=0; st.nc=0;
+    st.arithOp=0; st.binaryOp=0; st.unaryOp=0;
+    st.func=0; st.a=0.; st.b=0.; st.prec=0.;
+    st.result=0; st.equal=0;
+    return st;
+  }
+
+  /*!
+   * MEDCouplingMesh reference counts are not thread safe : the calls of a run can only be concurrent if each mesh of
+   * their steps is only referenced and released by one call. Before a run on several threads, puts the contents of the
+   * steps of each call on a mesh of this call : the first call using a mesh keeps it if nothing out of the run
+   * references it, the other ones get a copy of it. The steps being read in background are taken first, the steps of
+   * a batch of MEDCalculatorDBReadAhead sharing their mesh. The steps not in memory are read with a mesh of their own
+   * by the call needing them. Once the run is over, the steps and the results are put back on the original meshes
+   * and the copies are released. The run is sequential if a step or a content is used by two calls.
+   */
+  class PrivateMeshes
+  {
+  public:
+    PrivateMeshes(const stepsop_st& st):_steps(st.steps),_ids(st.ids),_other_steps(st.otherSteps),_other_ids(st.otherIds),_result(st.result),_concurrent(true) { init(); }
+    PrivateMeshes(const std::vector< MCAuto<MEDCalculatorDBSliceField> > *steps, const std::vector<std::size_t> *ids):_steps(steps),_ids(ids),_other_steps(0),_other_ids(0),_result(0),_concurrent(true) { init(); }
+    ~PrivateMeshes();
+    bool isConcurrent() const { return _concurrent; }
+    const MEDCouplingMesh *getOriginal(const MEDCouplingMesh *m) const;
+  private:
+    const MEDCalculatorDBSliceField *getStep(std::size_t i, int k) const { return k==0?(*_steps)[(*_ids)[i]]:(*_other_steps)[(*_other_ids)[i]]; }
+    void init();
+    void restore(const MEDCalculatorDBSliceField *step) const;
+  private:
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *_steps;
+    const std::vector<std::size_t> *_ids;
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *_other_steps;
+    const std::vector<std::size_t> *_other_ids;
+    const std::vector< MCAuto<MEDCalculatorDBSliceField> > *_result;
+    bool _concurrent;
+    //! copy -> rank of the copy in _copies and of its original in _originals
+    std::map<const MEDCouplingMesh *, std::size_t> _ranks;
+    std::vector< MCAuto<MEDCouplingMesh> > _copies;
+    std::vector< MCAuto<MEDCouplingMesh> > _originals;
+  };
+
+  void PrivateMeshes::init()
+  {
+    std::size_t nbOfCalls(_ids->size());
+    int nbOfSides(_other_steps?2:1);
+    if(MEDCalculatorDBStepsRunner::GetNumberOfThreads()<=1 || nbOfCalls<=1)
+      return ;
+    for(std::size_t i=0;i<nbOfCalls;i++)
+      for(int k=0;k<nbOfSides;k++)
+        getStep(i,k)->takeReadAhead();
+    // the contents are known now : checks that each one is used by a single call and counts the ones on each mesh
+    std::map<const void *, std::size_t> users;
+    std::map<const MEDCouplingMesh *, std::set<const MEDCouplingFieldDouble *> > holders;
+    for(std::size_t i=0;i<nbOfCalls;i++)
+      for(int k=0;k<nbOfSides;k++)
+        {
+          const MEDCalculatorDBSliceField *step(getStep(i,k));
+          const MEDCouplingFieldDouble *f(step->getKnownContent());
+          const void *objs[2]={step,f};
+          for(int j=0;j<2;j++)
+            {
+              if(!objs[j])
+                continue;
+              std::map<const void *, std::size_t>::const_iterator it(users.find(objs[j]));
+              if(it!=users.end() && (*it).second!=i)
+                {
+                  _concurrent=false;
+                  return ;
+                }
+              users[objs[j]]=i;
+            }
+          if(f && f->getMesh())
+            holders[f->getMesh()].insert(f);
+        }
+    // a mesh only referenced by the contents of the run is kept by the first call using it
+    std::map<const MEDCouplingMesh *, std::size_t> keepers;
+    for(std::map<const MEDCouplingMesh *, std::set<const MEDCouplingFieldDouble *> >::const_iterator it=holders.begin();it!=holders.end();it++)
+      if((std::size_t)(*it).first->getRCValue()==(*it).second.size())
+        keepers[(*it).first]=nbOfCalls;
+    std::map< std::pair<const MEDCouplingMesh *,std::size_t>, const MEDCouplingMesh * > copyOfCall;
+    for(std::size_t i=0;i<nbOfCalls;i++)
+      for(int k=0;k<nbOfSides;k++)
+        {
+          const MEDCalculatorDBSliceField *step(getStep(i,k));
+          const MEDCouplingFieldDouble *f(step->getKnownContent());
+          if(!f || !f->getMesh())
+            continue;
+          const MEDCouplingMesh *m(f->getMesh());
+          if(_ranks.find(m)!=_ranks.end())
+            continue;// already on a copy of this call
+          std::map<const MEDCouplingMesh *, std::size_t>::iterator itK(keepers.find(m));
+          if(itK!=keepers.end() && ((*itK).second==nbOfCalls || (*itK).second==i))
+            {
+              (*itK).second=i;
+              continue;
+            }
+          std::pair<const MEDCouplingMesh *,std::size_t> key(m,i);
+          std::map< std::pair<const MEDCouplingMesh *,std::size_t>, const MEDCouplingMesh * >::const_iterator itC(copyOfCall.find(key));
+          if(itC==copyOfCall.end())
+            {
+              MCAuto<MEDCouplingMesh> original(const_cast<MEDCouplingMesh *>(m));
+              original->incrRef();
+              MCAuto<MEDCouplingMesh> cpy(m->deepCopy());
+              _ranks[cpy]=_copies.size();
+              _copies.push_back(cpy);
+              _originals.push_back(original);
+              itC=copyOfCall.insert(std::make_pair(key,(const MEDCouplingMesh *)cpy)).first;
+            }
+          step->putOnMesh((*itC).second);
+        }
+  }
+
+  PrivateMeshes::~PrivateMeshes()
+  {
+    if(_copies.empty())
+      return ;
+    int nbOfSides(_other_steps?2:1);
+    for(std::size_t i=0;i<_ids->size();i++)
+      for(int k=0;k<nbOfSides;k++)
+        restore(getStep(i,k));
+    if(_result)
+      for(std::vector< MCAuto<MEDCalculatorDBSliceField> >::const_iterator it=_result->begin();it!=_result->end();it++)
+        if(!(*it).isNull())
+          restore(*it);
+  }
+
+  /*!
+   * Returns the mesh \a m is a copy of, \a m itself if it is not one.
+   */
+  const MEDCouplingMesh *PrivateMeshes::getOriginal(const MEDCouplingMesh *m) const
+  {
+    std::map<const MEDCouplingMesh *, std::size_t>::const_iterator it(_ranks.find(m));
+    if(it==_ranks.end())
+      return m;
+    return _originals[(*it).second];
+  }
+
+  void PrivateMeshes::restore(const MEDCalculatorDBSliceField *step) const
+  {
+    const MEDCouplingFieldDouble *f(step->getKnownContent());
+    if(f && f->getMesh())
+      step->putOnMesh(getOriginal(f->getMesh()));
+  }
+}
+
 MEDCalculatorDBFieldReal *MEDCalculatorDBField::New(const MEDCalculatorBrowserField& ls)
 {
   return new MEDCalculatorDBFieldReal(ls);
@@ -89,12 +595,107 @@ MEDCalculatorDBFieldReal *MEDCalculatorDBFieldReal::operator()(const MEDCalculat
   return ret;
 }
 
+std::set<const MEDCalculatorDBFieldReal *> MEDCalculatorDBFieldReal::_instances;
+
+pthread_mutex_t MEDCalculatorDBFieldReal::_instances_mutex=PTHREAD_MUTEX_INITIALIZER;
+
 MEDCalculatorDBFieldReal::~MEDCalculatorDBFieldReal()
 {
+  pthread_mutex_lock(&_instances_mutex);
+  _instances.erase(this);
+  pthread_mutex_unlock(&_instances_mutex);
 }
 
 MEDCalculatorDBFieldReal::MEDCalculatorDBFieldReal(TypeOfField type):_type(type)
 {
+  registerInstance();
+}
+
+MEDCalculatorDBFieldReal::MEDCalculatorDBFieldReal(const MEDCalculatorDBFieldReal& other):MEDCalculatorDBField(other),_name(other._name),_description(other._description),
+                                                                                         _file_name(other._file_name),_mesh_name(other._mesh_name),_field_name(other._field_name),
+                                                                                         _type(other._type),_t(other._t),_p(other._p),_c_labels(other._c_labels),_c(other._c),
+                                                                                         _time_steps(other._time_steps),_expr(other._expr)
+{
+  registerInstance();
+}
+
+void MEDCalculatorDBFieldReal::registerInstance() const
+{
+  pthread_mutex_lock(&_instances_mutex);
+  _instances.insert(this);
+  pthread_mutex_unlock(&_instances_mutex);
+}
+
+std::size_t MEDCalculatorDBFieldReal::getHeapMemorySizeWithoutChildren() const
+{
+  std::size_t ret=sizeof(MEDCalculatorDBFieldReal)+_name.capacity()+_description.capacity()+_file_name.capacity()+_mesh_name.capacity()+_field_name.capacity();
+  for(std::vector<std::string>::const_iterator it=_c_labels.begin();it!=_c_labels.end();it++)
+    ret+=sizeof(std::string)+(*it).capacity();
+  ret+=_time_steps.capacity()*sizeof(MCAuto<MEDCalculatorDBSliceField>);
+  return ret;
+}
+
+/*!
+ * The steps, shared with the copies of this (selections, deferred expressions), and the deferred expression if any.
+ */
+std::vector<const BigMemoryObject *> MEDCalculatorDBFieldReal::getDirectChildrenWithNull() const
+{
+  std::vector<const BigMemoryObject *> ret;
+  for(std::vector< MCAuto<MEDCalculatorDBSliceField> >::const_iterator it=_time_steps.begin();it!=_time_steps.end();it++)
+    ret.push_back((const MEDCalculatorDBSliceField *)*it);
+  ret.push_back((const MEDCalculatorDBFieldExpr *)_expr);
+  return ret;
+}
+
+/*!
+ * Returns a report of the memory held by all the MEDCalculatorDBFieldReal alive in the process, the largest first :
+ * name (or name in the file), file, number of steps, number of steps fetched and heap memory size. The total counts
+ * only once the steps shared by several fields (a selection shares the steps of the field it comes from).
+ */
+std::string MEDCalculatorDBFieldReal::GetMemorySummary()
+{
+  pthread_mutex_lock(&_instances_mutex);
+  // the copies of the operands held by the deferred expressions are not listed, they are counted with the fields holding them
+  std::set<const BigMemoryObject *> inner;
+  std::vector<const BigMemoryObject *> stack;
+  for(std::set<const MEDCalculatorDBFieldReal *>::const_iterator it=_instances.begin();it!=_instances.end();it++)
+    if((const MEDCalculatorDBFieldExpr *)(*it)->_expr)
+      stack.push_back((const MEDCalculatorDBFieldExpr *)(*it)->_expr);
+  while(!stack.empty())
+    {
+      const BigMemoryObject *obj(stack.back());
+      stack.pop_back();
+      if(!inner.insert(obj).second || dynamic_cast<const MEDCalculatorDBSliceField *>(obj))
+        continue;
+      std::vector<const BigMemoryObject *> children(obj->getDirectChildrenWithNull());
+      for(std::vector<const BigMemoryObject *>::const_iterator it=children.begin();it!=children.end();it++)
+        if(*it)
+          stack.push_back(*it);
+    }
+  std::vector< std::pair<std::size_t,const MEDCalculatorDBFieldReal *> > sizes;
+  std::vector<const BigMemoryObject *> objs;
+  for(std::set<const MEDCalculatorDBFieldReal *>::const_iterator it=_instances.begin();it!=_instances.end();it++)
+    {
+      if(inner.find(*it)!=inner.end())
+        continue;
+      sizes.push_back(std::pair<std::size_t,const MEDCalculatorDBFieldReal *>((*it)->getHeapMemorySize(),*it));
+      objs.push_back(*it);
+    }
+  std::size_t total=BigMemoryObject::GetHeapMemorySizeOfObjs(objs);
+  std::sort(sizes.begin(),sizes.end(),std::greater< std::pair<std::size_t,const MEDCalculatorDBFieldReal *> >());
+  std::ostringstream oss;
+  oss << "Fields : " << sizes.size() << " holding " << total << " bytes";
+  for(std::vector< std::pair<std::size_t,const MEDCalculatorDBFieldReal *> >::const_iterator it=sizes.begin();it!=sizes.end();it++)
+    {
+      const MEDCalculatorDBFieldReal *f((*it).second);
+      std::string name(!f->_name.empty()?f->_name:(!f->_field_name.empty()?f->_field_name:"(computed)"));
+      oss << "\n  \"" << name << "\"";
+      if(!f->_file_name.empty())
+        oss << " from \"" << f->_file_name << "\"";
+      oss << " : " << f->_time_steps.size() << " steps, " << f->getNumberOfFetchedSteps() << " fetched, " << (*it).first << " bytes";
+    }
+  pthread_mutex_unlock(&_instances_mutex);
+  return oss.str();
 }
 
 void MEDCalculatorDBFieldReal::setName(const char *name)
@@ -120,27 +721,91 @@ void MEDCalculatorDBFieldReal::write(const char *fName, bool writeFromScratch) c
   fetchData();
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   int step=ids[0];
-  const MEDCouplingFieldDouble *field=_time_steps[step]->getField(_type,_file_name,_mesh_name,_field_name);
+  MCAuto<MEDCouplingFieldDouble> field(_time_steps[step]->pinField());
   const MEDCouplingUMesh *mesh=static_cast<const MEDCouplingUMesh *>(field->getMesh());
-  int status=MEDLoaderBase::getStatusOfFile(fName);
-  if(!writeFromScratch && status==MEDLoaderBase::EXIST_RW)
+  {
+    // fetchData may have started a background reading of steps : MED file is not reentrant
+    MEDCalculatorDBIOGuard guard;
+    int status=MEDLoaderBase::getStatusOfFile(fName);
+    if(!writeFromScratch && status==MEDLoaderBase::EXIST_RW)
+      {
+        std::vector<std::string> ms=GetMeshNames(fName);
+        if(std::find(ms.begin(),ms.end(),mesh->getName())!=ms.end())
+          {
+            std::ostringstream oss; oss << "In file \"" << fName << "\" the mesh with name \"" << mesh->getName() << "\" already exists !"; 
+            throw INTERP_KERNEL::Exception(oss.str().c_str());
+          }
+        std::vector<std::string> fs=GetAllFieldNames(fName);
+        if(std::find(fs.begin(),fs.end(),field->getName())!=fs.end())
+          {
+            std::ostringstream oss; oss << "In file \"" << fName << "\" the field with name \"" << field->getName() << "\" already exists !"; 
+            throw INTERP_KERNEL::Exception(oss.str().c_str());
+          }
+      }
+    WriteUMesh(fName,mesh,writeFromScratch);
+  }
+  std::size_t stepSize=std::max(_time_steps[step]->getMemorySize(),(std::size_t)1);
+  std::size_t budget=MEDCalculatorDBMemoryBudget::GetBudget();
+  writechunks_st st;
+  st.steps=&_time_steps; st.ids=&ids; st.name=&_name; st.description=&_description;
+  st.chunkSize=std::max((budget!=0?budget/2:WRITE_CHUNK_SIZE)/stepSize,(std::size_t)1);
+  if(st.chunkSize>=ids.size())
+    {
+      std::vector< MCAuto<MEDCouplingFieldDouble> > pins;
+      MCAuto<MEDFileFieldMultiTS> chunk(BuildWriteChunk(&st,0,pins));
+      MEDCalculatorDBIOGuard guard;
+      chunk->write(fName,0);
+      return ;
+    }
+  st.done=false; st.stop=false;
+  pthread_mutex_init(&st.mutex,NULL);
+  pthread_cond_init(&st.cond,NULL);
+  pthread_t th;
+  if(pthread_create(&th,NULL,th_writechunks,(void*)&st)!=0)
+    {
+      pthread_cond_destroy(&st.cond);
+      pthread_mutex_destroy(&st.mutex);
+      throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldReal::write : impossible to start the writing thread !");
+    }
+  std::string error;
+  // steps handed by the thread, released once it is joined
+  std::vector< std::vector< MCAuto<MEDCouplingFieldDouble> > > written;
+  while(true)
     {
-      std::vector<std::string> ms=GetMeshNames(fName);
-      if(std::find(ms.begin(),ms.end(),mesh->getName())!=ms.end())
+      MCAuto<MEDFileFieldMultiTS> chunk;
+      pthread_mutex_lock(&st.mutex);
+      while(st.ready.isNull() && !st.done && st.error.empty())
+        pthread_cond_wait(&st.cond,&st.mutex);
+      chunk=st.ready;
+      st.ready=0;
+      written.push_back(std::vector< MCAuto<MEDCouplingFieldDouble> >());
+      written.back().swap(st.readyPins);
+      pthread_cond_broadcast(&st.cond);
+      pthread_mutex_unlock(&st.mutex);
+      if(chunk.isNull())
+        break;
+      try
         {
-          std::ostringstream oss; oss << "In file \"" << fName << "\" the mesh with name \"" << mesh->getName() << "\" already exists !"; 
-          throw INTERP_KERNEL::Exception(oss.str().c_str());
+          MEDCalculatorDBIOGuard guard;
+          chunk->write(fName,0);
         }
-      std::vector<std::string> fs=GetAllFieldNames(fName);
-      if(std::find(fs.begin(),fs.end(),field->getName())!=fs.end())
+      catch(std::exception& e)
         {
-          std::ostringstream oss; oss << "In file \"" << fName << "\" the field with name \"" << field->getName() << "\" already exists !"; 
-          throw INTERP_KERNEL::Exception(oss.str().c_str());
+          error=e.what();
+          pthread_mutex_lock(&st.mutex);
+          st.stop=true;
+          pthread_cond_broadcast(&st.cond);
+          pthread_mutex_unlock(&st.mutex);
+          break;
         }
     }
-  WriteUMesh(fName,mesh,writeFromScratch);
-  for(std::vector<std::size_t>::const_iterator iter=ids.begin();iter!=ids.end();iter++)
-    _time_steps[*iter]->write(fName,_name,_description);
+  pthread_join(th,NULL);
+  pthread_cond_destroy(&st.cond);
+  pthread_mutex_destroy(&st.mutex);
+  if(error.empty())
+    error=st.error;
+  if(!error.empty())
+    throw INTERP_KERNEL::Exception(error.c_str());
 }
 
 void MEDCalculatorDBFieldReal::display() const
@@ -203,11 +868,12 @@ std::string MEDCalculatorDBFieldReal::simpleRepr() const
 MEDCalculatorDBFieldReal::MEDCalculatorDBFieldReal(const MEDCalculatorBrowserField& ls):_file_name(ls.getFileName()),_mesh_name(ls.getCorrespondingMeshesFromField().front()),_field_name(ls.getName()),_type(ls.getType()),
                                                                      _c_labels(ls.getComponents())
 {
+  registerInstance();
   const std::vector<MEDCalculatorBrowserStep>& steps=ls.getSteps();
   int sz=steps.size();
   for(int i=0;i<sz;i++)
     {
-      MCAuto<MEDCalculatorDBSliceField> elt(new MEDCalculatorDBSliceField(steps[i].getTimeStep(),steps[i].getOrder()));
+      MCAuto<MEDCalculatorDBSliceField> elt(new MEDCalculatorDBSliceField(steps[i].getTimeStep(),steps[i].getOrder(),steps[i].getTimeValue()));
       _time_steps.push_back(elt);
     }
 }
@@ -222,15 +888,25 @@ const MEDCalculatorDBFieldReal& MEDCalculatorDBFieldReal::operator=(const MEDCal
     throw INTERP_KERNEL::Exception("FieldReal::operator= : Timesteps lengths mismatch !");
   fetchData();
   other.fetchData();
-  for(unsigned int i=0;i<sz;i++)
-    _time_steps[ids[i]]->assign(other._time_steps[ids2[i]],_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,AssignOnStep,&st,meshes.isConcurrent());
   return *this;
 }
 
+/*!
+ * Sets \a val to all the selected components of the selected steps, in place.
+ */
 const MEDCalculatorDBFieldReal& MEDCalculatorDBFieldReal::operator=(double val)
 {
-  MCAuto<MEDCalculatorDBFieldReal> other=buildCstFieldFromThis(val);
-  return (*this)=*other;
+  fetchData();
+  std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.a=0.; st.b=val;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(ids.size(),ApplyLinOnStep,&st,meshes.isConcurrent());
+  return *this;
 }
 
 MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator+(const MEDCalculatorDBField& other) const
@@ -238,16 +914,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator+(const MEDCalculatorDBF
   const MEDCalculatorDBField *other2=&other;
   const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
   if(otherr)
-    return add(*otherr);
+    return buildDeferred(MEDCalculatorDBFieldExprBinary::ADD,*otherr);
   else
     {
       const MEDCalculatorDBFieldCst *otherc=dynamic_cast<const MEDCalculatorDBFieldCst *>(other2);
       if(otherc)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> othercr=buildCstFieldFromThis(otherc->getValue());
-          MEDCalculatorDBField *ret=add(*othercr);
-          return ret;
-        }
+        return buildDeferred(MEDCalculatorDBFieldExprBinary::ADD,otherc->getValue(),false);
       else
         throw INTERP_KERNEL::Exception("FieldReal::operator+ : unrecognized type of parameter received !");
     }
@@ -268,11 +940,16 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::add(const MEDCalculatorDBFieldRe
   int step2=ids2[0];
   const MEDCouplingMesh *mesh=_time_steps[step]->getMesh(_type,_file_name,_mesh_name,_field_name);
   const MEDCouplingMesh *otherm=other._time_steps[step2]->getMesh(_type,other._file_name,other._mesh_name,other._field_name);
-  mesh->checkGeoEquivalWith(otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(mesh,otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
   int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->add(other._time_steps[ids2[i]],cellCor,nodeCor,_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.cc=cellCor; st.nc=nodeCor;
+  st.arithOp=&MEDCalculatorDBSliceField::add;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,ArithOnStep,&st,meshes.isConcurrent());
   int newNbOfCompo=_c.getSize(_c_labels.size());
   ret->_c_labels.resize(newNbOfCompo);
   if(cellCor)
@@ -293,11 +970,7 @@ bool MEDCalculatorDBFieldReal::isEqual(const MEDCalculatorDBField& other, double
     {
       const MEDCalculatorDBFieldCst *otherc=dynamic_cast<const MEDCalculatorDBFieldCst *>(other2);
       if(otherc)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> othercr=buildCstFieldFromThis(otherc->getValue());
-          bool ret=isEqualSameType(*othercr,precM,precF);
-          return ret;
-        }
+        return isEqualToCst(otherc->getValue(),precF);
       else
         throw INTERP_KERNEL::Exception("FieldReal::isEqual : unrecognized type of parameter received !");
     }
@@ -318,16 +991,41 @@ bool MEDCalculatorDBFieldReal::isEqualSameType(const MEDCalculatorDBFieldReal& o
   int step2=ids2[0];
   const MEDCouplingMesh *mesh=_time_steps[step]->getMesh(_type,_file_name,_mesh_name,_field_name);
   const MEDCouplingMesh *otherm=other._time_steps[step2]->getMesh(_type,other._file_name,other._mesh_name,other._field_name);
-  mesh->checkGeoEquivalWith(otherm,0,precM,cellCor,nodeCor);
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(mesh,otherm,0,precM,cellCor,nodeCor);
   int sz=ids.size();
-  for(int i=0;i<sz;i++)
-    if(!_time_steps[ids[i]]->isEqual(other._time_steps[ids2[i]],cellCor,nodeCor,_c_labels.size(),_c,other._c_labels.size(),other._c,precF))
-      return false;
+  std::vector<char> equal(sz,0);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.cc=cellCor; st.nc=nodeCor;
+  st.prec=precF;
+  st.equal=&equal;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,IsEqualOnStep,&st,meshes.isConcurrent());
   if(cellCor)
     cellCor->decrRef();
   if(nodeCor)
     nodeCor->decrRef();
-  return true;
+  return std::find(equal.begin(),equal.end(),0)==equal.end();
+}
+
+/*!
+ * Returns true if all the values of the selected components of the selected steps are equal to \a val with the precision \a precF.
+ * As when compared to a field, the descriptions have to match : a constant has none.
+ */
+bool MEDCalculatorDBFieldReal::isEqualToCst(double val, double precF) const
+{
+  if(!_description.empty())
+    return false;
+  fetchData();
+  std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
+  std::vector<char> equal(ids.size(),0);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.b=val;
+  st.prec=precF;
+  st.equal=&equal;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(ids.size(),IsEqualToCstOnStep,&st,meshes.isConcurrent());
+  return std::find(equal.begin(),equal.end(),0)==equal.end();
 }
 
 MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator-(const MEDCalculatorDBField& other) const
@@ -335,16 +1033,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator-(const MEDCalculatorDBF
   const MEDCalculatorDBField *other2=&other;
   const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
   if(otherr)
-    return substract(*otherr);
+    return buildDeferred(MEDCalculatorDBFieldExprBinary::SUB,*otherr);
   else
     {
       const MEDCalculatorDBFieldCst *otherc=dynamic_cast<const MEDCalculatorDBFieldCst *>(other2);
       if(otherc)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> othercr=buildCstFieldFromThis(otherc->getValue());
-          MEDCalculatorDBField *ret=substract(*othercr);
-          return ret;
-        }
+        return buildDeferred(MEDCalculatorDBFieldExprBinary::SUB,otherc->getValue(),false);
       else
         throw INTERP_KERNEL::Exception("FieldReal::operator- : unrecognized type of parameter received !");
     }
@@ -365,11 +1059,16 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::substract(const MEDCalculatorDBF
   int step2=ids2[0];
   const MEDCouplingMesh *mesh=_time_steps[step]->getMesh(_type,_file_name,_mesh_name,_field_name);
   const MEDCouplingMesh *otherm=other._time_steps[step2]->getMesh(_type,other._file_name,other._mesh_name,other._field_name);
-  mesh->checkGeoEquivalWith(otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(mesh,otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
   int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->substract(other._time_steps[ids2[i]],cellCor,nodeCor,_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.cc=cellCor; st.nc=nodeCor;
+  st.arithOp=&MEDCalculatorDBSliceField::substract;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,ArithOnStep,&st,meshes.isConcurrent());
   int newNbOfCompo=_c.getSize(_c_labels.size());
   ret->_c_labels.resize(newNbOfCompo);
   if(cellCor)
@@ -385,16 +1084,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator*(const MEDCalculatorDBF
   const MEDCalculatorDBField *other2=&other;
   const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
   if(otherr)
-    return multiply(*otherr);
+    return buildDeferred(MEDCalculatorDBFieldExprBinary::MUL,*otherr);
   else
     {
       const MEDCalculatorDBFieldCst *otherc=dynamic_cast<const MEDCalculatorDBFieldCst *>(other2);
       if(otherc)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> othercr=buildCstFieldFromThis(otherc->getValue());
-          MEDCalculatorDBField *ret=multiply(*othercr);
-          return ret;
-        }
+        return buildDeferred(MEDCalculatorDBFieldExprBinary::MUL,otherc->getValue(),false);
       else
         throw INTERP_KERNEL::Exception("FieldReal::operator* : unrecognized type of parameter received !");
     }
@@ -415,11 +1110,16 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::multiply(const MEDCalculatorDBFi
   int step2=ids2[0];
   const MEDCouplingMesh *mesh=_time_steps[step]->getMesh(_type,_file_name,_mesh_name,_field_name);
   const MEDCouplingMesh *otherm=other._time_steps[step2]->getMesh(_type,other._file_name,other._mesh_name,other._field_name);
-  mesh->checkGeoEquivalWith(otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(mesh,otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
   int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->multiply(other._time_steps[ids2[i]],cellCor,nodeCor,_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.cc=cellCor; st.nc=nodeCor;
+  st.arithOp=&MEDCalculatorDBSliceField::multiply;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,ArithOnStep,&st,meshes.isConcurrent());
   int newNbOfCompo=_c.getSize(_c_labels.size());
   ret->_c_labels.resize(newNbOfCompo);
   if(cellCor)
@@ -435,16 +1135,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator/(const MEDCalculatorDBF
   const MEDCalculatorDBField *other2=&other;
   const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
   if(otherr)
-    return divide(*otherr);
+    return buildDeferred(MEDCalculatorDBFieldExprBinary::DIV,*otherr);
   else
     {
       const MEDCalculatorDBFieldCst *otherc=dynamic_cast<const MEDCalculatorDBFieldCst *>(other2);
       if(otherc)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> othercr=buildCstFieldFromThis(otherc->getValue());
-          MEDCalculatorDBField *ret=divide(*othercr);
-          return ret;
-        }
+        return buildDeferred(MEDCalculatorDBFieldExprBinary::DIV,otherc->getValue(),false);
       else
         throw INTERP_KERNEL::Exception("FieldReal::operator/ : unrecognized type of parameter received !");
     }
@@ -465,11 +1161,16 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::divide(const MEDCalculatorDBFiel
   int step2=ids2[0];
   const MEDCouplingMesh *mesh=_time_steps[step]->getMesh(_type,_file_name,_mesh_name,_field_name);
   const MEDCouplingMesh *otherm=other._time_steps[step2]->getMesh(_type,other._file_name,other._mesh_name,other._field_name);
-  mesh->checkGeoEquivalWith(otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(mesh,otherm,1,1e-12,cellCor,nodeCor);//1 for fast check
   int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->divide(other._time_steps[ids2[i]],cellCor,nodeCor,_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.cc=cellCor; st.nc=nodeCor;
+  st.arithOp=&MEDCalculatorDBSliceField::divide;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,ArithOnStep,&st,meshes.isConcurrent());
   int newNbOfCompo=_c.getSize(_c_labels.size());
   ret->_c_labels.resize(newNbOfCompo);
   if(cellCor)
@@ -480,6 +1181,88 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::divide(const MEDCalculatorDBFiel
   return ret;
 }
 
+/*!
+ * Returns a field equal to \a this \a op \a other. Nothing is computed here : the returned field holds a deferred
+ * expression, evaluated step by step in a single pass when its data is required (see fetchData).
+ */
+MEDCalculatorDBField *MEDCalculatorDBFieldReal::buildDeferred(MEDCalculatorDBFieldExprBinary::OpType op, const MEDCalculatorDBFieldReal& other) const
+{
+  checkConsistencyLight(other);
+  MCAuto<MEDCalculatorDBFieldExpr> left=new MEDCalculatorDBFieldExprField(*this);
+  MCAuto<MEDCalculatorDBFieldExpr> right=new MEDCalculatorDBFieldExprField(other);
+  MCAuto<MEDCalculatorDBFieldExpr> expr=new MEDCalculatorDBFieldExprBinary(op,left,right);
+  return buildDeferred(expr);
+}
+
+/*!
+ * Same as above with a constant operand. If \a valFirst the returned field is equal to \a val \a op \a this.
+ */
+MEDCalculatorDBField *MEDCalculatorDBFieldReal::buildDeferred(MEDCalculatorDBFieldExprBinary::OpType op, double val, bool valFirst) const
+{
+  MCAuto<MEDCalculatorDBFieldExpr> f=new MEDCalculatorDBFieldExprField(*this);
+  MCAuto<MEDCalculatorDBFieldExpr> c=new MEDCalculatorDBFieldExprCst(val);
+  MCAuto<MEDCalculatorDBFieldExpr> expr;
+  if(valFirst)
+    expr=new MEDCalculatorDBFieldExprBinary(op,c,f);
+  else
+    expr=new MEDCalculatorDBFieldExprBinary(op,f,c);
+  return buildDeferred(expr);
+}
+
+MEDCalculatorDBField *MEDCalculatorDBFieldReal::buildDeferred(MEDCalculatorDBFieldExpr *expr) const
+{
+  int sz=getNumberOfSteps();
+  if(sz==0)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldReal::buildDeferred : no time steps defined !");
+  MCAuto<MEDCalculatorDBFieldReal> ret=new MEDCalculatorDBFieldReal(_type);
+  expr->incrRef();
+  ret->_expr=expr;
+  std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
+  ret->_time_steps.resize(sz);
+  for(int i=0;i<sz;i++)
+    {
+      int it,order;
+      _time_steps[ids[i]]->getDtIt(it,order);
+      ret->_time_steps[i]=new MEDCalculatorDBSliceField(it,order,_time_steps[ids[i]]->getTime());
+    }
+  ret->_c_labels.resize(getNumberOfComponents());
+  return ret.retn();
+}
+
+/*!
+ * Computes the selected steps not computed yet. Each step is computed in one pass over the whole expression tree.
+ * The first one is computed alone, so that the checks done once per expression (meshes) are done before the others
+ * are dispatched to the MEDCalculatorDBStepsRunner threads.
+ * Once all the steps are there the expression (and so the references it holds on the operands) is released.
+ */
+void MEDCalculatorDBFieldReal::evaluateDeferred() const
+{
+  std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
+  std::vector<std::size_t> idsToCompute;
+  for(std::vector<std::size_t>::const_iterator it=ids.begin();it!=ids.end();it++)
+    if(!_time_steps[*it]->isFetched())
+      idsToCompute.push_back(*it);
+  if(!idsToCompute.empty())
+    {
+      _expr->prepare();
+      _time_steps[idsToCompute[0]]->setField(_expr->evaluate(idsToCompute[0]));
+      std::vector<std::size_t> others(idsToCompute.begin()+1,idsToCompute.end());
+      deferred_st st;
+      st.expr=_expr;
+      st.steps=&_time_steps;
+      st.ids=&others;
+      MEDCalculatorDBStepsRunner::Run(others.size(),EvaluateDeferredOnStep,&st,!_expr->sharesMeshesBetweenSteps());
+      // the steps read from file by the expression come each one with a mesh of its own
+      MCAuto<MEDCouplingFieldDouble> first(_time_steps[idsToCompute[0]]->pinField());
+      for(std::vector<std::size_t>::const_iterator it=others.begin();it!=others.end();it++)
+        _time_steps[*it]->shareMesh(first->getMesh());
+    }
+  for(std::vector< MCAuto<MEDCalculatorDBSliceField> >::const_iterator it=_time_steps.begin();it!=_time_steps.end();it++)
+    if(!(*it)->isFetched())
+      return;
+  _expr=0;
+}
+
 MEDCalculatorDBField *MEDCalculatorDBFieldReal::operator^(const MEDCalculatorDBFieldReal& other) const
 {
   return crossProduct(other);
@@ -497,8 +1280,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::dot(const MEDCalculatorDBFieldRe
   if(sz!=ids2.size())
     throw INTERP_KERNEL::Exception("FieldReal::dot : Timesteps lengths mismatch !");
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->dot(other._time_steps[ids2[i]],_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.binaryOp=&MEDCalculatorDBSliceField::dot;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,BinaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(1);
   ret->incrRef();
@@ -517,8 +1304,12 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::crossProduct(const MEDCalculator
   if(sz!=ids2.size())
     throw INTERP_KERNEL::Exception("FieldReal::crossProduct : Timesteps lengths mismatch !");
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->crossProduct(other._time_steps[ids2[i]],_c_labels.size(),_c,other._c_labels.size(),other._c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.otherSteps=&other._time_steps; st.otherIds=&ids2; st.otherSizeC=other._c_labels.size(); st.otherC=&other._c;
+  st.binaryOp=&MEDCalculatorDBSliceField::crossProduct;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,BinaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(3);
   ret->incrRef();
@@ -532,8 +1323,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::doublyContractedProduct() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->doublyContractedProduct(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::doublyContractedProduct;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(1);
   ret->incrRef();
@@ -547,8 +1341,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::determinant() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->determinant(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::determinant;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(1);
   ret->incrRef();
@@ -562,8 +1359,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::eigenValues() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->eigenValues(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::eigenValues;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   if(sz!=0)
     {
@@ -583,8 +1383,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::eigenVectors() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->eigenVectors(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::eigenVectors;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   if(sz!=0)
     {
@@ -604,8 +1407,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::inverse() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->inverse(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::inverse;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   if(sz!=0)
     {
@@ -625,8 +1431,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::trace() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->trace(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::trace;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(1);
   ret->incrRef();
@@ -640,8 +1449,11 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::deviator() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->deviator(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::deviator;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   if(sz!=0)
     {
@@ -661,24 +1473,99 @@ MEDCalculatorDBField *MEDCalculatorDBFieldReal::magnitude() const
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   unsigned int sz=ids.size();
   ret->_time_steps.resize(sz);
-  for(unsigned int i=0;i<sz;i++)
-    ret->_time_steps[i]=_time_steps[ids[i]]->magnitude(_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  st.unaryOp=&MEDCalculatorDBSliceField::magnitude;
+  st.result=&ret->_time_steps;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(sz,UnaryOnStep,&st,meshes.isConcurrent());
   ret->_time_steps.resize(sz);
   ret->_c_labels.resize(1);
   ret->incrRef();
   return ret;
 }
 
+/*!
+ * Returns a field with one step holding the reduction \a red over the selected steps, taken in their order :
+ * mean, min, max, root mean square, integral over time (trapezoid rule on the time values of the steps) or rank
+ * in the selection of the step reaching the max (the first one on equality).
+ * The steps not fetched are read (or computed if \a this is deferred) one by one and not kept : at most one step per
+ * thread of MEDCalculatorDBStepsRunner is in memory in addition to the result. The steps are merged in their order,
+ * so the result does not depend on the number of threads.
+ */
+MEDCalculatorDBField *MEDCalculatorDBFieldReal::reduceOverTime(TimeReduction red) const
+{
+  std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
+  std::size_t sz=ids.size();
+  if(sz==0)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldReal::reduceOverTime : no time steps defined !");
+  std::vector<double> times(sz),weights(sz,1./(double)sz);
+  for(std::size_t i=0;i<sz;i++)
+    times[i]=_time_steps[ids[i]]->getTime();
+  if(red==TIME_INTEGRAL)
+    for(std::size_t i=0;i<sz;i++)
+      weights[i]=((i+1<sz?times[i+1]:times[i])-(i>0?times[i-1]:times[i]))/2.;
+  reduce_st st;
+  st.steps=&_time_steps; st.ids=&ids; st.sizeC=_c_labels.size(); st.c=&_c;
+  st.type=_type; st.fileName=&_file_name; st.meshName=&_mesh_name; st.fieldName=&_field_name;
+  st.expr=_expr;
+  st.red=red; st.weights=&weights;
+  st.nextToMerge=0; st.failed=false;
+  PrivateMeshes meshes(&_time_steps,&ids);
+  bool concurrent(meshes.isConcurrent());
+  if(isDeferred())
+    {
+      _expr->prepare();
+      concurrent=concurrent && !_expr->sharesMeshesBetweenSteps();
+    }
+  pthread_mutex_init(&st.mutex,NULL);
+  pthread_cond_init(&st.cond,NULL);
+  try
+    {
+      MEDCalculatorDBStepsRunner::Run(sz,ReduceOverTimeOnStep,&st,concurrent);
+    }
+  catch(INTERP_KERNEL::Exception&)
+    {
+      pthread_cond_destroy(&st.cond);
+      pthread_mutex_destroy(&st.mutex);
+      throw;
+    }
+  pthread_cond_destroy(&st.cond);
+  pthread_mutex_destroy(&st.mutex);
+  DataArrayDouble *arr(st.acc->getArray());
+  if(red==TIME_RMS)
+    {
+      double *pt(arr->getPointer());
+      for(std::size_t i=0;i<arr->getNbOfElems();i++)
+        pt[i]=sqrt(pt[i]);
+    }
+  arr->declareAsNew();
+  st.acc->setMesh(meshes.getOriginal(st.acc->getMesh()));
+  int it,order;
+  _time_steps[ids[0]]->getDtIt(it,order);
+  st.acc->setTime(times[0],it,order);
+  MCAuto<MEDCalculatorDBFieldReal> ret=new MEDCalculatorDBFieldReal(_type);
+  std::vector<std::size_t> cIds=_c.getIds(_c_labels.size());
+  for(std::vector<std::size_t>::const_iterator iter=cIds.begin();iter!=cIds.end();iter++)
+    ret->_c_labels.push_back(_c_labels[*iter]);
+  ret->_time_steps.push_back(MCAuto<MEDCalculatorDBSliceField>(new MEDCalculatorDBSliceField(st.acc.retn())));
+  ret->incrRef();
+  return ret;
+}
+
 void MEDCalculatorDBFieldReal::applyFunc(const char *func)
 {
   fetchData();
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
-  for(std::vector<std::size_t>::const_iterator it=ids.begin();it!=ids.end();it++)
-    _time_steps[*it]->applyFunc(func,_c_labels.size(),_c);
+  stepsop_st st=BuildStepsOp(_time_steps,ids,_c_labels.size(),_c);
+  MCAuto<MEDCalculatorDBCompiledExpr> expr=MEDCalculatorDBCompiledExpr::New(func);
+  st.func=expr;
+  PrivateMeshes meshes(st);
+  MEDCalculatorDBStepsRunner::Run(ids.size(),ApplyFuncOnStep,&st,meshes.isConcurrent());
 }
 
 MEDCalculatorDBFieldReal *MEDCalculatorDBFieldReal::buildCstFieldFromThis(double val) const
 {
+  fetchData();
   MCAuto<MEDCalculatorDBFieldReal> ret=new MEDCalculatorDBFieldReal(_type);
   ret->_p=_p;
   ret->_c_labels.resize(_c.getSize(_c_labels.size()));
@@ -706,8 +1593,17 @@ void MEDCalculatorDBFieldReal::checkConsistencyLight(const MEDCalculatorDBFieldR
     throw INTERP_KERNEL::Exception("Components mismatch !");
 }
 
+/*!
+ * Reads the selected steps not fetched yet. They are read in one shot, or, if a MEDCalculatorDBMemoryBudget is set, by
+ * chunks of steps fitting in half the budget.
+ */
 void MEDCalculatorDBFieldReal::fetchData() const
 {
+  if(isDeferred())
+    {
+      evaluateDeferred();
+      return;
+    }
   std::vector<std::pair<int,int> > idstoFetch;
   std::vector<std::size_t> ids=_t.getIds(_time_steps.size());
   int sz=ids.size();
@@ -724,12 +1620,36 @@ void MEDCalculatorDBFieldReal::fetchData() const
           idsInGlobalToFetch.push_back(ids[i]);
         }
     }
-  std::vector<MEDCouplingFieldDouble *> fs=ReadFieldsOnSameMesh(_type,_file_name.c_str(),_mesh_name.c_str(),0,_field_name.c_str(),idstoFetch);
-  sz=fs.size();
-  for(int i=0;i<sz;i++)
+  std::size_t nbToFetch=idstoFetch.size();
+  if(nbToFetch>1 && MEDCalculatorDBReadAhead::GetDepth()>0)
+    {
+      // steps read in background, in the order they will be used, and taken when first needed
+      MCAuto<MEDCalculatorDBReadAhead> ra=MEDCalculatorDBReadAhead::New(_type,_file_name,_mesh_name,_field_name,idstoFetch);
+      for(std::size_t i=0;i<nbToFetch;i++)
+        _time_steps[idsInGlobalToFetch[i]]->setReadAhead(ra,i,_type,_file_name,_mesh_name,_field_name);
+      return ;
+    }
+  std::size_t budget=MEDCalculatorDBMemoryBudget::GetBudget();
+  std::size_t start=0;
+  while(start<nbToFetch)
     {
-      MCAuto<MEDCalculatorDBSliceField> elt=_time_steps[idsInGlobalToFetch[i]];
-      elt->setField(fs[i]);
+      std::size_t chunk=nbToFetch-start;
+      if(budget!=0)
+        {
+          std::size_t stepSize=_time_steps[idsInGlobalToFetch[start]]->getMemorySize();
+          if(stepSize==0 && start!=0)
+            stepSize=_time_steps[idsInGlobalToFetch[start-1]]->getMemorySize();
+          chunk=std::min(chunk,stepSize!=0?std::max(budget/(2*stepSize),(std::size_t)1):(std::size_t)1);
+        }
+      std::vector<std::pair<int,int> > idsOfChunk(idstoFetch.begin()+start,idstoFetch.begin()+start+chunk);
+      std::vector<MEDCouplingFieldDouble *> fs;
+      {
+        MEDCalculatorDBIOGuard guard;
+        fs=ReadFieldsOnSameMesh(_type,_file_name.c_str(),_mesh_name.c_str(),0,_field_name.c_str(),idsOfChunk);
+      }
+      for(std::size_t i=0;i<fs.size();i++)
+        _time_steps[idsInGlobalToFetch[start+i]]->setFieldFromFile(fs[i],_type,_file_name,_mesh_name,_field_name);
+      start+=chunk;
     }
 }
 
@@ -800,11 +1720,7 @@ MEDCalculatorDBField *MEDCalculatorDBFieldCst::operator+(const MEDCalculatorDBFi
     {
       const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
       if(otherr)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> thisr=otherr->buildCstFieldFromThis(_val);
-          MEDCalculatorDBField *ret=(*thisr)+other;
-          return ret;
-        }
+        return otherr->buildDeferred(MEDCalculatorDBFieldExprBinary::ADD,_val,true);
       else
         throw INTERP_KERNEL::Exception("FieldCst::operator+ : unrecognized type of parameter received !");
     }
@@ -825,11 +1741,7 @@ MEDCalculatorDBField *MEDCalculatorDBFieldCst::operator-(const MEDCalculatorDBFi
     {
       const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
       if(otherr)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> thisr=otherr->buildCstFieldFromThis(_val);
-          MEDCalculatorDBField *ret=(*thisr)-other;
-          return ret;
-        }
+        return otherr->buildDeferred(MEDCalculatorDBFieldExprBinary::SUB,_val,true);
       else
         throw INTERP_KERNEL::Exception("FieldCst::operator- : unrecognized type of parameter received !");
     }
@@ -850,11 +1762,7 @@ MEDCalculatorDBField *MEDCalculatorDBFieldCst::operator*(const MEDCalculatorDBFi
     {
       const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
       if(otherr)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> thisr=otherr->buildCstFieldFromThis(_val);
-          MEDCalculatorDBField *ret=(*thisr)*other;
-          return ret;
-        }
+        return otherr->buildDeferred(MEDCalculatorDBFieldExprBinary::MUL,_val,true);
       else
         throw INTERP_KERNEL::Exception("FieldCst::operator* : unrecognized type of parameter received !");
     }
@@ -875,11 +1783,7 @@ MEDCalculatorDBField *MEDCalculatorDBFieldCst::operator/(const MEDCalculatorDBFi
     {
       const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
       if(otherr)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> thisr=otherr->buildCstFieldFromThis(_val);
-          MEDCalculatorDBField *ret=(*thisr)/other;
-          return ret;
-        }
+        return otherr->buildDeferred(MEDCalculatorDBFieldExprBinary::DIV,_val,true);
       else
         throw INTERP_KERNEL::Exception("FieldCst::operator/ : unrecognized type of parameter received !");
     }
@@ -895,11 +1799,7 @@ bool MEDCalculatorDBFieldCst::isEqual(const MEDCalculatorDBField& other, double
     {
       const MEDCalculatorDBFieldReal *otherr=dynamic_cast<const MEDCalculatorDBFieldReal *>(other2);
       if(otherr)
-        {
-          MCAuto<MEDCalculatorDBFieldReal> thisr=otherr->buildCstFieldFromThis(_val);
-          bool ret=thisr->isEqual(other,precM,precF);
-          return ret;
-        }
+        return otherr->isEqualToCst(_val,precF);
       else
         throw INTERP_KERNEL::Exception("FieldCst::isEqual : unrecognized type of parameter received !");
     }
@@ -24,14 +24,17 @@
 #include "MedCalculatorDefines.hxx"
 #include "MEDCalculatorDBSliceField.hxx"
 #include "MEDCalculatorDBRangeSelection.hxx"
+#include "MEDCalculatorDBFieldExpr.hxx"
 
 #include "MEDCouplingRefCountObject.hxx"
 #include "MCAuto.hxx"
 
 #include "InterpKernelException.hxx"
 
+#include <pthread.h>
 #include <string>
 #include <vector>
+#include <set>
 
 namespace MEDCoupling
 {
@@ -60,9 +63,23 @@ namespace MEDCoupling
 
   class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldReal : public MEDCalculatorDBField
   {
+    friend class MEDCalculatorDBFieldExprField;
   public:
+    enum TimeReduction
+      {
+        TIME_MEAN = 0,
+        TIME_MIN = 1,
+        TIME_MAX = 2,
+        TIME_RMS = 3,
+        TIME_INTEGRAL = 4,
+        TIME_ARGMAX = 5
+      };
     MEDCalculatorDBFieldReal(const MEDCalculatorBrowserField& ls);
+    MEDCalculatorDBFieldReal(const MEDCalculatorDBFieldReal& other);
     ~MEDCalculatorDBFieldReal();
+    static std::string GetMemorySummary();
+    std::size_t getHeapMemorySizeWithoutChildren() const;
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
     void setName(const char *name);
     void setDescription(const char *descr);
     void write(const char *fName, bool writeFromScratch) const;
@@ -79,6 +96,9 @@ namespace MEDCoupling
     MEDCalculatorDBField *multiply(const MEDCalculatorDBFieldReal& other) const;
     MEDCalculatorDBField *operator/(const MEDCalculatorDBField& other) const;
     MEDCalculatorDBField *divide(const MEDCalculatorDBFieldReal& other) const;
+    MEDCalculatorDBField *buildDeferred(MEDCalculatorDBFieldExprBinary::OpType op, const MEDCalculatorDBFieldReal& other) const;
+    MEDCalculatorDBField *buildDeferred(MEDCalculatorDBFieldExprBinary::OpType op, double val, bool valFirst) const;
+    bool isDeferred() const { return (const MEDCalculatorDBFieldExpr *)_expr!=0; }
     MEDCalculatorDBField *operator^(const MEDCalculatorDBFieldReal& other) const;
     MEDCalculatorDBField *dot(const MEDCalculatorDBFieldReal& other) const;
     MEDCalculatorDBField *crossProduct(const MEDCalculatorDBFieldReal& other) const;
@@ -90,9 +110,11 @@ namespace MEDCoupling
     MEDCalculatorDBField *trace() const;
     MEDCalculatorDBField *deviator() const;
     MEDCalculatorDBField *magnitude() const;
+    MEDCalculatorDBField *reduceOverTime(TimeReduction red) const;
     void applyFunc(const char *func);
     bool isEqual(const MEDCalculatorDBField& other, double precM, double precF) const;
     bool isEqualSameType(const MEDCalculatorDBFieldReal& other, double precM, double precF) const;
+    bool isEqualToCst(double val, double precF) const;
     MEDCalculatorDBFieldReal *buildCstFieldFromThis(double val) const;
     void checkConsistencyLight(const MEDCalculatorDBFieldReal& other) const;
     void fetchData() const;
@@ -105,6 +127,9 @@ namespace MEDCoupling
     void setInfoOnComponent(int i, const char *info);
   private:
     MEDCalculatorDBFieldReal(TypeOfField type);
+    MEDCalculatorDBField *buildDeferred(MEDCalculatorDBFieldExpr *expr) const;
+    void evaluateDeferred() const;
+    void registerInstance() const;
   private:
     std::string _name;
     std::string _description;
@@ -118,6 +143,10 @@ namespace MEDCoupling
     std::vector<std::string> _c_labels;
     MEDCalculatorDBRangeSelection _c;
     std::vector< MCAuto<MEDCalculatorDBSliceField> > _time_steps;
+    mutable MCAuto<MEDCalculatorDBFieldExpr> _expr;
+    //! all the instances alive, for GetMemorySummary
+    static std::set<const MEDCalculatorDBFieldReal *> _instances;
+    static pthread_mutex_t _instances_mutex;
   };
 
   class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldCst : public MEDCalculatorDBField
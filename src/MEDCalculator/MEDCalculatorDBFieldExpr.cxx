@@ -0,0 +1,255 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBFieldExpr.hxx"
+#include "MEDCalculatorDBField.hxx"
+#include "MEDCalculatorDBMeshCorrespondences.hxx"
+
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingMesh.hxx"
+#include "MEDCouplingMemArray.hxx"
+
+using namespace MEDCoupling;
+
+std::size_t MEDCalculatorDBFieldExpr::getHeapMemorySizeWithoutChildren() const
+{
+  return 0;
+}
+
+std::vector<const BigMemoryObject *> MEDCalculatorDBFieldExpr::getDirectChildrenWithNull() const
+{
+  return std::vector<const BigMemoryObject *>();
+}
+
+MEDCalculatorDBFieldExprField::MEDCalculatorDBFieldExprField(const MEDCalculatorDBFieldReal& f):_field(new MEDCalculatorDBFieldReal(f))
+{
+  _ids=f._t.getIds(f._time_steps.size());
+  _snapshot.resize(_ids.size());
+  for(std::size_t i=0;i<_ids.size();i++)
+    {
+      const MEDCalculatorDBSliceField *slice(f._time_steps[_ids[i]]);
+      if(slice->isFetched() && !slice->isReadFromFile())
+        _snapshot[i]=slice->pinField();
+    }
+}
+
+MEDCalculatorDBFieldExprField::~MEDCalculatorDBFieldExprField()
+{
+}
+
+std::size_t MEDCalculatorDBFieldExprField::getHeapMemorySizeWithoutChildren() const
+{
+  return sizeof(MEDCalculatorDBFieldExprField)+_ids.capacity()*sizeof(std::size_t)+_snapshot.capacity()*sizeof(MCAuto<MEDCouplingFieldDouble>);
+}
+
+/*!
+ * Only the copy of the operand : the snapshots are the fields of its steps at the time \a this has been built, already counted by the steps.
+ */
+std::vector<const BigMemoryObject *> MEDCalculatorDBFieldExprField::getDirectChildrenWithNull() const
+{
+  std::vector<const BigMemoryObject *> ret;
+  ret.push_back((const MEDCalculatorDBFieldReal *)_field);
+  return ret;
+}
+
+/*!
+ * Nothing is read here : the steps of file based operands not in memory are read one by one by evaluate, so that only
+ * the steps being computed are in memory. Steps of operands that are themselves deferred are not computed here either.
+ */
+void MEDCalculatorDBFieldExprField::prepare() const
+{
+  if((const MEDCalculatorDBFieldExpr *)_field->_expr)
+    _field->_expr->prepare();
+}
+
+/*!
+ * Returns true if the evaluation of several steps can reference the same mesh : the steps in memory share the mesh
+ * they have been read with, whereas a step read by evaluate has a mesh of its own.
+ */
+bool MEDCalculatorDBFieldExprField::sharesMeshesBetweenSteps() const
+{
+  const MEDCalculatorDBFieldReal& f(*_field);
+  for(std::size_t i=0;i<_ids.size();i++)
+    {
+      if(!_snapshot[i].isNull())
+        return true;
+      const MEDCalculatorDBSliceField *slice(f._time_steps[_ids[i]]);
+      if(slice->isFetched() && !slice->isModified())
+        return true;
+    }
+  if((const MEDCalculatorDBFieldExpr *)f._expr)
+    return f._expr->sharesMeshesBetweenSteps();
+  return false;
+}
+
+/*!
+ * Returns the values of step \a stepId of the operand as they were when \a this has been built. If the step has been
+ * modified in place since, the original values are recomputed (or read again) instead.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBFieldExprField::evaluate(std::size_t stepId) const
+{
+  const MEDCalculatorDBFieldReal& f(*_field);
+  MCAuto<MEDCouplingFieldDouble> whole(_snapshot[stepId]);
+  if(whole.isNull())
+    {
+      std::size_t id(_ids[stepId]);
+      const MEDCalculatorDBSliceField *slice(f._time_steps[id]);
+      if(slice->isFetched() && !slice->isModified())
+        whole=slice->pinField();
+      else if((const MEDCalculatorDBFieldExpr *)f._expr)
+        whole=f._expr->evaluate(id);
+      else
+        whole=slice->readField(f._type,f._file_name,f._mesh_name,f._field_name);
+    }
+  if(f._c.isAll() && whole->getRCValue()==1)
+    return whole.retn();
+  std::vector<std::size_t> tIds=f._c.getIds(f._c_labels.size());
+  return whole->keepSelectedComponents(tIds);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBFieldExprCst::evaluate(std::size_t stepId) const
+{
+  throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldExprCst::evaluate : a constant has no support !");
+}
+
+MEDCalculatorDBFieldExprBinary::MEDCalculatorDBFieldExprBinary(OpType op, MEDCalculatorDBFieldExpr *left, MEDCalculatorDBFieldExpr *right):_op(op),_left(left),_right(right)
+{
+  if(left->isCst() && right->isCst())
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldExprBinary constructor : at least one operand is expected to be a field !");
+  left->incrRef();
+  right->incrRef();
+}
+
+std::vector<const BigMemoryObject *> MEDCalculatorDBFieldExprBinary::getDirectChildrenWithNull() const
+{
+  std::vector<const BigMemoryObject *> ret;
+  ret.push_back((const MEDCalculatorDBFieldExpr *)_left);
+  ret.push_back((const MEDCalculatorDBFieldExpr *)_right);
+  return ret;
+}
+
+void MEDCalculatorDBFieldExprBinary::prepare() const
+{
+  _left->prepare();
+  _right->prepare();
+}
+
+bool MEDCalculatorDBFieldExprBinary::sharesMeshesBetweenSteps() const
+{
+  return _left->sharesMeshesBetweenSteps() || _right->sharesMeshesBetweenSteps();
+}
+
+/*!
+ * Evaluates step \a stepId of the whole sub tree. The left operand returns a new field that is modified in place,
+ * so only one field per level of the tree is alive at a time. A constant operand is broadcast directly on the
+ * values of the other one, no constant field is built.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBFieldExprBinary::evaluate(std::size_t stepId) const
+{
+  if(_left->isCst())
+    {
+      MCAuto<MEDCouplingFieldDouble> r=_right->evaluate(stepId);
+      applyCst(r,static_cast<const MEDCalculatorDBFieldExprCst *>((const MEDCalculatorDBFieldExpr *)_left)->getValue(),true);
+      return r.retn();
+    }
+  MCAuto<MEDCouplingFieldDouble> l=_left->evaluate(stepId);
+  if(_right->isCst())
+    {
+      applyCst(l,static_cast<const MEDCalculatorDBFieldExprCst *>((const MEDCalculatorDBFieldExpr *)_right)->getValue(),false);
+      return l.retn();
+    }
+  MCAuto<MEDCouplingFieldDouble> r=_right->evaluate(stepId);
+  MCAuto<DataArrayIdType> cellCor,nodeCor;
+  checkMeshes(l,r,cellCor,nodeCor);
+  MEDCalculatorDBSliceField::PutOnSameSupport(l,r,cellCor,nodeCor);
+  switch(_op)
+    {
+    case ADD:
+      (*l)+=(*r);
+      break;
+    case SUB:
+      (*l)-=(*r);
+      break;
+    case MUL:
+      (*l)*=(*r);
+      break;
+    case DIV:
+      (*l)/=(*r);
+      break;
+    default:
+      throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldExprBinary::evaluate : unrecognized operator !");
+    }
+  return l.retn();
+}
+
+/*!
+ * Applies in place on \a f the operator of \a this with \a val as other operand. If \a cstFirst the result is \a val op \a f.
+ */
+void MEDCalculatorDBFieldExprBinary::applyCst(MEDCouplingFieldDouble *f, double val, bool cstFirst) const
+{
+  DataArrayDouble *arr(f->getArray());
+  if(!arr)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldExprBinary::applyCst : field with no array !");
+  switch(_op)
+    {
+    case ADD:
+      arr->applyLin(1.,val);
+      break;
+    case SUB:
+      if(cstFirst)
+        arr->applyLin(-1.,val);
+      else
+        arr->applyLin(1.,-val);
+      break;
+    case MUL:
+      arr->applyLin(val,0.);
+      break;
+    case DIV:
+      {
+        double *pt(arr->getPointer());
+        std::size_t nbOfElems(arr->getNbOfElems());
+        if(cstFirst)
+          for(std::size_t i=0;i<nbOfElems;i++)
+            pt[i]=val/pt[i];
+        else
+          for(std::size_t i=0;i<nbOfElems;i++)
+            pt[i]/=val;
+        arr->declareAsNew();
+        break;
+      }
+    default:
+      throw INTERP_KERNEL::Exception("MEDCalculatorDBFieldExprBinary::applyCst : unrecognized operator !");
+    }
+}
+
+/*!
+ * All the steps of a multi time field share their mesh, so the geometrical check (and the correspondence of \a r onto
+ * \a l it returns if any) is computed for the first step evaluated and then taken from MEDCalculatorDBMeshCorrespondences.
+ */
+void MEDCalculatorDBFieldExprBinary::checkMeshes(const MEDCouplingFieldDouble *l, const MEDCouplingFieldDouble *r,
+                                                 MCAuto<DataArrayIdType>& cellCor, MCAuto<DataArrayIdType>& nodeCor) const
+{
+  if(l->getMesh()==r->getMesh())
+    return;
+  DataArrayIdType *cc(0),*nc(0);
+  MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(l->getMesh(),r->getMesh(),1,1e-12,cc,nc);//1 for fast check
+  cellCor=cc;
+  nodeCor=nc;
+}
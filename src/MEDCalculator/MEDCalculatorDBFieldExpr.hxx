@@ -0,0 +1,116 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBFIELDEXPR_HXX__
+#define __MEDCALCULATORDBFIELDEXPR_HXX__
+
+#include "MedCalculatorDefines.hxx"
+
+#include "MEDCouplingRefCountObject.hxx"
+#include "MCType.hxx"
+#include "MCAuto.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <vector>
+
+namespace MEDCoupling
+{
+  class MEDCouplingFieldDouble;
+  class MEDCalculatorDBFieldReal;
+
+  /*!
+   * Node of a deferred arithmetic expression on MEDCalculatorDBFieldReal instances. Operators on MEDCalculatorDBFieldReal
+   * only build such a tree, which is evaluated step by step when the result is needed. So no intermediate multi steps
+   * field is ever built whatever the length of the expression.
+   * \a stepId in evaluate is an id in the whole list of steps of the field owning the expression.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldExpr : public RefCountObject
+  {
+  public:
+    std::size_t getHeapMemorySizeWithoutChildren() const;
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
+    virtual bool isCst() const { return false; }
+    virtual void prepare() const = 0;
+    virtual bool sharesMeshesBetweenSteps() const = 0;
+    virtual MEDCouplingFieldDouble *evaluate(std::size_t stepId) const = 0;
+  };
+
+  /*!
+   * Leaf of an expression. It refers to a copy of the operand, sharing its steps, and keeps a reference on the steps
+   * already fetched when the expression has been built.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldExprField : public MEDCalculatorDBFieldExpr
+  {
+  public:
+    MEDCalculatorDBFieldExprField(const MEDCalculatorDBFieldReal& f);
+    std::size_t getHeapMemorySizeWithoutChildren() const;
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
+    void prepare() const;
+    bool sharesMeshesBetweenSteps() const;
+    MEDCouplingFieldDouble *evaluate(std::size_t stepId) const;
+  private:
+    ~MEDCalculatorDBFieldExprField();
+  private:
+    MCAuto<MEDCalculatorDBFieldReal> _field;
+    std::vector<std::size_t> _ids;
+    std::vector< MCAuto<MEDCouplingFieldDouble> > _snapshot;
+  };
+
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldExprCst : public MEDCalculatorDBFieldExpr
+  {
+  public:
+    MEDCalculatorDBFieldExprCst(double val):_val(val) { }
+    bool isCst() const { return true; }
+    double getValue() const { return _val; }
+    void prepare() const { }
+    bool sharesMeshesBetweenSteps() const { return false; }
+    MEDCouplingFieldDouble *evaluate(std::size_t stepId) const;
+  private:
+    double _val;
+  };
+
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBFieldExprBinary : public MEDCalculatorDBFieldExpr
+  {
+  public:
+    enum OpType
+      {
+        ADD = 0,
+        SUB = 1,
+        MUL = 2,
+        DIV = 3
+      };
+    MEDCalculatorDBFieldExprBinary(OpType op, MEDCalculatorDBFieldExpr *left, MEDCalculatorDBFieldExpr *right);
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
+    void prepare() const;
+    bool sharesMeshesBetweenSteps() const;
+    MEDCouplingFieldDouble *evaluate(std::size_t stepId) const;
+  private:
+    void applyCst(MEDCouplingFieldDouble *f, double val, bool cstFirst) const;
+    void checkMeshes(const MEDCouplingFieldDouble *l, const MEDCouplingFieldDouble *r,
+                     MCAuto<DataArrayIdType>& cellCor, MCAuto<DataArrayIdType>& nodeCor) const;
+  private:
+    OpType _op;
+    MCAuto<MEDCalculatorDBFieldExpr> _left;
+    MCAuto<MEDCalculatorDBFieldExpr> _right;
+  };
+}
+
+#endif
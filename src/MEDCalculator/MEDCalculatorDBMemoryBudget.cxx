@@ -0,0 +1,312 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBMemoryBudget.hxx"
+#include "MEDCalculatorDBSliceField.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
+
+#include <sstream>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  //! 64 bits offsets : the scratch file can exceed 2GB whatever the size of long
+  int SeekScratch(std::FILE *f, Int64 offset)
+  {
+#ifdef WIN32
+    return _fseeki64(f,offset,SEEK_SET);
+#else
+    return fseeko(f,(off_t)offset,SEEK_SET);
+#endif
+  }
+}
+
+std::size_t MEDCalculatorDBMemoryBudget::_budget=0;
+
+std::size_t MEDCalculatorDBMemoryBudget::_in_use=0;
+
+MEDCalculatorDBMemoryBudget::LRUList MEDCalculatorDBMemoryBudget::_lru;
+
+std::map<const MEDCalculatorDBSliceField *, std::pair<MEDCalculatorDBMemoryBudget::LRUList::iterator,std::size_t> > MEDCalculatorDBMemoryBudget::_pos;
+
+int MEDCalculatorDBMemoryBudget::_nb_of_evictions=0;
+
+int MEDCalculatorDBMemoryBudget::_nb_of_spills=0;
+
+int MEDCalculatorDBMemoryBudget::_nb_of_reloads=0;
+
+std::FILE *MEDCalculatorDBMemoryBudget::_scratch=0;
+
+std::size_t MEDCalculatorDBMemoryBudget::_scratch_size=0;
+
+std::map<Int64,std::size_t> MEDCalculatorDBMemoryBudget::_used_regions;
+
+std::map<Int64,std::size_t> MEDCalculatorDBMemoryBudget::_free_regions;
+
+pthread_mutex_t MEDCalculatorDBMemoryBudget::_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+ * Sets the maximal size in bytes of the arrays of the steps kept in memory. 0 means no limit.
+ */
+void MEDCalculatorDBMemoryBudget::SetBudget(std::size_t nbOfBytes)
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  _budget=nbOfBytes;
+  Enforce();
+}
+
+std::size_t MEDCalculatorDBMemoryBudget::GetBudget()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _budget;
+}
+
+/*!
+ * Returns the size in bytes of the arrays of the steps in memory, including the ones waiting in a MEDCalculatorDBReadAhead.
+ */
+std::size_t MEDCalculatorDBMemoryBudget::GetMemoryInUse()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _in_use+MEDCalculatorDBReadAhead::GetMemoryInUse();
+}
+
+int MEDCalculatorDBMemoryBudget::GetNumberOfResidentSteps()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return (int)_lru.size();
+}
+
+int MEDCalculatorDBMemoryBudget::GetNumberOfEvictions()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _nb_of_evictions;
+}
+
+int MEDCalculatorDBMemoryBudget::GetNumberOfSpills()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _nb_of_spills;
+}
+
+int MEDCalculatorDBMemoryBudget::GetNumberOfReloads()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _nb_of_reloads;
+}
+
+std::size_t MEDCalculatorDBMemoryBudget::GetScratchFileSize()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _scratch_size;
+}
+
+std::string MEDCalculatorDBMemoryBudget::GetStatistics()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  std::ostringstream oss;
+  oss << "Memory budget : ";
+  if(_budget!=0)
+    oss << _budget << " bytes";
+  else
+    oss << "none";
+  oss << "\nMemory in use : " << _in_use << " bytes in " << _lru.size() << " steps";
+  oss << "\nRead ahead : " << MEDCalculatorDBReadAhead::GetMemoryInUse() << " bytes";
+  oss << "\nEvictions : " << _nb_of_evictions << " (" << _nb_of_spills << " spilled to scratch file)";
+  oss << "\nReloads : " << _nb_of_reloads;
+  oss << "\nScratch file size : " << _scratch_size << " bytes";
+  return oss.str();
+}
+
+void MEDCalculatorDBMemoryBudget::ResetStatistics()
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  _nb_of_evictions=0;
+  _nb_of_spills=0;
+  _nb_of_reloads=0;
+}
+
+/*!
+ * Lock expected to be held. Puts \a slice, whose content is \a nbOfBytes large, in front of the LRU list.
+ */
+void MEDCalculatorDBMemoryBudget::Touch(const MEDCalculatorDBSliceField *slice, std::size_t nbOfBytes)
+{
+  std::map<const MEDCalculatorDBSliceField *, std::pair<LRUList::iterator,std::size_t> >::iterator it=_pos.find(slice);
+  if(it!=_pos.end())
+    {
+      _in_use-=(*it).second.second;
+      _lru.splice(_lru.begin(),_lru,(*it).second.first);
+      (*it).second.first=_lru.begin();
+      (*it).second.second=nbOfBytes;
+    }
+  else
+    {
+      _lru.push_front(slice);
+      _pos[slice]=std::pair<LRUList::iterator,std::size_t>(_lru.begin(),nbOfBytes);
+    }
+  _in_use+=nbOfBytes;
+}
+
+/*!
+ * Lock expected to be held. Removes \a slice from the LRU list, if it is in.
+ */
+void MEDCalculatorDBMemoryBudget::Forget(const MEDCalculatorDBSliceField *slice)
+{
+  std::map<const MEDCalculatorDBSliceField *, std::pair<LRUList::iterator,std::size_t> >::iterator it=_pos.find(slice);
+  if(it==_pos.end())
+    return ;
+  _in_use-=(*it).second.second;
+  _lru.erase((*it).second.first);
+  _pos.erase(it);
+}
+
+/*!
+ * Lock expected to be held. Evicts the least recently used steps that can be until the budget is respected. The steps
+ * waiting in a MEDCalculatorDBReadAhead can't be evicted : they leave less room to the others.
+ */
+void MEDCalculatorDBMemoryBudget::Enforce()
+{
+  if(_budget==0)
+    return ;
+  std::size_t readAhead(MEDCalculatorDBReadAhead::GetMemoryInUse());
+  std::size_t budget(_budget>readAhead?_budget-readAhead:0);
+  std::size_t rank=_lru.size();
+  LRUList::iterator it=_lru.end();
+  while(_in_use>budget && it!=_lru.begin())
+    {
+      --it; rank--;
+      if(rank<NB_OF_PROTECTED_STEPS)
+        break;
+      const MEDCalculatorDBSliceField *slice=*it;
+      bool spilled(false);
+      if(slice->evict(spilled))
+        {
+          std::map<const MEDCalculatorDBSliceField *, std::pair<LRUList::iterator,std::size_t> >::iterator it2=_pos.find(slice);
+          _in_use-=(*it2).second.second;
+          _pos.erase(it2);
+          it=_lru.erase(it);
+          _nb_of_evictions++;
+          if(spilled)
+            _nb_of_spills++;
+        }
+    }
+}
+
+/*!
+ * Lock expected to be held. Writes \a nbOfElems values in the scratch file and returns where they have been written, -1
+ * if there is nothing to write. They go in the first free region large enough, else at the end of the file.
+ * The scratch file is an anonymous temporary file removed at exit.
+ */
+Int64 MEDCalculatorDBMemoryBudget::Spill(const double *data, std::size_t nbOfElems)
+{
+  std::size_t nbOfBytes(nbOfElems*sizeof(double));
+  if(nbOfBytes==0)
+    return -1;
+  if(!_scratch)
+    {
+      _scratch=std::tmpfile();
+      if(!_scratch)
+        throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Spill : impossible to create the scratch file !");
+    }
+  Int64 ret((Int64)_scratch_size);
+  std::map<Int64,std::size_t>::iterator it=_free_regions.begin();
+  for(;it!=_free_regions.end() && (*it).second<nbOfBytes;it++);
+  if(it!=_free_regions.end())
+    ret=(*it).first;
+  if(SeekScratch(_scratch,ret)!=0)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Spill : seek failed in scratch file !");
+  if(std::fwrite(data,sizeof(double),nbOfElems,_scratch)!=nbOfElems)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Spill : write failed in scratch file !");
+  if(it!=_free_regions.end())
+    {
+      // the rest of the region stays free
+      if((*it).second>nbOfBytes)
+        _free_regions[ret+(Int64)nbOfBytes]=(*it).second-nbOfBytes;
+      _free_regions.erase(it);
+    }
+  else
+    _scratch_size+=nbOfBytes;
+  _used_regions[ret]=nbOfBytes;
+  return ret;
+}
+
+/*!
+ * Lock expected to be held. Reads back \a nbOfElems values written by Spill at \a offset.
+ */
+void MEDCalculatorDBMemoryBudget::Reload(Int64 offset, double *data, std::size_t nbOfElems)
+{
+  if(offset<0)
+    return ;
+  if(!_scratch)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Reload : no scratch file !");
+  if(SeekScratch(_scratch,offset)!=0)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Reload : seek failed in scratch file !");
+  if(std::fread(data,sizeof(double),nbOfElems,_scratch)!=nbOfElems)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMemoryBudget::Reload : read failed in scratch file !");
+}
+
+/*!
+ * Lock expected to be held. The region written by Spill at \a offset is not needed anymore : it is merged with the free
+ * regions next to it to be reused by the next spills. A region at the end of the file shortens it.
+ */
+void MEDCalculatorDBMemoryBudget::Release(Int64 offset)
+{
+  std::map<Int64,std::size_t>::iterator it=_used_regions.find(offset);
+  if(it==_used_regions.end())
+    return ;
+  std::size_t nbOfBytes((*it).second);
+  _used_regions.erase(it);
+  std::map<Int64,std::size_t>::iterator after=_free_regions.find(offset+(Int64)nbOfBytes);
+  if(after!=_free_regions.end())
+    {
+      nbOfBytes+=(*after).second;
+      _free_regions.erase(after);
+    }
+  std::map<Int64,std::size_t>::iterator before=_free_regions.lower_bound(offset);
+  if(before!=_free_regions.begin())
+    {
+      --before;
+      if((*before).first+(Int64)(*before).second==offset)
+        {
+          offset=(*before).first;
+          nbOfBytes+=(*before).second;
+          _free_regions.erase(before);
+        }
+    }
+  if(offset+(Int64)nbOfBytes==(Int64)_scratch_size)
+    _scratch_size=(std::size_t)offset;
+  else
+    _free_regions[offset]=nbOfBytes;
+}
+
+void MEDCalculatorDBMemoryBudget::NotifyReload()
+{
+  _nb_of_reloads++;
+}
+
+MEDCalculatorDBMemoryBudgetLock::MEDCalculatorDBMemoryBudgetLock()
+{
+  pthread_mutex_lock(&MEDCalculatorDBMemoryBudget::_mutex);
+}
+
+MEDCalculatorDBMemoryBudgetLock::~MEDCalculatorDBMemoryBudgetLock()
+{
+  pthread_mutex_unlock(&MEDCalculatorDBMemoryBudget::_mutex);
+}
@@ -0,0 +1,104 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBMEMORYBUDGET_HXX__
+#define __MEDCALCULATORDBMEMORYBUDGET_HXX__
+
+#include "MedCalculatorDefines.hxx"
+
+#include "MCType.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <cstdio>
+#include <string>
+#include <list>
+#include <map>
+
+namespace MEDCoupling
+{
+  class MEDCalculatorDBSliceField;
+
+  /*!
+   * Process wide memory budget for the contents of the MEDCalculatorDBSliceField instances.
+   * Every step whose content is in memory is kept in a LRU list. When the budget (0, the default, means no limit) is
+   * exceeded the least recently used steps are evicted : a step read from a file and not modified since is simply
+   * released (and read again when needed), any other step is spilled into a scratch binary file and reloaded
+   * transparently. Steps referenced elsewhere (being used, or captured by a deferred expression) and the
+   * NB_OF_PROTECTED_STEPS most recently used ones are never evicted.
+   * The steps waiting in a MEDCalculatorDBReadAhead count against the budget too, but are not evicted.
+   * The regions of the scratch file released by steps modified or destroyed since they were spilled are reused.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBMemoryBudget
+  {
+  public:
+    static void SetBudget(std::size_t nbOfBytes);
+    static std::size_t GetBudget();
+    static std::size_t GetMemoryInUse();
+    static int GetNumberOfResidentSteps();
+    static int GetNumberOfEvictions();
+    static int GetNumberOfSpills();
+    static int GetNumberOfReloads();
+    static std::size_t GetScratchFileSize();
+    static std::string GetStatistics();
+    static void ResetStatistics();
+  private:
+    friend class MEDCalculatorDBSliceField;
+    friend class MEDCalculatorDBMemoryBudgetLock;
+    static void Touch(const MEDCalculatorDBSliceField *slice, std::size_t nbOfBytes);
+    static void Forget(const MEDCalculatorDBSliceField *slice);
+    static void Enforce();
+    static Int64 Spill(const double *data, std::size_t nbOfElems);
+    static void Reload(Int64 offset, double *data, std::size_t nbOfElems);
+    static void Release(Int64 offset);
+    static void NotifyReload();
+  private:
+    typedef std::list<const MEDCalculatorDBSliceField *> LRUList;
+    static const std::size_t NB_OF_PROTECTED_STEPS=2;
+    static std::size_t _budget;
+    static std::size_t _in_use;
+    static LRUList _lru;
+    static std::map<const MEDCalculatorDBSliceField *, std::pair<LRUList::iterator,std::size_t> > _pos;
+    static int _nb_of_evictions;
+    static int _nb_of_spills;
+    static int _nb_of_reloads;
+    static std::FILE *_scratch;
+    //! end of the last region in use of the scratch file
+    static std::size_t _scratch_size;
+    //! regions of the scratch file, offset to size in bytes
+    static std::map<Int64,std::size_t> _used_regions;
+    static std::map<Int64,std::size_t> _free_regions;
+    static pthread_mutex_t _mutex;
+  };
+
+  /*!
+   * Lock on the state of the MEDCalculatorDBMemoryBudget and of the contents of all the slices, held for the lifetime
+   * of the instance. It is always taken before MEDCalculatorDBIOGuard when both are needed.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBMemoryBudgetLock
+  {
+  public:
+    MEDCalculatorDBMemoryBudgetLock();
+    ~MEDCalculatorDBMemoryBudgetLock();
+  };
+}
+
+#endif
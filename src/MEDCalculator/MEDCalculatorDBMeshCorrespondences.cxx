@@ -0,0 +1,159 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBMeshCorrespondences.hxx"
+
+#include "MEDCouplingMesh.hxx"
+#include "MEDCouplingMemArray.hxx"
+
+using namespace MEDCoupling;
+
+std::list<MEDCalculatorDBMeshCorrespondences::Entry> MEDCalculatorDBMeshCorrespondences::_entries;
+
+pthread_mutex_t MEDCalculatorDBMeshCorrespondences::_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+int MEDCalculatorDBMeshCorrespondences::_nb_of_hits=0;
+
+int MEDCalculatorDBMeshCorrespondences::_nb_of_misses=0;
+
+/*!
+ * Same contract than MEDCouplingMesh::checkGeoEquivalWith called on \a m1 with \a m2 : throws if the meshes are not
+ * equivalent at level \a levOfCheck, and else returns in \a cellCor and \a nodeCor the correspondences (or null if
+ * none is needed). The caller has the ownership of a reference on the returned arrays.
+ */
+void MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(const MEDCouplingMesh *m1, const MEDCouplingMesh *m2, int levOfCheck, double prec,
+                                                             DataArrayIdType *&cellCor, DataArrayIdType *&nodeCor)
+{
+  cellCor=0; nodeCor=0;
+  if(!m1 || !m2)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith : null mesh !");
+  if(m1==m2)
+    return ;
+  std::size_t t1(m1->getTimeOfThis()),t2(m2->getTimeOfThis());
+  pthread_mutex_lock(&_mutex);
+  for(std::list<Entry>::iterator it=_entries.begin();it!=_entries.end();it++)
+    {
+      if((*it)._m1==m1 && (*it)._m2==m2 && (*it)._lev_of_check==levOfCheck && (*it)._prec==prec)
+        {
+          if((*it)._time1!=t1 || (*it)._time2!=t2)
+            {//one of the meshes has been modified since
+              _entries.erase(it);
+              break;
+            }
+          _nb_of_hits++;
+          _entries.splice(_entries.begin(),_entries,it);
+          const Entry& e(_entries.front());
+          if(!e._equiv)
+            {
+              std::string msg(e._msg);
+              pthread_mutex_unlock(&_mutex);
+              throw INTERP_KERNEL::Exception(msg.c_str());
+            }
+          if(e._cell_cor.isNotNull())
+            {
+              cellCor=const_cast<DataArrayIdType *>((const DataArrayIdType *)e._cell_cor);
+              cellCor->incrRef();
+            }
+          if(e._node_cor.isNotNull())
+            {
+              nodeCor=const_cast<DataArrayIdType *>((const DataArrayIdType *)e._node_cor);
+              nodeCor->incrRef();
+            }
+          pthread_mutex_unlock(&_mutex);
+          return ;
+        }
+    }
+  _nb_of_misses++;
+  pthread_mutex_unlock(&_mutex);
+  Entry e;
+  e._m1=m1;
+  e._m2=m2;
+  e._time1=t1;
+  e._time2=t2;
+  e._lev_of_check=levOfCheck;
+  e._prec=prec;
+  e._equiv=true;
+  DataArrayIdType *cc(0),*nc(0);
+  try
+    {
+      m1->checkGeoEquivalWith(m2,levOfCheck,prec,cc,nc);
+    }
+  catch(INTERP_KERNEL::Exception& ex)
+    {
+      e._equiv=false;
+      e._msg=ex.what();
+    }
+  catch(...)
+    {// not a result of the comparison (lack of memory...) : not cached
+      if(cc)
+        cc->decrRef();
+      if(nc)
+        nc->decrRef();
+      throw;
+    }
+  e._cell_cor=cc;
+  e._node_cor=nc;
+  pthread_mutex_lock(&_mutex);
+  _entries.push_front(e);
+  if(_entries.size()>MAX_NB_OF_ENTRIES)
+    _entries.pop_back();
+  pthread_mutex_unlock(&_mutex);
+  if(!e._equiv)
+    throw INTERP_KERNEL::Exception(e._msg.c_str());
+  if(cc)
+    cc->incrRef();
+  if(nc)
+    nc->incrRef();
+  cellCor=cc;
+  nodeCor=nc;
+}
+
+void MEDCalculatorDBMeshCorrespondences::Clear()
+{
+  pthread_mutex_lock(&_mutex);
+  _entries.clear();
+  _nb_of_hits=0;
+  _nb_of_misses=0;
+  pthread_mutex_unlock(&_mutex);
+}
+
+int MEDCalculatorDBMeshCorrespondences::GetNumberOfEntries()
+{
+  pthread_mutex_lock(&_mutex);
+  int ret=(int)_entries.size();
+  pthread_mutex_unlock(&_mutex);
+  return ret;
+}
+
+int MEDCalculatorDBMeshCorrespondences::GetNumberOfHits()
+{
+  pthread_mutex_lock(&_mutex);
+  int ret=_nb_of_hits;
+  pthread_mutex_unlock(&_mutex);
+  return ret;
+}
+
+int MEDCalculatorDBMeshCorrespondences::GetNumberOfMisses()
+{
+  pthread_mutex_lock(&_mutex);
+  int ret=_nb_of_misses;
+  pthread_mutex_unlock(&_mutex);
+  return ret;
+}
@@ -0,0 +1,81 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBMESHCORRESPONDENCES_HXX__
+#define __MEDCALCULATORDBMESHCORRESPONDENCES_HXX__
+
+#include "MedCalculatorDefines.hxx"
+#include "MCType.hxx"
+#include "MCAuto.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <string>
+#include <list>
+
+namespace MEDCoupling
+{
+  class MEDCouplingMesh;
+
+  /*!
+   * Process wide cache of the results of MEDCouplingMesh::checkGeoEquivalWith between pairs of meshes.
+   * A multi time field has one mesh for all its steps, so the comparison of the meshes of two operands (coordinates and
+   * connectivity) is done once and then only the correspondence is applied on each step.
+   * The cache doesn't own the meshes, that stay released with the fields using them : a pair is identified by the
+   * addresses of the meshes and their time labels. The time labels are unique so that a pair can't be confused with a
+   * newer one reusing the same addresses, and an entry is recomputed if one of the meshes has been modified since.
+   * Pairs found not equivalent are kept too and throw the same exception again.
+   * Only the MAX_NB_OF_ENTRIES last pairs are kept.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBMeshCorrespondences
+  {
+  public:
+    static void CheckGeoEquivalWith(const MEDCouplingMesh *m1, const MEDCouplingMesh *m2, int levOfCheck, double prec,
+                                    DataArrayIdType *&cellCor, DataArrayIdType *&nodeCor);
+    static void Clear();
+    static int GetNumberOfEntries();
+    static int GetNumberOfHits();
+    static int GetNumberOfMisses();
+  private:
+    class Entry
+    {
+    public:
+      //! never dereferenced : the mesh may have been destroyed since
+      const MEDCouplingMesh *_m1;
+      const MEDCouplingMesh *_m2;
+      std::size_t _time1;
+      std::size_t _time2;
+      int _lev_of_check;
+      double _prec;
+      MCAuto<DataArrayIdType> _cell_cor;
+      MCAuto<DataArrayIdType> _node_cor;
+      bool _equiv;
+      std::string _msg;
+    };
+    static const std::size_t MAX_NB_OF_ENTRIES=16;
+    static std::list<Entry> _entries;
+    static int _nb_of_hits;
+    static int _nb_of_misses;
+    static pthread_mutex_t _mutex;
+  };
+}
+
+#endif
@@ -0,0 +1,333 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBReadAhead.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+#include "MEDCalculatorDBMemoryBudget.hxx"
+
+#include "MEDLoader.hxx"
+#include "MEDFileMesh.hxx"
+#include "MEDFileField.hxx"
+
+#include "MEDCouplingFieldDouble.hxx"
+
+#include <algorithm>
+#include <exception>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  std::size_t GetArraySize(const MEDCouplingFieldDouble *f)
+  {
+    const DataArrayDouble *arr(f->getArray());
+    return arr?arr->getNbOfElems()*sizeof(double):0;
+  }
+}
+
+int MEDCalculatorDBReadAhead::_default_depth=0;
+
+int MEDCalculatorDBReadAhead::_nb_of_hits=0;
+
+int MEDCalculatorDBReadAhead::_nb_of_misses=0;
+
+std::size_t MEDCalculatorDBReadAhead::_memory_in_use=0;
+
+pthread_mutex_t MEDCalculatorDBReadAhead::_stats_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+ * Sets the maximal number of steps read in advance by MEDCalculatorDBFieldReal::fetchData. 0 disables the read ahead :
+ * the steps are then read in the calling thread before being used.
+ */
+void MEDCalculatorDBReadAhead::SetDepth(int depth)
+{
+  if(depth<0)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBReadAhead::SetDepth : depth must be >= 0 !");
+  pthread_mutex_lock(&_stats_mutex);
+  _default_depth=depth;
+  pthread_mutex_unlock(&_stats_mutex);
+}
+
+int MEDCalculatorDBReadAhead::GetDepth()
+{
+  pthread_mutex_lock(&_stats_mutex);
+  int ret=_default_depth;
+  pthread_mutex_unlock(&_stats_mutex);
+  return ret;
+}
+
+/*!
+ * Returns the number of steps taken that had already been read by the background thread.
+ */
+int MEDCalculatorDBReadAhead::GetNumberOfHits()
+{
+  pthread_mutex_lock(&_stats_mutex);
+  int ret=_nb_of_hits;
+  pthread_mutex_unlock(&_stats_mutex);
+  return ret;
+}
+
+/*!
+ * Returns the number of steps asked before the background thread reached them, that the caller had to read itself.
+ */
+int MEDCalculatorDBReadAhead::GetNumberOfMisses()
+{
+  pthread_mutex_lock(&_stats_mutex);
+  int ret=_nb_of_misses;
+  pthread_mutex_unlock(&_stats_mutex);
+  return ret;
+}
+
+/*!
+ * Returns the size in bytes of the arrays of the steps read and not taken yet.
+ */
+std::size_t MEDCalculatorDBReadAhead::GetMemoryInUse()
+{
+  pthread_mutex_lock(&_stats_mutex);
+  std::size_t ret=_memory_in_use;
+  pthread_mutex_unlock(&_stats_mutex);
+  return ret;
+}
+
+void MEDCalculatorDBReadAhead::ResetStatistics()
+{
+  pthread_mutex_lock(&_stats_mutex);
+  _nb_of_hits=0;
+  _nb_of_misses=0;
+  pthread_mutex_unlock(&_stats_mutex);
+}
+
+/*!
+ * Starts the reading of \a steps (pairs of iteration and order) of the field \a fieldName lying on \a mname in \a fname.
+ */
+MEDCalculatorDBReadAhead *MEDCalculatorDBReadAhead::New(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                                                        const std::vector< std::pair<int,int> >& steps)
+{
+  return new MEDCalculatorDBReadAhead(type,fname,mname,fieldName,steps);
+}
+
+MEDCalculatorDBReadAhead::MEDCalculatorDBReadAhead(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                                                   const std::vector< std::pair<int,int> >& steps):_type(type),_file_name(fname),_mesh_name(mname),
+                                                                                                   _field_name(fieldName),_steps(steps),
+                                                                                                   _states(steps.size(),PENDING),_fields(steps.size(),(MEDCouplingFieldDouble *)0),
+                                                                                                   _depth(std::max(GetDepth(),1)),_next(0),_nb_of_waiting(0),
+                                                                                                   _stop(false),_started(false)
+{
+  pthread_mutex_init(&_mutex,NULL);
+  pthread_cond_init(&_cond,NULL);
+  _started=pthread_create(&_thread,NULL,th_readsteps,(void*)this)==0;
+  if(!_started)
+    _next=_steps.size();
+}
+
+std::size_t MEDCalculatorDBReadAhead::getHeapMemorySizeWithoutChildren() const
+{
+  return 0;
+}
+
+std::vector<const BigMemoryObject *> MEDCalculatorDBReadAhead::getDirectChildrenWithNull() const
+{
+  return std::vector<const BigMemoryObject *>();
+}
+
+/*!
+ * Returns the step #\a id (in the order given at construction), waiting for it if it is being read. Returns null if
+ * the thread did not reach it yet (it won't read it anymore), if its reading failed or if it has already been taken :
+ * the caller reads it itself. The caller has the ownership of the returned field.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBReadAhead::take(std::size_t id)
+{
+  MEDCouplingFieldDouble *ret=0;
+  pthread_mutex_lock(&_mutex);
+  if(_states[id]==PENDING && id>=_next)
+    _states[id]=SKIPPED;
+  while(_states[id]==PENDING)
+    pthread_cond_wait(&_cond,&_mutex);
+  if(_states[id]==READY)
+    {
+      ret=_fields[id];
+      _fields[id]=0;
+      _states[id]=TAKEN;
+      _nb_of_waiting--;
+      pthread_cond_broadcast(&_cond);
+    }
+  pthread_mutex_unlock(&_mutex);
+  pthread_mutex_lock(&_stats_mutex);
+  if(ret)
+    {
+      _nb_of_hits++;
+      _memory_in_use-=GetArraySize(ret);
+    }
+  else
+    _nb_of_misses++;
+  pthread_mutex_unlock(&_stats_mutex);
+  return ret;
+}
+
+/*!
+ * Notifies that the step #\a id won't be taken : it is released if already read, and not read at all if possible.
+ */
+void MEDCalculatorDBReadAhead::cancel(std::size_t id)
+{
+  pthread_mutex_lock(&_mutex);
+  if(_states[id]==READY)
+    {
+      pthread_mutex_lock(&_stats_mutex);
+      _memory_in_use-=GetArraySize(_fields[id]);
+      pthread_mutex_unlock(&_stats_mutex);
+      _fields[id]->decrRef();
+      _fields[id]=0;
+      _states[id]=TAKEN;
+      _nb_of_waiting--;
+      pthread_cond_broadcast(&_cond);
+    }
+  else if(_states[id]==PENDING)
+    _states[id]=id>=_next?SKIPPED:CANCELLED;
+  pthread_mutex_unlock(&_mutex);
+}
+
+MEDCalculatorDBReadAhead::~MEDCalculatorDBReadAhead()
+{
+  pthread_mutex_lock(&_mutex);
+  _stop=true;
+  pthread_cond_broadcast(&_cond);
+  pthread_mutex_unlock(&_mutex);
+  if(_started)
+    pthread_join(_thread,NULL);
+  pthread_mutex_lock(&_stats_mutex);
+  for(std::vector<MEDCouplingFieldDouble *>::iterator it=_fields.begin();it!=_fields.end();it++)
+    if(*it)
+      {
+        _memory_in_use-=GetArraySize(*it);
+        (*it)->decrRef();
+      }
+  pthread_mutex_unlock(&_stats_mutex);
+  pthread_cond_destroy(&_cond);
+  pthread_mutex_destroy(&_mutex);
+}
+
+/*!
+ * Returns true if the steps waiting to be taken leave room, in the memory budget, for reading more of them.
+ * Must not be called with an instance mutex held : the memory budget lock is taken before them.
+ */
+bool MEDCalculatorDBReadAhead::HasRoom()
+{
+  std::size_t budget(MEDCalculatorDBMemoryBudget::GetBudget());
+  return budget==0 || GetMemoryInUse()<budget/2;
+}
+
+/*!
+ * Body of the background thread. The steps are read by batches of at most half of the depth, so that a batch can be
+ * read while the previous one is being used. The mesh is read from file once. The steps of a batch share their mesh
+ * instance, not the ones of different batches : the reference counters are not thread safe and the previous batches
+ * are used by other threads. As the file mesh hands out the same cached instance at each call, each batch gets a copy
+ * of it and the cached instance never leaves this thread. While the waiting steps take more than half of the
+ * memory budget, the thread waits for them to be taken before reading more.
+ */
+void MEDCalculatorDBReadAhead::readSteps()
+{
+  std::size_t batchSize=std::max(_depth/2,(std::size_t)1);
+  MCAuto<MEDFileMesh> fileMesh;
+  pthread_mutex_lock(&_mutex);
+  while(true)
+    {
+      while(!_stop && _next<_steps.size() && _nb_of_waiting+batchSize>_depth)
+        pthread_cond_wait(&_cond,&_mutex);
+      if(_stop || _next>=_steps.size())
+        break;
+      if(_nb_of_waiting>0)
+        {
+          pthread_mutex_unlock(&_mutex);
+          bool room(HasRoom());
+          pthread_mutex_lock(&_mutex);
+          if(!room)
+            {
+              std::size_t nbOfWaiting(_nb_of_waiting);
+              while(!_stop && _nb_of_waiting>0 && _nb_of_waiting>=nbOfWaiting)
+                pthread_cond_wait(&_cond,&_mutex);
+              continue;
+            }
+        }
+      std::vector<std::size_t> ids;
+      std::vector< std::pair<int,int> > its;
+      while(_next<_steps.size() && ids.size()<batchSize)
+        {
+          if(_states[_next]==PENDING)
+            {
+              ids.push_back(_next);
+              its.push_back(_steps[_next]);
+            }
+          _next++;
+        }
+      if(ids.empty())
+        continue;
+      pthread_mutex_unlock(&_mutex);
+      std::vector<MEDCouplingFieldDouble *> fs;
+      try
+        {
+          MEDCalculatorDBIOGuard guard;
+          if(fileMesh.isNull())
+            fileMesh=MEDFileMesh::New(_file_name,_mesh_name);
+          MCAuto<MEDCouplingMesh> mesh;
+          for(std::vector< std::pair<int,int> >::const_iterator it=its.begin();it!=its.end();it++)
+            {
+              MCAuto<MEDFileField1TS> f1ts(MEDFileField1TS::New(_file_name,_field_name,(*it).first,(*it).second));
+              MCAuto<MEDCouplingFieldDouble> f(f1ts->getFieldOnMeshAtLevel(_type,0,fileMesh));
+              if(mesh.isNull())
+                mesh=f->getMesh()->deepCopy();
+              f->setMesh(mesh);
+              fs.push_back(f.retn());
+            }
+        }
+      catch(std::exception&)
+        {
+          // the steps are marked as failed : the caller will read them again and get the exception
+        }
+      pthread_mutex_lock(&_mutex);
+      for(std::size_t i=0;i<ids.size();i++)
+        {
+          MEDCouplingFieldDouble *f=i<fs.size()?fs[i]:0;
+          if(f && _states[ids[i]]==PENDING)
+            {
+              pthread_mutex_lock(&_stats_mutex);
+              _memory_in_use+=GetArraySize(f);
+              pthread_mutex_unlock(&_stats_mutex);
+              _fields[ids[i]]=f;
+              _states[ids[i]]=READY;
+              _nb_of_waiting++;
+            }
+          else
+            {
+              if(f)
+                f->decrRef();
+              _states[ids[i]]=_states[ids[i]]==CANCELLED?TAKEN:FAILED;
+            }
+        }
+      pthread_cond_broadcast(&_cond);
+    }
+  pthread_mutex_unlock(&_mutex);
+}
+
+void *MEDCalculatorDBReadAhead::th_readsteps(void *s)
+{
+  MEDCalculatorDBReadAhead *st=(MEDCalculatorDBReadAhead *)s;
+  st->readSteps();
+  return 0;
+}
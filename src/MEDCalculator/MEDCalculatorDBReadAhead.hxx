@@ -0,0 +1,94 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBREADAHEAD_HXX__
+#define __MEDCALCULATORDBREADAHEAD_HXX__
+
+#include "MedCalculatorDefines.hxx"
+#include "MEDCouplingRefCountObject.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+namespace MEDCoupling
+{
+  class MEDCouplingFieldDouble;
+
+  /*!
+   * Reads, in a background thread, the steps of a field that are going to be used so that the reading of the next
+   * steps overlaps the computation on the current one. The steps are read in the given order, at most
+   * the depth (process wide setting, 0 by default meaning no read ahead) of them being waiting in memory to be taken.
+   * The waiting steps count against the MEDCalculatorDBMemoryBudget budget, and no more steps are read while they
+   * exceed half of it.
+   * A step asked before the thread reached it is skipped by the thread and read by the caller itself.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBReadAhead : public RefCountObject
+  {
+  public:
+    static void SetDepth(int depth);
+    static int GetDepth();
+    static int GetNumberOfHits();
+    static int GetNumberOfMisses();
+    static std::size_t GetMemoryInUse();
+    static void ResetStatistics();
+    static MEDCalculatorDBReadAhead *New(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                                         const std::vector< std::pair<int,int> >& steps);
+    std::size_t getHeapMemorySizeWithoutChildren() const;
+    std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
+    MEDCouplingFieldDouble *take(std::size_t id);
+    void cancel(std::size_t id);
+  private:
+    MEDCalculatorDBReadAhead(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                             const std::vector< std::pair<int,int> >& steps);
+    ~MEDCalculatorDBReadAhead();
+    void readSteps();
+    static bool HasRoom();
+    static void *th_readsteps(void *s);
+  private:
+    enum StepState { PENDING, READY, TAKEN, SKIPPED, CANCELLED, FAILED };
+    TypeOfField _type;
+    std::string _file_name;
+    std::string _mesh_name;
+    std::string _field_name;
+    std::vector< std::pair<int,int> > _steps;
+    std::vector<StepState> _states;
+    std::vector<MEDCouplingFieldDouble *> _fields;
+    std::size_t _depth;
+    //! id of the first step not yet considered by the thread
+    std::size_t _next;
+    std::size_t _nb_of_waiting;
+    bool _stop;
+    bool _started;
+    pthread_t _thread;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _cond;
+    static int _default_depth;
+    static int _nb_of_hits;
+    static int _nb_of_misses;
+    //! size in bytes of the arrays of the steps waiting to be taken, all the instances together
+    static std::size_t _memory_in_use;
+    static pthread_mutex_t _stats_mutex;
+  };
+}
+
+#endif
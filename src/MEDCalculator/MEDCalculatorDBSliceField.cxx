@@ -20,25 +20,168 @@
 
 #include "MEDCalculatorDBSliceField.hxx"
 #include "MEDCalculatorDBRangeSelection.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+#include "MEDCalculatorDBMemoryBudget.hxx"
+#include "MEDCalculatorDBCompiledExpr.hxx"
+#include "MEDCalculatorDBTensorKernels.hxx"
 
 #include "MEDLoader.hxx"
 
 #include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingMemArray.hxx"
 #include "MCAuto.hxx"
 
+#include <functional>
+#include <sstream>
+#include <cmath>
+
 using namespace MEDCoupling;
 
-MEDCalculatorDBSliceField::MEDCalculatorDBSliceField(int iter, int order):_iteration(iter),_order(order),_field(0),_work(0)
+namespace
+{
+  /*!
+   * Strided read only view on the components \a ids of the array of a field. Component #k of the view is component
+   * #ids[k] of the array : nothing is copied.
+   */
+  class ComponentsView
+  {
+  public:
+    ComponentsView(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids):_arr(f->getArray()),_ids(ids),_stride(0)
+    {
+      if(_arr)
+        _stride=_arr->getNumberOfComponents();
+    }
+    //! true if the view can be read : an allocated array and valid component ids
+    bool isValid() const
+    {
+      if(!_arr || !_arr->isAllocated())
+        return false;
+      for(std::vector<std::size_t>::const_iterator it=_ids.begin();it!=_ids.end();it++)
+        if(*it>=_stride)
+          return false;
+      return true;
+    }
+    mcIdType getNumberOfTuples() const { return _arr->getNumberOfTuples(); }
+    std::size_t getNumberOfComponents() const { return _ids.size(); }
+    const double *getTuple(mcIdType tupleId) const { return _arr->begin()+tupleId*_stride; }
+    std::size_t getId(std::size_t k) const { return _ids[k]; }
+    std::string getInfoOnComponent(std::size_t k) const { return _arr->getInfoOnComponent(_ids[k]); }
+  private:
+    const DataArrayDouble *_arr;
+    const std::vector<std::size_t>& _ids;
+    std::size_t _stride;
+  };
+
+  /*!
+   * Returns true if the strided kernels can be used for \a f1 and \a f2 : fields on cells or on nodes with one array,
+   * not needing a renumbering.
+   */
+  bool AreViewable(const MEDCouplingFieldDouble *f1, const MEDCouplingFieldDouble *f2, const DataArrayIdType *cc, const DataArrayIdType *nc)
+  {
+    if(cc!=0 || nc!=0)
+      return false;
+    if(f1->getTypeOfField()!=f2->getTypeOfField() || (f1->getTypeOfField()!=ON_CELLS && f1->getTypeOfField()!=ON_NODES))
+      return false;
+    if(f1->getTimeDiscretization()!=ONE_TIME || f2->getTimeDiscretization()!=ONE_TIME)
+      return false;
+    return true;
+  }
+
+  /*!
+   * Returns the result of \a op applied on the components \a ids1 of \a f1 and \a ids2 of \a f2, read in place.
+   * \a f2 can also have only one selected component, broadcast on all the ones of \a f1, if \a allowOneCompo.
+   * Returns null if the views are not compatible : the caller falls back on the MEDCouplingFieldDouble operators,
+   * that throw the usual exceptions.
+   */
+  template<class OP>
+  MEDCouplingFieldDouble *BinaryOnViews(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                        const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2, OP op, bool allowOneCompo)
+  {
+    ComponentsView v1(f1,ids1),v2(f2,ids2);
+    if(!v1.isValid() || !v2.isValid())
+      return 0;
+    std::size_t nbOfCompo(v1.getNumberOfComponents());
+    mcIdType nbOfTuples(v1.getNumberOfTuples());
+    bool bcast(v2.getNumberOfComponents()==1 && nbOfCompo!=1);
+    if(nbOfCompo==0 || v2.getNumberOfTuples()!=nbOfTuples || (v2.getNumberOfComponents()!=nbOfCompo && !(allowOneCompo && bcast)))
+      return 0;
+    MCAuto<DataArrayDouble> arr(DataArrayDouble::New());
+    arr->alloc(nbOfTuples,nbOfCompo);
+    double *pt(arr->getPointer());
+    for(mcIdType i=0;i<nbOfTuples;i++)
+      {
+        const double *t1(v1.getTuple(i)),*t2(v2.getTuple(i));
+        for(std::size_t k=0;k<nbOfCompo;k++,pt++)
+          *pt=op(t1[v1.getId(k)],t2[v2.getId(bcast?0:k)]);
+      }
+    for(std::size_t k=0;k<nbOfCompo;k++)
+      arr->setInfoOnComponent(k,v1.getInfoOnComponent(k));
+    MCAuto<MEDCouplingFieldDouble> ret(f1->clone(false));
+    ret->setArray(arr);
+    ret->setName("");
+    return ret.retn();
+  }
+
+  /*!
+   * Returns \a f2 put on the support of \a f1 (see MEDCalculatorDBSliceField::PutOnSameSupport). If \a f2 is the
+   * content of a step (not a copy) it is not modified : a shallow copy of it, or a deep one if it has to be renumbered,
+   * is done first.
+   */
+  MCAuto<MEDCouplingFieldDouble> OnSameSupport(const MEDCouplingFieldDouble *f1, MCAuto<MEDCouplingFieldDouble> f2, const DataArrayIdType *cc, const DataArrayIdType *nc)
+  {
+    if(f2->getRCValue()>1)
+      f2=(cc!=0 || nc!=0)?f2->deepCopy():f2->clone(false);
+    MEDCalculatorDBSliceField::PutOnSameSupport(f1,f2,cc,nc);
+    return f2;
+  }
+}
+
+MEDCalculatorDBSliceField::MEDCalculatorDBSliceField(int iter, int order):_iteration(iter),_order(order),_has_time(false),_time(0.),_field(0),_work(0),_modified(false),
+                                                                        _has_src(false),_src_type(ON_CELLS),_mem_size(0),_read_ahead_id(0),
+                                                                        _skeleton(0),_spill_valid(false),_spill_offset(0),_spill_nb_of_tuples(0)
+{
+}
+
+MEDCalculatorDBSliceField::MEDCalculatorDBSliceField(int iter, int order, double time):_iteration(iter),_order(order),_has_time(true),_time(time),_field(0),_work(0),_modified(false),
+                                                                                     _has_src(false),_src_type(ON_CELLS),_mem_size(0),_read_ahead_id(0),
+                                                                                     _skeleton(0),_spill_valid(false),_spill_offset(0),_spill_nb_of_tuples(0)
 {
 }
 
-MEDCalculatorDBSliceField::MEDCalculatorDBSliceField(MEDCouplingFieldDouble *f):_field(f),_work(0)
+MEDCalculatorDBSliceField::MEDCalculatorDBSliceField(MEDCouplingFieldDouble *f):_iteration(0),_order(0),_has_time(false),_time(0.),_field(f),_work(0),_modified(false),
+                                                                               _has_src(false),_src_type(ON_CELLS),_mem_size(0),_read_ahead_id(0),
+                                                                               _skeleton(0),_spill_valid(false),_spill_offset(0),_spill_nb_of_tuples(0)
 {
+  if(f)
+    f->getTime(_iteration,_order);
+  MEDCalculatorDBMemoryBudgetLock lock;
+  residentField();
 }
 
+/*!
+ * The contents of the step (\a _field, \a _work and the skeleton left by a spill) are counted here, under the lock
+ * of MEDCalculatorDBMemoryBudget, rather than returned as children : they may be evicted at any time by another
+ * thread. Only their arrays are counted, not their mesh that is shared by all the steps.
+ */
 std::size_t MEDCalculatorDBSliceField::getHeapMemorySizeWithoutChildren() const
 {
-  return 0;
+  MEDCalculatorDBMemoryBudgetLock lock;
+  std::size_t ret=sizeof(MEDCalculatorDBSliceField)+_src_file.capacity()+_src_mesh.capacity()+_src_field.capacity()+_spill_name.capacity();
+  ret+=_spill_infos.capacity()*sizeof(std::string);
+  for(std::vector<std::string>::const_iterator it=_spill_infos.begin();it!=_spill_infos.end();it++)
+    ret+=(*it).capacity();
+  const MEDCouplingFieldDouble *contents[3]={_field,_work,_skeleton};
+  for(int i=0;i<3;i++)
+    {
+      if(!contents[i] || (i==1 && _work==_field))
+        continue;
+      ret+=contents[i]->getHeapMemorySizeWithoutChildren();
+      std::vector<DataArrayDouble *> arrs(contents[i]->getArrays());
+      for(std::vector<DataArrayDouble *>::const_iterator it=arrs.begin();it!=arrs.end();it++)
+        if(*it)
+          ret+=(*it)->getHeapMemorySize();
+    }
+  return ret;
 }
 
 std::vector<const BigMemoryObject *> MEDCalculatorDBSliceField::getDirectChildrenWithNull() const
@@ -46,34 +189,136 @@ std::vector<const BigMemoryObject *> MEDCalculatorDBSliceField::getDirectChildre
   return std::vector<const BigMemoryObject *>();
 }
 
+/*!
+ * Returns true if the content of this step is available without reading the file it comes from : in memory, in
+ * the scratch file of MEDCalculatorDBMemoryBudget or being read in background by a MEDCalculatorDBReadAhead.
+ */
+bool MEDCalculatorDBSliceField::isFetched() const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _field!=0 || _skeleton!=0 || !_read_ahead.isNull();
+}
+
+/*!
+ * Returns the content of this step if it is in memory or in the scratch file, null otherwise : it would then be read
+ * from its file with a mesh of its own. A content being read in background is not known : see takeReadAhead.
+ */
+const MEDCouplingFieldDouble *MEDCalculatorDBSliceField::getKnownContent() const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _field?_field:_skeleton;
+}
+
+/*!
+ * Puts the content of this step on \a m if its mesh is another instance equal to \a m : steps computed concurrently,
+ * each one with a mesh of its own, share one mesh afterwards.
+ */
+void MEDCalculatorDBSliceField::shareMesh(const MEDCouplingMesh *m) const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  MEDCouplingFieldDouble *f(_field?_field:_skeleton);
+  if(!f || !f->getMesh() || f->getMesh()==m)
+    return ;
+  if(f->getMesh()->isEqual(m,0.))
+    f->setMesh(m);
+}
+
+/*!
+ * Puts the content of this step, in memory or in the scratch file, on \a m. \a m is expected to be equal to its mesh.
+ */
+void MEDCalculatorDBSliceField::putOnMesh(const MEDCouplingMesh *m) const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  MEDCouplingFieldDouble *f(_field?_field:_skeleton);
+  if(f && f->getMesh()!=m)
+    f->setMesh(m);
+}
+
+/*!
+ * Returns the time value of this step : the one known at construction if any, else the one of its content.
+ */
+double MEDCalculatorDBSliceField::getTime() const
+{
+  if(_has_time)
+    return _time;
+  int it,order;
+  return pinField()->getTime(it,order);
+}
+
+/*!
+ * Returns true if the content of this step can be read again from the file it comes from.
+ */
+bool MEDCalculatorDBSliceField::isReadFromFile() const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  return _has_src && !_modified;
+}
+
 void MEDCalculatorDBSliceField::setField(MEDCouplingFieldDouble *f) const
 {
-  if(_field!=f)
+  MEDCalculatorDBMemoryBudgetLock lock;
+  setFieldUnderLock(f);
+  _has_src=false;
+  residentField();
+}
+
+/*!
+ * Same as setField for a content that has been read from \a fname. If evicted because of the memory budget it will be
+ * read again from there.
+ */
+void MEDCalculatorDBSliceField::setFieldFromFile(MEDCouplingFieldDouble *f, TypeOfField type, const std::string& fname,
+                                                 const std::string& mname, const std::string& fieldName) const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  setFieldUnderLock(f);
+  setSource(type,fname,mname,fieldName);
+  residentField();
+}
+
+/*!
+ * Attaches to this step, if not already fetched, the step #\a id of the background reading \a ra. The content is
+ * taken from \a ra when first needed.
+ */
+void MEDCalculatorDBSliceField::setReadAhead(MEDCalculatorDBReadAhead *ra, std::size_t id, TypeOfField type, const std::string& fname,
+                                             const std::string& mname, const std::string& fieldName) const
+{
+  MEDCalculatorDBMemoryBudgetLock lock;
+  if(_field || _skeleton || !_read_ahead.isNull())
     {
-      if(_field)
-        _field->decrRef();
-      _field=f;
+      ra->cancel(id);
+      return ;
     }
+  ra->incrRef();
+  _read_ahead=ra;
+  _read_ahead_id=id;
+  setSource(type,fname,mname,fieldName);
 }
 
 void MEDCalculatorDBSliceField::setName(const char *name)
 {
-  _field->setName(name);
+  MCAuto<MEDCouplingFieldDouble> f(pinField());
+  MEDCalculatorDBMemoryBudgetLock lock;
+  f->setName(name);
 }
 
 void MEDCalculatorDBSliceField::setDescription(const char *descr)
 {
-  _field->setDescription(descr);
+  MCAuto<MEDCouplingFieldDouble> f(pinField());
+  MEDCalculatorDBMemoryBudgetLock lock;
+  f->setDescription(descr);
 }
 
 void MEDCalculatorDBSliceField::write(const char *fName, const std::string& n, const std::string& d) const
 {
-  std::string kn=_field->getName();
-  std::string kd=_field->getDescription();
-  MEDCouplingFieldDouble *myF=const_cast<MEDCouplingFieldDouble *>(_field);
+  MCAuto<MEDCouplingFieldDouble> myF(pinField());
+  std::string kn=myF->getName();
+  std::string kd=myF->getDescription();
   myF->setName(n.c_str());
   myF->setDescription(d.c_str());
-  WriteFieldUsingAlreadyWrittenMesh(fName,_field);
+  {
+    MEDCalculatorDBIOGuard guard;
+    WriteFieldUsingAlreadyWrittenMesh(fName,myF);
+  }
   myF->setName(kn.c_str());
   myF->setDescription(kd.c_str());
 }
@@ -86,30 +331,326 @@ const MEDCouplingMesh *MEDCalculatorDBSliceField::getMesh(TypeOfField type, cons
 
 MEDCalculatorDBSliceField::~MEDCalculatorDBSliceField()
 {
+  MEDCalculatorDBMemoryBudgetLock lock;
+  MEDCalculatorDBMemoryBudget::Forget(this);
+  releaseSpill();
+  if(!_read_ahead.isNull())
+    _read_ahead->cancel(_read_ahead_id);
   if(_field)
     _field->decrRef();
+  if(_skeleton)
+    _skeleton->decrRef();
   if(_work)
     _work->decrRef();
 }
 
 MEDCouplingFieldDouble *MEDCalculatorDBSliceField::getField(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const
+{
+  takeReadAhead();
+  {
+    MEDCalculatorDBMemoryBudgetLock lock;
+    if(_field || _skeleton || !_read_ahead.isNull())
+      return residentField();
+  }
+  MEDCouplingFieldDouble *f=readField(type,fname,mname,fieldName);
+  MEDCalculatorDBMemoryBudgetLock lock;
+  if(!_field && !_skeleton)
+    {
+      _field=f;
+      setSource(type,fname,mname,fieldName);
+    }
+  else
+    f->decrRef();
+  return residentField();
+}
+
+/*!
+ * Reads the content of this step from file without storing it in \a this. The caller has the ownership of the returned field.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBSliceField::readField(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const
+{
+  MEDCalculatorDBIOGuard guard;
+  MCAuto<MEDCouplingField> tmpp(ReadField(type,fname.c_str(),mname.c_str(),0,fieldName.c_str(),_iteration,_order));
+  MCAuto<MEDCouplingFieldDouble> tmp(DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(tmpp));
+  return tmp.retn();
+}
+
+/*!
+ * Returns the content of this step, reloaded if it has been evicted, or null if it has never been fetched.
+ * The returned pointer is not protected against a later eviction : see pinField.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBSliceField::getFieldAttribute() const
+{
+  {
+    MEDCalculatorDBMemoryBudgetLock lock;
+    if(!_field && !_skeleton && !_has_src)
+      return 0;
+  }
+  MCAuto<MEDCouplingFieldDouble> ret(pinField());
+  return ret;
+}
+
+/*!
+ * Returns a new reference on the content of this step, reloaded if it has been evicted. As long as the returned
+ * reference is held the content can't be evicted. The source file is read without holding the memory budget lock.
+ */
+MCAuto<MEDCouplingFieldDouble> MEDCalculatorDBSliceField::pinField() const
+{
+  while(true)
+    {
+      takeReadAhead();
+      loadFromSource();
+      MEDCalculatorDBMemoryBudgetLock lock;
+      // evicted again by another thread meanwhile : read it again
+      if(!_field && !_skeleton && (_has_src || !_read_ahead.isNull()))
+        continue;
+      MCAuto<MEDCouplingFieldDouble> ret(residentField());
+      ret->incrRef();
+      return ret;
+    }
+}
+
+/*!
+ * Memory budget lock expected NOT to be held. If the content of this step has been evicted and has to be read again
+ * from its source file, reads it without the lock, so that the other steps can be used meanwhile, and stores it.
+ */
+void MEDCalculatorDBSliceField::loadFromSource() const
+{
+  TypeOfField type;
+  std::string fname,mname,fieldName;
+  {
+    MEDCalculatorDBMemoryBudgetLock lock;
+    if(_field || _skeleton || !_read_ahead.isNull() || !_has_src)
+      return ;
+    type=_src_type; fname=_src_file; mname=_src_mesh; fieldName=_src_field;
+  }
+  MEDCouplingFieldDouble *f=readField(type,fname,mname,fieldName);
+  MEDCalculatorDBMemoryBudgetLock lock;
+  if(!_field && !_skeleton && _read_ahead.isNull() && _has_src)
+    {
+      _field=f;
+      f=0;
+      MEDCalculatorDBMemoryBudget::NotifyReload();
+      residentField();
+    }
+  if(f)
+    f->decrRef();
+}
+
+/*!
+ * Memory budget lock expected to be held. Returns the content of this step, reloading it from the scratch file or
+ * from its source file if needed, after having put \a this in front of the LRU list of MEDCalculatorDBMemoryBudget.
+ * The reading from the source file is done by pinField before taking the lock, and only here as a last resort.
+ */
+MEDCouplingFieldDouble *MEDCalculatorDBSliceField::residentField() const
 {
   if(!_field)
     {
-      MCAuto<MEDCouplingField> tmpp(ReadField(type,fname.c_str(),mname.c_str(),0,fieldName.c_str(),_iteration,_order));
-      MCAuto<MEDCouplingFieldDouble> tmp(DynamicCast<MEDCouplingField,MEDCouplingFieldDouble>(tmpp));
-      _field=tmp.retn();
+      if(_skeleton)
+        {
+          MCAuto<DataArrayDouble> arr(DataArrayDouble::New());
+          arr->alloc(_spill_nb_of_tuples,_spill_infos.size());
+          MEDCalculatorDBMemoryBudget::Reload(_spill_offset,arr->getPointer(),arr->getNbOfElems());
+          arr->setName(_spill_name);
+          arr->setInfoOnComponents(_spill_infos);
+          _skeleton->setArray(arr);
+          _field=_skeleton;
+          _skeleton=0;
+          MEDCalculatorDBMemoryBudget::NotifyReload();
+        }
+      else if(!_read_ahead.isNull())
+        {
+          _field=_read_ahead->take(_read_ahead_id);
+          _read_ahead=0;
+          if(!_field)
+            _field=readField(_src_type,_src_file,_src_mesh,_src_field);
+        }
+      else if(_has_src)
+        {
+          _field=readField(_src_type,_src_file,_src_mesh,_src_field);
+          MEDCalculatorDBMemoryBudget::NotifyReload();
+        }
+      else
+        throw INTERP_KERNEL::Exception("MEDCalculatorDBSliceField : step not fetched !");
     }
+  const DataArrayDouble *arr(_field->getArray());
+  _mem_size=arr?arr->getNbOfElems()*sizeof(double):0;
+  MEDCalculatorDBMemoryBudget::Touch(this,_mem_size);
+  MEDCalculatorDBMemoryBudget::Enforce();
   return _field;
 }
 
 /*!
- * _field is expected to be already loaded !
+ * Memory budget lock expected NOT to be held. If the content of this step is being read in background, waits for it
+ * and stores it. Waiting here rather than in residentField lets the other steps be used meanwhile.
+ */
+void MEDCalculatorDBSliceField::takeReadAhead() const
+{
+  MCAuto<MEDCalculatorDBReadAhead> ra;
+  std::size_t id;
+  {
+    MEDCalculatorDBMemoryBudgetLock lock;
+    if(_read_ahead.isNull())
+      return ;
+    ra=_read_ahead;
+    id=_read_ahead_id;
+  }
+  MEDCouplingFieldDouble *f=ra->take(id);
+  MEDCalculatorDBMemoryBudgetLock lock;
+  if(_read_ahead==ra)
+    {
+      _read_ahead=0;
+      if(f && !_field && !_skeleton)
+        {
+          _field=f;
+          f=0;
+          residentField();
+        }
+    }
+  if(f)
+    f->decrRef();
+}
+
+/*!
+ * Memory budget lock expected to be held. Called by MEDCalculatorDBMemoryBudget::Enforce. Releases the content of this
+ * step if nobody else references it. If it can't be read again from its source file it is written in the scratch
+ * file first (only once as long as it is not modified), and \a spilled is set to true.
+ */
+bool MEDCalculatorDBSliceField::evict(bool& spilled) const
+{
+  spilled=false;
+  if(!_field || _field->getRCValue()>1)
+    return false;
+  if(_has_src && !_modified)
+    {
+      _field->decrRef();
+      _field=0;
+      return true;
+    }
+  const DataArrayDouble *arr(_field->getArray());
+  if(!arr || _field->getEndArray())
+    return false;
+  if(!_spill_valid)
+    {
+      _spill_offset=MEDCalculatorDBMemoryBudget::Spill(arr->begin(),arr->getNbOfElems());
+      _spill_valid=true;
+      spilled=true;
+    }
+  _spill_nb_of_tuples=arr->getNumberOfTuples();
+  _spill_infos=arr->getInfoOnComponents();
+  _spill_name=arr->getName();
+  _field->setArray(0);
+  _skeleton=_field;
+  _field=0;
+  return true;
+}
+
+/*!
+ * Memory budget lock expected to be held.
+ */
+void MEDCalculatorDBSliceField::setFieldUnderLock(MEDCouplingFieldDouble *f) const
+{
+  if(!_read_ahead.isNull())
+    {
+      _read_ahead->cancel(_read_ahead_id);
+      _read_ahead=0;
+    }
+  if(_skeleton)
+    {
+      _skeleton->decrRef();
+      _skeleton=0;
+    }
+  releaseSpill();
+  if(_field!=f)
+    {
+      if(_field)
+        _field->decrRef();
+      _field=f;
+    }
+}
+
+void MEDCalculatorDBSliceField::setSource(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const
+{
+  _has_src=true;
+  _src_type=type;
+  _src_file=fname;
+  _src_mesh=mname;
+  _src_field=fieldName;
+}
+
+/*!
+ * Called before any in place modification of the content of this step, that is returned (pinned). If it is also
+ * referenced elsewhere (by a deferred expression that has to see the values of this step as they were when it has
+ * been built) a private copy is done first.
+ */
+MCAuto<MEDCouplingFieldDouble> MEDCalculatorDBSliceField::prepareForModification()
+{
+  MCAuto<MEDCouplingFieldDouble> f(pinField());
+  MEDCalculatorDBMemoryBudgetLock lock;
+  // one reference held by this step and one by f
+  if(f->getRCValue()>2)
+    {
+      MCAuto<MEDCouplingFieldDouble> cpy(f->deepCopy());
+      setFieldUnderLock(cpy.retn());
+      f=residentField();
+      f->incrRef();
+    }
+  _modified=true;
+  releaseSpill();
+  return f;
+}
+
+/*!
+ * Memory budget lock expected to be held. The copy of this step in the scratch file is outdated : its region is given
+ * back to MEDCalculatorDBMemoryBudget.
  */
+void MEDCalculatorDBSliceField::releaseSpill() const
+{
+  if(_spill_valid)
+    MEDCalculatorDBMemoryBudget::Release(_spill_offset);
+  _spill_valid=false;
+}
+
 MEDCouplingFieldDouble *MEDCalculatorDBSliceField::getFieldWithoutQuestion(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  return _field->keepSelectedComponents(tIds);
+  return pinField()->keepSelectedComponents(tIds);
+}
+
+/*!
+ * Returns the components \a ids of the content of this step, to be used read only. If \a ids selects all the components
+ * in their order the content itself is returned (pinned), else a new field holding a copy of them.
+ */
+MCAuto<MEDCouplingFieldDouble> MEDCalculatorDBSliceField::selectComponents(const std::vector<std::size_t>& ids) const
+{
+  MCAuto<MEDCouplingFieldDouble> f(pinField());
+  const DataArrayDouble *arr(f->getArray());
+  bool whole(arr && arr->getNumberOfComponents()==ids.size());
+  for(std::size_t i=0;i<ids.size() && whole;i++)
+    whole=(ids[i]==i);
+  if(whole)
+    return f;
+  return MCAuto<MEDCouplingFieldDouble>(f->keepSelectedComponents(ids));
+}
+
+/*!
+ * Returns the components \a thisC of this step, to be used read only. If this step is not fetched its content is read
+ * from file and not kept in \a this : the caller holds the only reference on it.
+ */
+MCAuto<MEDCouplingFieldDouble> MEDCalculatorDBSliceField::readComponents(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                                                                         int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
+{
+  std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
+  if(isFetched())
+    return selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f(readField(type,fname,mname,fieldName));
+  const DataArrayDouble *arr(f->getArray());
+  bool whole(arr && arr->getNumberOfComponents()==tIds.size());
+  for(std::size_t i=0;i<tIds.size() && whole;i++)
+    whole=(tIds[i]==i);
+  if(whole)
+    return f;
+  return MCAuto<MEDCouplingFieldDouble>(f->keepSelectedComponents(tIds));
 }
 
 MEDCouplingFieldDouble *MEDCalculatorDBSliceField::buildCstFromThis(double val, int nbOfComp, const MEDCouplingFieldDouble *f) const
@@ -126,21 +667,71 @@ void MEDCalculatorDBSliceField::assign(const MEDCalculatorDBSliceField* other, i
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=other->_field->keepSelectedComponents(oIds);
-  _field->setSelectedComponents(f1,tIds);
+  MCAuto<MEDCouplingFieldDouble> src(other->pinField());
+  MCAuto<MEDCouplingFieldDouble> f(prepareForModification());
+  DataArrayDouble *arr(f->getArray());
+  ComponentsView v(src,oIds);
+  if(v.isValid() && arr && v.getNumberOfComponents()==tIds.size() && v.getNumberOfTuples()==arr->getNumberOfTuples())
+    {//the selected components of other are copied directly in place
+      std::size_t nbOfCompo(arr->getNumberOfComponents());
+      for(std::size_t k=0;k<tIds.size();k++)
+        if(tIds[k]>=nbOfCompo)
+          throw INTERP_KERNEL::Exception("Slice::assign : component id out of range !");
+      mcIdType nbOfTuples(arr->getNumberOfTuples());
+      double *pt(arr->getPointer());
+      for(mcIdType i=0;i<nbOfTuples;i++,pt+=nbOfCompo)
+        {
+          const double *t(v.getTuple(i));
+          for(std::size_t k=0;k<tIds.size();k++)
+            pt[tIds[k]]=t[v.getId(k)];
+        }
+      for(std::size_t k=0;k<tIds.size();k++)
+        arr->setInfoOnComponent(tIds[k],v.getInfoOnComponent(k));
+      arr->declareAsNew();
+    }
+  else
+    {
+      MCAuto<MEDCouplingFieldDouble> f1=src->keepSelectedComponents(oIds);
+      f->setSelectedComponents(f1,tIds);
+    }
+}
+
+/*!
+ * Puts \a f2, lying on a mesh geometrically equivalent to the one of \a f1, on the mesh of \a f1. \a cc and \a nc are the
+ * correspondences returned by checkGeoEquivalWith called on the mesh of \a f1 with the mesh of \a f2 : cell #i of the mesh
+ * of \a f2 is cell #cc[i] of the mesh of \a f1 (the same for nodes with \a nc). So, as in changeUnderlyingMesh, they are
+ * used as old2new arrays on \a f2 but without checking the meshes again. Null correspondences mean no permutation.
+ */
+void MEDCalculatorDBSliceField::PutOnSameSupport(const MEDCouplingFieldDouble *f1, MEDCouplingFieldDouble *f2, const DataArrayIdType *cc, const DataArrayIdType *nc)
+{
+  if(f2->getTypeOfField()==ON_NODES)
+    {
+      if(nc)
+        f2->renumberNodesWithoutMesh(nc->begin(),nc->getMaxValueInArray()+1);
+    }
+  else
+    {
+      if(cc)
+        f2->renumberCellsWithoutMesh(cc->begin(),false);
+    }
+  f2->setMesh(f1->getMesh());
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::add(const MEDCalculatorDBSliceField* other, const DataArrayIdType *cc, const DataArrayIdType *nc,
                                                     int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                                                     int sizeCOther, const MEDCalculatorDBRangeSelection& otherC) const
 {
-  if(cc!=0 || nc!=0)
-    throw INTERP_KERNEL::Exception("Slice::add : not implemented yet node/cell permutation !");
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  if(AreViewable(whole1,whole2,cc,nc))
+    {
+      MEDCouplingFieldDouble *f3=BinaryOnViews(whole1,tIds,whole2,oIds,std::plus<double>(),false);
+      if(f3)
+        return new MEDCalculatorDBSliceField(f3);
+    }
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),cc,nc);
   MEDCouplingFieldDouble *f3=(*f1)+(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
@@ -149,13 +740,17 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::substract(const MEDCalcula
                                                           int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                                                           int sizeCOther, const MEDCalculatorDBRangeSelection& otherC) const
 {
-  if(cc!=0 || nc!=0)
-    throw INTERP_KERNEL::Exception("Slice::substract : not implemented yet node/cell permutation !");
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  if(AreViewable(whole1,whole2,cc,nc))
+    {
+      MEDCouplingFieldDouble *f3=BinaryOnViews(whole1,tIds,whole2,oIds,std::minus<double>(),false);
+      if(f3)
+        return new MEDCalculatorDBSliceField(f3);
+    }
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),cc,nc);
   MEDCouplingFieldDouble *f3=(*f1)-(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
@@ -164,13 +759,17 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::multiply(const MEDCalculat
                                                          int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                                                          int sizeCOther, const MEDCalculatorDBRangeSelection& otherC) const
 {
-  if(cc!=0 || nc!=0)
-    throw INTERP_KERNEL::Exception("Slice::multiply : not implemented yet node/cell permutation !");
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  if(AreViewable(whole1,whole2,cc,nc))
+    {
+      MEDCouplingFieldDouble *f3=BinaryOnViews(whole1,tIds,whole2,oIds,std::multiplies<double>(),true);
+      if(f3)
+        return new MEDCalculatorDBSliceField(f3);
+    }
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),cc,nc);
   MEDCouplingFieldDouble *f3=(*f1)*(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
@@ -179,13 +778,17 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::divide(const MEDCalculator
                                                        int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                                                        int sizeCOther, const MEDCalculatorDBRangeSelection& otherC) const
 {
-  if(cc!=0 || nc!=0)
-    throw INTERP_KERNEL::Exception("Slice::divide : not implemented yet node/cell permutation !");
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  if(AreViewable(whole1,whole2,cc,nc))
+    {
+      MEDCouplingFieldDouble *f3=BinaryOnViews(whole1,tIds,whole2,oIds,std::divides<double>(),true);
+      if(f3)
+        return new MEDCalculatorDBSliceField(f3);
+    }
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),cc,nc);
   MEDCouplingFieldDouble *f3=(*f1)/(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
@@ -195,10 +798,13 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::dot(const MEDCalculatorDBS
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
-  MEDCouplingFieldDouble *f3=f1->dot(*f2);
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  MEDCouplingFieldDouble *f3=MEDCalculatorDBTensorKernels::Dot(whole1,tIds,whole2,oIds);
+  if(f3)
+    return new MEDCalculatorDBSliceField(f3);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),0,0);
+  f3=f1->dot(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
 
@@ -207,17 +813,20 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::crossProduct(const MEDCalc
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
-  MEDCouplingFieldDouble *f3=f1->crossProduct(*f2);
+  MCAuto<MEDCouplingFieldDouble> whole1(pinField()),whole2(other->pinField());
+  MEDCouplingFieldDouble *f3=MEDCalculatorDBTensorKernels::CrossProduct(whole1,tIds,whole2,oIds);
+  if(f3)
+    return new MEDCalculatorDBSliceField(f3);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),0,0);
+  f3=f1->crossProduct(*f2);
   return new MEDCalculatorDBSliceField(f3);
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::doublyContractedProduct(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
   MEDCouplingFieldDouble *f2=f1->doublyContractedProduct();
   return new MEDCalculatorDBSliceField(f2);
 }
@@ -225,7 +834,7 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::doublyContractedProduct(in
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::determinant(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
   MEDCouplingFieldDouble *f2=f1->determinant();
   return new MEDCalculatorDBSliceField(f2);
 }
@@ -233,23 +842,29 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::determinant(int sizeCThis,
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::eigenValues(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MEDCouplingFieldDouble *f2=f1->eigenValues();
+  MEDCouplingFieldDouble *f2=MEDCalculatorDBTensorKernels::EigenValues(pinField(),tIds);
+  if(f2)
+    return new MEDCalculatorDBSliceField(f2);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  f2=f1->eigenValues();
   return new MEDCalculatorDBSliceField(f2);
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::eigenVectors(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MEDCouplingFieldDouble *f2=f1->eigenVectors();
+  MEDCouplingFieldDouble *f2=MEDCalculatorDBTensorKernels::EigenVectors(pinField(),tIds);
+  if(f2)
+    return new MEDCalculatorDBSliceField(f2);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  f2=f1->eigenVectors();
   return new MEDCalculatorDBSliceField(f2);
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::inverse(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
   MEDCouplingFieldDouble *f2=f1->inverse();
   return new MEDCalculatorDBSliceField(f2);
 }
@@ -257,45 +872,93 @@ MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::inverse(int sizeCThis, con
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::trace(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MEDCouplingFieldDouble *f2=f1->trace();
+  MEDCouplingFieldDouble *f2=MEDCalculatorDBTensorKernels::Trace(pinField(),tIds);
+  if(f2)
+    return new MEDCalculatorDBSliceField(f2);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  f2=f1->trace();
   return new MEDCalculatorDBSliceField(f2);
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::deviator(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MEDCouplingFieldDouble *f2=f1->deviator();
+  MEDCouplingFieldDouble *f2=MEDCalculatorDBTensorKernels::Deviator(pinField(),tIds);
+  if(f2)
+    return new MEDCalculatorDBSliceField(f2);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  f2=f1->deviator();
   return new MEDCalculatorDBSliceField(f2);
 }
 
 MEDCalculatorDBSliceField *MEDCalculatorDBSliceField::magnitude(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MEDCouplingFieldDouble *f2=f1->magnitude();
+  MEDCouplingFieldDouble *f2=MEDCalculatorDBTensorKernels::Magnitude(pinField(),tIds);
+  if(f2)
+    return new MEDCalculatorDBSliceField(f2);
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  f2=f1->magnitude();
   return new MEDCalculatorDBSliceField(f2);
 }
 
-void MEDCalculatorDBSliceField::applyFunc(const char *func, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC)
+void MEDCalculatorDBSliceField::applyFunc(const MEDCalculatorDBCompiledExpr& func, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC)
 {
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  f1->applyFunc(func);
-  _field->setSelectedComponents(f1,tIds);
+  MCAuto<MEDCouplingFieldDouble> f1=pinField()->keepSelectedComponents(tIds);
+  func.apply(f1);
+  MCAuto<MEDCouplingFieldDouble> f(prepareForModification());
+  f->setSelectedComponents(f1,tIds);
+}
+
+/*!
+ * Replaces in place each selected component x by \a a * x + \a b. No field holding the constants is built.
+ */
+void MEDCalculatorDBSliceField::applyLin(double a, double b, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC)
+{
+  MCAuto<MEDCouplingFieldDouble> f(prepareForModification());
+  DataArrayDouble *arr(f->getArray());
+  if(thisC.isAll())
+    arr->applyLin(a,b);
+  else
+    {
+      std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
+      for(std::vector<std::size_t>::const_iterator it=tIds.begin();it!=tIds.end();it++)
+        arr->applyLin(a,b,*it);
+    }
 }
 
 bool MEDCalculatorDBSliceField::isEqual(const MEDCalculatorDBSliceField* other, const DataArrayIdType *cc, const DataArrayIdType *nc,
                                      int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                                      int sizeCOther, const MEDCalculatorDBRangeSelection& otherC, double prec) const
 {
-  if(cc!=0 || nc!=0)
-    throw INTERP_KERNEL::Exception("Slice::isEqual : not implemented yet node/cell permutation !");
   std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
   std::vector<std::size_t> oIds=otherC.getIds(sizeCOther);
-  MCAuto<MEDCouplingFieldDouble> f1=_field->keepSelectedComponents(tIds);
-  MCAuto<MEDCouplingFieldDouble> f2=other->_field->keepSelectedComponents(oIds);
-  f2->setMesh(f1->getMesh());
+  MCAuto<MEDCouplingFieldDouble> f1=selectComponents(tIds);
+  MCAuto<MEDCouplingFieldDouble> f2=OnSameSupport(f1,other->selectComponents(oIds),cc,nc);
   return f1->isEqualWithoutConsideringStr(f2,0,prec);
 }
+
+/*!
+ * Returns true if all the values of the selected components are equal to \a val with the precision \a prec.
+ */
+bool MEDCalculatorDBSliceField::isEqualToCst(double val, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC, double prec) const
+{
+  std::vector<std::size_t> tIds=thisC.getIds(sizeCThis);
+  MCAuto<MEDCouplingFieldDouble> f(pinField());
+  const DataArrayDouble *arr(f->getArray());
+  std::size_t nbOfCompo(arr->getNumberOfComponents());
+  mcIdType nbOfTuples(arr->getNumberOfTuples());
+  for(std::vector<std::size_t>::const_iterator it=tIds.begin();it!=tIds.end();it++)
+    if(*it>=nbOfCompo)
+      {
+        std::ostringstream oss; oss << "MEDCalculatorDBSliceField::isEqualToCst : invalid component id " << *it << " ! Must be in [0," << nbOfCompo << ") !";
+        throw INTERP_KERNEL::Exception(oss.str().c_str());
+      }
+  const double *pt(arr->begin());
+  for(mcIdType i=0;i<nbOfTuples;i++,pt+=nbOfCompo)
+    for(std::vector<std::size_t>::const_iterator it=tIds.begin();it!=tIds.end();it++)
+      if(fabs(pt[*it]-val)>prec)
+        return false;
+  return true;
+}
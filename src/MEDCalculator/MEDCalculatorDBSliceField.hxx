@@ -22,12 +22,15 @@
 #define __MEDCALCULATORDBSLICEFIELD_HXX__
 
 #include "MedCalculatorDefines.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
 #include "MCType.hxx"
 #include "MEDCouplingRefCountObject.hxx"
+#include "MCAuto.hxx"
 
 #include "InterpKernelException.hxx"
 
 #include <string>
+#include <vector>
 
 namespace MEDCoupling
 {
@@ -35,24 +38,40 @@ namespace MEDCoupling
   class MEDCouplingMesh;
   class DataArrayInt;
   class MEDCalculatorDBRangeSelection;
+  class MEDCalculatorDBCompiledExpr;
   
   class MEDCALCULATOR_EXPORT MEDCalculatorDBSliceField : public RefCountObject
   {
   public:
     MEDCalculatorDBSliceField(int iter, int order);
+    MEDCalculatorDBSliceField(int iter, int order, double time);
     MEDCalculatorDBSliceField(MEDCouplingFieldDouble *f);
     std::size_t getHeapMemorySizeWithoutChildren() const;
     std::vector<const BigMemoryObject *> getDirectChildrenWithNull() const;
-    bool isFetched() const { return _field!=0; }
+    bool isFetched() const;
+    bool isReadFromFile() const;
+    bool isModified() const { return _modified; }
+    const MEDCouplingFieldDouble *getKnownContent() const;
+    void takeReadAhead() const;
+    void shareMesh(const MEDCouplingMesh *m) const;
+    void putOnMesh(const MEDCouplingMesh *m) const;
+    std::size_t getMemorySize() const { return _mem_size; }
     void getDtIt(int& it, int& order) const { it=_iteration;  order=_order; }
+    double getTime() const;
     void setField(MEDCouplingFieldDouble *f) const;
+    void setFieldFromFile(MEDCouplingFieldDouble *f, TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
+    void setReadAhead(MEDCalculatorDBReadAhead *ra, std::size_t id, TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
     void setName(const char *name);
     void setDescription(const char *descr);
     void write(const char *fName, const std::string& n, const std::string& d) const;
     const MEDCouplingMesh *getMesh(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
     MEDCouplingFieldDouble *getField(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
+    MEDCouplingFieldDouble *readField(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
     MEDCouplingFieldDouble *getFieldWithoutQuestion(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const;
-    MEDCouplingFieldDouble *getFieldAttribute() const { return _field; }
+    MEDCouplingFieldDouble *getFieldAttribute() const;
+    MCAuto<MEDCouplingFieldDouble> pinField() const;
+    MCAuto<MEDCouplingFieldDouble> readComponents(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName,
+                                                  int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const;
     MEDCouplingFieldDouble *buildCstFromThis(double val, int nbOfComp, const MEDCouplingFieldDouble *m) const;
     //
     void assign(const MEDCalculatorDBSliceField* other, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
@@ -83,17 +102,50 @@ namespace MEDCoupling
     MEDCalculatorDBSliceField *trace(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const;
     MEDCalculatorDBSliceField *deviator(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const;
     MEDCalculatorDBSliceField *magnitude(int sizeCThis, const MEDCalculatorDBRangeSelection& thisC) const;
-    void applyFunc(const char *func, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC);
+    void applyFunc(const MEDCalculatorDBCompiledExpr& func, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC);
+    void applyLin(double a, double b, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC);
     bool isEqual(const MEDCalculatorDBSliceField* other, const DataArrayIdType *cc, const DataArrayIdType *nc,
                  int sizeCThis, const MEDCalculatorDBRangeSelection& thisC,
                  int sizeCOther, const MEDCalculatorDBRangeSelection& otherC, double prec) const;
+    bool isEqualToCst(double val, int sizeCThis, const MEDCalculatorDBRangeSelection& thisC, double prec) const;
+    static void PutOnSameSupport(const MEDCouplingFieldDouble *f1, MEDCouplingFieldDouble *f2, const DataArrayIdType *cc, const DataArrayIdType *nc);
   private:
+    friend class MEDCalculatorDBMemoryBudget;
     ~MEDCalculatorDBSliceField();
+    MCAuto<MEDCouplingFieldDouble> prepareForModification();
+    MCAuto<MEDCouplingFieldDouble> selectComponents(const std::vector<std::size_t>& ids) const;
+    MEDCouplingFieldDouble *residentField() const;
+    void loadFromSource() const;
+    void releaseSpill() const;
+    bool evict(bool& spilled) const;
+    void setFieldUnderLock(MEDCouplingFieldDouble *f) const;
+    void setSource(TypeOfField type, const std::string& fname, const std::string& mname, const std::string& fieldName) const;
   private:
     int _iteration;
     int _order;
+    //! time value known without the content (from the file metadata)
+    bool _has_time;
+    double _time;
     mutable MEDCouplingFieldDouble *_field;
     MEDCouplingFieldDouble *_work;
+    bool _modified;
+    //! where the content comes from, to read it again once evicted
+    mutable bool _has_src;
+    mutable TypeOfField _src_type;
+    mutable std::string _src_file;
+    mutable std::string _src_mesh;
+    mutable std::string _src_field;
+    mutable std::size_t _mem_size;
+    //! background reading of the content in progress, step #_read_ahead_id of _read_ahead
+    mutable MCAuto<MEDCalculatorDBReadAhead> _read_ahead;
+    mutable std::size_t _read_ahead_id;
+    //! the content without its array once spilled in the scratch file of MEDCalculatorDBMemoryBudget
+    mutable MEDCouplingFieldDouble *_skeleton;
+    mutable bool _spill_valid;
+    mutable Int64 _spill_offset;
+    mutable mcIdType _spill_nb_of_tuples;
+    mutable std::vector<std::string> _spill_infos;
+    mutable std::string _spill_name;
   };
 }
 
@@ -0,0 +1,182 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBStepsRunner.hxx"
+
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <exception>
+
+using namespace MEDCoupling;
+
+int MEDCalculatorDBStepsRunner::_nb_of_threads=1;
+
+int MEDCalculatorDBStepsRunner::_nb_of_busy_threads=0;
+
+int MEDCalculatorDBStepsRunner::_nb_of_concurrent_runs=0;
+
+pthread_mutex_t MEDCalculatorDBStepsRunner::_busy_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+pthread_mutex_t MEDCalculatorDBIOGuard::_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+namespace
+{
+  typedef struct
+  {
+    std::size_t nbOfSteps;
+    std::size_t next;
+    pthread_mutex_t mutex;
+    MEDCalculatorDBStepsRunner::StepFunc func;
+    void *ctx;
+    bool exception;
+    std::string msg;
+  } steps_st;
+
+  void *th_runsteps(void *s)
+  {
+    steps_st *st = (steps_st*)s;
+    while(true)
+      {
+        pthread_mutex_lock(&st->mutex);
+        std::size_t i=st->next++;
+        bool stop=st->exception || i>=st->nbOfSteps;
+        pthread_mutex_unlock(&st->mutex);
+        if(stop)
+          break;
+        try
+          {
+            st->func(i,st->ctx);
+          }
+        catch(std::exception& e)
+          {
+            pthread_mutex_lock(&st->mutex);
+            if(!st->exception)
+              st->msg=e.what();
+            st->exception=true;
+            pthread_mutex_unlock(&st->mutex);
+          }
+        catch(...)
+          {
+            pthread_mutex_lock(&st->mutex);
+            if(!st->exception)
+              st->msg="MEDCalculatorDBStepsRunner::Run : unknown exception in a step !";
+            st->exception=true;
+            pthread_mutex_unlock(&st->mutex);
+          }
+      }
+    return 0;
+  }
+}
+
+void MEDCalculatorDBStepsRunner::SetNumberOfThreads(int nbOfThreads)
+{
+  if(nbOfThreads<1)
+    throw INTERP_KERNEL::Exception("MEDCalculatorDBStepsRunner::SetNumberOfThreads : number of threads must be >= 1 !");
+  _nb_of_threads=nbOfThreads;
+}
+
+int MEDCalculatorDBStepsRunner::GetNumberOfThreads()
+{
+  return _nb_of_threads;
+}
+
+int MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns()
+{
+  pthread_mutex_lock(&_busy_mutex);
+  int ret(_nb_of_concurrent_runs);
+  pthread_mutex_unlock(&_busy_mutex);
+  return ret;
+}
+
+void MEDCalculatorDBStepsRunner::ResetStatistics()
+{
+  pthread_mutex_lock(&_busy_mutex);
+  _nb_of_concurrent_runs=0;
+  pthread_mutex_unlock(&_busy_mutex);
+}
+
+/*!
+ * Calls \a func for each step id in [0,\a nbOfSteps) and returns when all of them are done. The steps are dispatched
+ * one at a time to the threads. If a call throws, the remaining steps are not started and the first message is
+ * thrown again in the calling thread. If some threads can't be started, the calling thread runs steps with the ones
+ * that could.
+ * The threads started are taken from the ones not already used by the other runs in progress. If not \a concurrent the
+ * steps are run sequentially in the calling thread : the caller knows that they touch shared objects whose reference
+ * counts are not thread safe (a content used by several steps).
+ */
+void MEDCalculatorDBStepsRunner::Run(std::size_t nbOfSteps, StepFunc func, void *ctx, bool concurrent)
+{
+  std::size_t nbOfThreads=1;
+  if(nbOfSteps>1 && concurrent)
+    {
+      pthread_mutex_lock(&_busy_mutex);
+      nbOfThreads=std::min((std::size_t)std::max(_nb_of_threads-_nb_of_busy_threads,1),nbOfSteps);
+      _nb_of_busy_threads+=(int)nbOfThreads-1;
+      if(nbOfThreads>1)
+        _nb_of_concurrent_runs++;
+      pthread_mutex_unlock(&_busy_mutex);
+    }
+  if(nbOfThreads<=1)
+    {
+      for(std::size_t i=0;i<nbOfSteps;i++)
+        func(i,ctx);
+      return ;
+    }
+  steps_st st;
+  st.nbOfSteps=nbOfSteps;
+  st.next=0;
+  pthread_mutex_init(&st.mutex,NULL);
+  st.func=func;
+  st.ctx=ctx;
+  st.exception=false;
+  std::vector<pthread_t> th(nbOfThreads);
+  std::size_t nbOfStarted=0;
+  for(;nbOfStarted<nbOfThreads;nbOfStarted++)
+    if(pthread_create(&th[nbOfStarted],NULL,th_runsteps,(void*)&st)!=0)
+      break;
+  bool allStarted(nbOfStarted==nbOfThreads);
+  if(!allStarted)
+    {
+      // the calling thread takes the place of the threads that could not be started, the other ones are given back
+      pthread_mutex_lock(&_busy_mutex);
+      _nb_of_busy_threads-=(int)(nbOfThreads-1-nbOfStarted);
+      pthread_mutex_unlock(&_busy_mutex);
+      th_runsteps((void*)&st);
+    }
+  for(std::size_t i=0;i<nbOfStarted;i++)
+    pthread_join(th[i],NULL);
+  pthread_mutex_lock(&_busy_mutex);
+  _nb_of_busy_threads-=(int)(allStarted?nbOfThreads-1:nbOfStarted);
+  pthread_mutex_unlock(&_busy_mutex);
+  pthread_mutex_destroy(&st.mutex);
+  if(st.exception)
+    throw INTERP_KERNEL::Exception(st.msg.c_str());
+}
+
+MEDCalculatorDBIOGuard::MEDCalculatorDBIOGuard()
+{
+  pthread_mutex_lock(&_mutex);
+}
+
+MEDCalculatorDBIOGuard::~MEDCalculatorDBIOGuard()
+{
+  pthread_mutex_unlock(&_mutex);
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBSTEPSRUNNER_HXX__
+#define __MEDCALCULATORDBSTEPSRUNNER_HXX__
+
+#include "MedCalculatorDefines.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <cstddef>
+
+namespace MEDCoupling
+{
+  /*!
+   * Runs the independent per step computations of MEDCalculatorDBFieldReal on several threads.
+   * The number of threads is a process wide setting, 1 (sequential run in the calling thread) by default.
+   * It bounds all the runs in progress : a run started by a step of another one only uses the threads left idle.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBStepsRunner
+  {
+  public:
+    typedef void (*StepFunc)(std::size_t i, void *ctx);
+    static void SetNumberOfThreads(int nbOfThreads);
+    static int GetNumberOfThreads();
+    static void Run(std::size_t nbOfSteps, StepFunc func, void *ctx, bool concurrent=true);
+    static int GetNumberOfConcurrentRuns();
+    static void ResetStatistics();
+  private:
+    static int _nb_of_threads;
+    //! runs dispatched on more than one thread since the last ResetStatistics
+    static int _nb_of_concurrent_runs;
+    //! threads started by the runs in progress, in addition to their calling threads
+    static int _nb_of_busy_threads;
+    static pthread_mutex_t _busy_mutex;
+  };
+
+  /*!
+   * Serializes the accesses to MED files (MED file and HDF5 are not reentrant) issued by concurrent steps.
+   * The lock is held for the lifetime of the instance.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBIOGuard
+  {
+  public:
+    MEDCalculatorDBIOGuard();
+    ~MEDCalculatorDBIOGuard();
+  private:
+    static pthread_mutex_t _mutex;
+  };
+}
+
+#endif
@@ -0,0 +1,358 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorDBTensorKernels.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingMemArray.hxx"
+#include "MCAuto.hxx"
+
+#include "InterpolationUtils.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace MEDCoupling;
+
+const std::size_t MEDCalculatorDBTensorKernels::BLOCK_SIZE;
+
+const std::size_t MEDCalculatorDBTensorKernels::CHUNK_SIZE;
+
+namespace
+{
+  enum { OP_EIGENVALUES, OP_EIGENVECTORS, OP_TRACE, OP_DEVIATOR, OP_MAGNITUDE, OP_DOT, OP_CROSSPRODUCT };
+
+  //! names given by MEDCouplingFieldDouble to the results of the operations
+  const char *OP_NAMES[]={"EigenValues","EigenVectors","Trace","Deviator","Magnitude","",""};
+
+  typedef struct
+  {
+    int op;
+    const double *in1;
+    std::size_t stride1;
+    const std::vector<std::size_t> *ids1;
+    bool whole1;
+    const double *in2;
+    std::size_t stride2;
+    const std::vector<std::size_t> *ids2;
+    bool whole2;
+    std::size_t nbOfTuples;
+    double *out;
+    std::size_t nbOfCompoOut;
+  } tensor_st;
+
+  //! true if \a ids are all the components of an array with \a stride components, in their order
+  bool IsWhole(const std::vector<std::size_t>& ids, std::size_t stride)
+  {
+    if(ids.size()!=stride)
+      return false;
+    for(std::size_t k=0;k<ids.size();k++)
+      if(ids[k]!=k)
+        return false;
+    return true;
+  }
+
+  /*!
+   * Returns true if the components \a ids of the array of \a f can be read in place : a field with a mesh, one allocated
+   * array and valid component ids.
+   */
+  bool IsReadable(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+  {
+    if(!f->getMesh() || f->getTimeDiscretization()!=ONE_TIME || ids.empty())
+      return false;
+    const DataArrayDouble *arr(f->getArray());
+    if(!arr || !arr->isAllocated())
+      return false;
+    for(std::vector<std::size_t>::const_iterator it=ids.begin();it!=ids.end();it++)
+      if(*it>=arr->getNumberOfComponents())
+        return false;
+    return true;
+  }
+
+  /*!
+   * Returns the \a n tuples from \a start of the components \a ids of \a in. They are copied contiguously in \a buf
+   * unless \a whole : \a in is then read directly.
+   */
+  const double *Gather(const double *in, std::size_t stride, const std::vector<std::size_t>& ids, bool whole, std::size_t start, std::size_t n, double *buf)
+  {
+    const double *pt(in+start*stride);
+    if(whole)
+      return pt;
+    std::size_t nbOfCompo(ids.size());
+    for(std::size_t i=0;i<n;i++,pt+=stride)
+      for(std::size_t k=0;k<nbOfCompo;k++)
+        buf[i*nbOfCompo+k]=pt[ids[k]];
+    return buf;
+  }
+
+  void EigenVectors6(const double *in, std::size_t n, double *out)
+  {
+    for(std::size_t i=0;i<n;i++,in+=6)
+      {
+        double vals[3];
+        INTERP_KERNEL::computeEigenValues6(in,vals);
+        for(int j=0;j<3;j++,out+=3)
+          INTERP_KERNEL::computeEigenVectorForEigenValue6(in,vals[j],1e-4,out);
+      }
+  }
+
+  void Trace(const double *in, std::size_t nbOfCompo, std::size_t n, double *out)
+  {
+    switch(nbOfCompo)
+      {
+      case 6:
+        for(std::size_t i=0;i<n;i++)
+          out[i]=in[6*i]+in[6*i+1]+in[6*i+2];
+        break;
+      case 9:
+        for(std::size_t i=0;i<n;i++)
+          out[i]=in[9*i]+in[9*i+4]+in[9*i+8];
+        break;
+      default:
+        for(std::size_t i=0;i<n;i++)
+          out[i]=in[4*i]+in[4*i+3];
+      }
+  }
+
+  void Deviator6(const double *in, std::size_t n, double *out)
+  {
+    for(std::size_t i=0;i<n;i++)
+      {
+        double tr((in[6*i]+in[6*i+1]+in[6*i+2])/3.);
+        out[6*i]=in[6*i]-tr;
+        out[6*i+1]=in[6*i+1]-tr;
+        out[6*i+2]=in[6*i+2]-tr;
+        out[6*i+3]=in[6*i+3];
+        out[6*i+4]=in[6*i+4];
+        out[6*i+5]=in[6*i+5];
+      }
+  }
+
+  void Magnitude(const double *in, std::size_t nbOfCompo, std::size_t n, double *out)
+  {
+    for(std::size_t i=0;i<n;i++)
+      {
+        double sum(0.);
+        for(std::size_t k=0;k<nbOfCompo;k++)
+          sum+=in[i*nbOfCompo+k]*in[i*nbOfCompo+k];
+        out[i]=std::sqrt(sum);
+      }
+  }
+
+  void Dot(const double *in1, const double *in2, std::size_t nbOfCompo, std::size_t n, double *out)
+  {
+    for(std::size_t i=0;i<n;i++)
+      {
+        double sum(0.);
+        for(std::size_t k=0;k<nbOfCompo;k++)
+          sum+=in1[i*nbOfCompo+k]*in2[i*nbOfCompo+k];
+        out[i]=sum;
+      }
+  }
+
+  void CrossProduct(const double *in1, const double *in2, std::size_t n, double *out)
+  {
+    for(std::size_t i=0;i<n;i++)
+      {
+        out[3*i]=in1[3*i+1]*in2[3*i+2]-in1[3*i+2]*in2[3*i+1];
+        out[3*i+1]=in1[3*i+2]*in2[3*i]-in1[3*i]*in2[3*i+2];
+        out[3*i+2]=in1[3*i]*in2[3*i+1]-in1[3*i+1]*in2[3*i];
+      }
+  }
+
+  void TensorOnChunk(std::size_t chunkId, void *ctx)
+  {
+    const std::size_t BLOCK_SIZE(MEDCalculatorDBTensorKernels::BLOCK_SIZE);
+    tensor_st *st((tensor_st*)ctx);
+    std::size_t start(chunkId*MEDCalculatorDBTensorKernels::CHUNK_SIZE);
+    std::size_t end(std::min(start+MEDCalculatorDBTensorKernels::CHUNK_SIZE,st->nbOfTuples));
+    std::size_t nbOfCompo1(st->ids1->size()),nbOfCompo2(st->ids2?st->ids2->size():0);
+    std::vector<double> buf1(st->whole1?1:BLOCK_SIZE*nbOfCompo1),buf2(st->whole2?1:BLOCK_SIZE*nbOfCompo2);
+    for(std::size_t b=start;b<end;b+=BLOCK_SIZE)
+      {
+        std::size_t n(std::min(BLOCK_SIZE,end-b));
+        const double *t1(Gather(st->in1,st->stride1,*st->ids1,st->whole1,b,n,&buf1[0]));
+        const double *t2(st->ids2?Gather(st->in2,st->stride2,*st->ids2,st->whole2,b,n,&buf2[0]):0);
+        double *out(st->out+b*st->nbOfCompoOut);
+        switch(st->op)
+          {
+          case OP_EIGENVALUES:
+            MEDCalculatorDBTensorKernels::EigenValues6(t1,n,out);
+            break;
+          case OP_EIGENVECTORS:
+            EigenVectors6(t1,n,out);
+            break;
+          case OP_TRACE:
+            Trace(t1,nbOfCompo1,n,out);
+            break;
+          case OP_DEVIATOR:
+            Deviator6(t1,n,out);
+            break;
+          case OP_MAGNITUDE:
+            Magnitude(t1,nbOfCompo1,n,out);
+            break;
+          case OP_DOT:
+            Dot(t1,t2,nbOfCompo1,n,out);
+            break;
+          default:
+            CrossProduct(t1,t2,n,out);
+          }
+      }
+  }
+
+  /*!
+   * Computes \a op on the components \a ids1 of \a f1 (and \a ids2 of \a f2 for the binary ones) in a new array of
+   * \a nbOfCompoOut components, and returns it in a shallow copy of \a f1. The name, description, time and nature are
+   * those MEDCouplingFieldDouble gives to the result of the same operation.
+   */
+  MEDCouplingFieldDouble *RunOnTuples(int op, std::size_t nbOfCompoOut, const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                      const MEDCouplingFieldDouble *f2, const std::vector<std::size_t> *ids2)
+  {
+    tensor_st st;
+    st.op=op;
+    st.in1=f1->getArray()->begin();
+    st.stride1=f1->getArray()->getNumberOfComponents();
+    st.ids1=&ids1;
+    st.whole1=IsWhole(ids1,st.stride1);
+    st.in2=f2?f2->getArray()->begin():0;
+    st.stride2=f2?f2->getArray()->getNumberOfComponents():0;
+    st.ids2=ids2;
+    st.whole2=f2?IsWhole(*ids2,st.stride2):true;
+    st.nbOfTuples=f1->getArray()->getNumberOfTuples();
+    st.nbOfCompoOut=nbOfCompoOut;
+    MCAuto<DataArrayDouble> arr(DataArrayDouble::New());
+    arr->alloc(st.nbOfTuples,nbOfCompoOut);
+    st.out=arr->getPointer();
+    std::size_t nbOfChunks((st.nbOfTuples+MEDCalculatorDBTensorKernels::CHUNK_SIZE-1)/MEDCalculatorDBTensorKernels::CHUNK_SIZE);
+    MEDCalculatorDBStepsRunner::Run(nbOfChunks,TensorOnChunk,&st);
+    MCAuto<MEDCouplingFieldDouble> ret(f1->clone(false));
+    ret->setArray(arr);
+    ret->setName(OP_NAMES[op]);
+    ret->setDescription("");
+    if(op==OP_DOT || op==OP_CROSSPRODUCT)
+      ret->setNature(NoNature);
+    return ret.retn();
+  }
+
+  /*!
+   * Returns true if the binary operations can read \a f1 and \a f2 in place : same spatial discretization on cells
+   * or on nodes and same number of tuples. As in MEDCalculatorDBSliceField::PutOnSameSupport, \a f2 is taken on the
+   * mesh of \a f1.
+   */
+  bool AreReadable(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                   const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2)
+  {
+    if(!IsReadable(f1,ids1) || !IsReadable(f2,ids2))
+      return false;
+    if(f1->getTypeOfField()!=f2->getTypeOfField())
+      return false;
+    if(f1->getTypeOfField()!=ON_CELLS && f1->getTypeOfField()!=ON_NODES)
+      return false;
+    return f1->getArray()->getNumberOfTuples()==f2->getArray()->getNumberOfTuples();
+  }
+}
+
+/*!
+ * Eigen values of the \a nbOfTuples symmetric 3x3 tensors of \a in (components XX,YY,ZZ,XY,YZ,XZ) put in \a out,
+ * 3 per tuple in the order of INTERP_KERNEL::computeEigenValues6 : the largest, the smallest and the middle one.
+ * This is the same trigonometric solution : the invariants are computed by a first loop on a block of tuples,
+ * without branch, and the angles by a second one. The results are the same, NaN included for an isotropic tensor.
+ */
+void MEDCalculatorDBTensorKernels::EigenValues6(const double *in, std::size_t nbOfTuples, double *out)
+{
+  const double SQRT3(std::sqrt(3.));
+  double tr[BLOCK_SIZE],q[BLOCK_SIZE],sqp[BLOCK_SIZE],psqp[BLOCK_SIZE];
+  for(std::size_t start=0;start<nbOfTuples;start+=BLOCK_SIZE)
+    {
+      std::size_t n(std::min(BLOCK_SIZE,nbOfTuples-start));
+      const double *m(in+6*start);
+      for(std::size_t i=0;i<n;i++)
+        {
+          double t((m[6*i]+m[6*i+1]+m[6*i+2])/3.);
+          double k0(m[6*i]-t),k1(m[6*i+1]-t),k2(m[6*i+2]-t),k3(m[6*i+3]),k4(m[6*i+4]),k5(m[6*i+5]);
+          double p((k0*k0+k1*k1+k2*k2+2*(k3*k3+k4*k4+k5*k5))/6.);
+          tr[i]=t;
+          q[i]=(k0*k1*k2+2.*k4*k5*k3-k0*k4*k4-k2*k3*k3-k1*k5*k5)/2.;
+          sqp[i]=std::sqrt(p);
+          psqp[i]=p*sqp[i];
+        }
+      double *pt(out+3*start);
+      for(std::size_t i=0;i<n;i++,pt+=3)
+        {
+          double phi(std::fabs(q[i])<=std::fabs(psqp[i])?1./3.*std::acos(q[i]/psqp[i]):0.);
+          double c(std::cos(phi)),s(SQRT3*std::sin(phi));
+          pt[0]=tr[i]+2.*sqp[i]*c;
+          pt[1]=tr[i]-sqp[i]*(c+s);
+          pt[2]=tr[i]-sqp[i]*(c-s);
+        }
+    }
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::EigenValues(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+{
+  if(!IsReadable(f,ids) || ids.size()!=6)
+    return 0;
+  return RunOnTuples(OP_EIGENVALUES,3,f,ids,0,0);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::EigenVectors(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+{
+  if(!IsReadable(f,ids) || ids.size()!=6)
+    return 0;
+  return RunOnTuples(OP_EIGENVECTORS,9,f,ids,0,0);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::Trace(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+{
+  if(!IsReadable(f,ids) || (ids.size()!=4 && ids.size()!=6 && ids.size()!=9))
+    return 0;
+  return RunOnTuples(OP_TRACE,1,f,ids,0,0);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::Deviator(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+{
+  if(!IsReadable(f,ids) || ids.size()!=6)
+    return 0;
+  return RunOnTuples(OP_DEVIATOR,6,f,ids,0,0);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::Magnitude(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids)
+{
+  if(!IsReadable(f,ids))
+    return 0;
+  return RunOnTuples(OP_MAGNITUDE,1,f,ids,0,0);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::Dot(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                                          const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2)
+{
+  if(!AreReadable(f1,ids1,f2,ids2) || ids1.size()!=ids2.size())
+    return 0;
+  return RunOnTuples(OP_DOT,1,f1,ids1,f2,&ids2);
+}
+
+MEDCouplingFieldDouble *MEDCalculatorDBTensorKernels::CrossProduct(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                                                   const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2)
+{
+  if(!AreReadable(f1,ids1,f2,ids2) || ids1.size()!=3 || ids2.size()!=3)
+    return 0;
+  return RunOnTuples(OP_CROSSPRODUCT,3,f1,ids1,f2,&ids2);
+}
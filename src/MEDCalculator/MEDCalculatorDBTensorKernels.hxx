@@ -0,0 +1,63 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORDBTENSORKERNELS_HXX__
+#define __MEDCALCULATORDBTENSORKERNELS_HXX__
+
+#include "MedCalculatorDefines.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <cstddef>
+#include <vector>
+
+namespace MEDCoupling
+{
+  class MEDCouplingFieldDouble;
+
+  /*!
+   * Tensor and vector operations of MEDCalculatorDBSliceField computed on the selected components of the arrays
+   * read in place. The tuples are split in chunks run by MEDCalculatorDBStepsRunner, on the threads it leaves idle,
+   * and each chunk is processed by blocks of tuples. The symmetric 3x3 tensors (6 components) have their own kernels
+   * written as simple loops on the block that the compiler can vectorize.
+   * The values are those of the MEDCouplingFieldDouble methods. Each method returns null when the field cannot be
+   * read in place or when the numbers of components do not match : the caller then uses MEDCouplingFieldDouble, that
+   * throws the usual exceptions.
+   */
+  class MEDCALCULATOR_EXPORT MEDCalculatorDBTensorKernels
+  {
+  public:
+    static MEDCouplingFieldDouble *EigenValues(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids);
+    static MEDCouplingFieldDouble *EigenVectors(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids);
+    static MEDCouplingFieldDouble *Trace(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids);
+    static MEDCouplingFieldDouble *Deviator(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids);
+    static MEDCouplingFieldDouble *Magnitude(const MEDCouplingFieldDouble *f, const std::vector<std::size_t>& ids);
+    static MEDCouplingFieldDouble *Dot(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                       const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2);
+    static MEDCouplingFieldDouble *CrossProduct(const MEDCouplingFieldDouble *f1, const std::vector<std::size_t>& ids1,
+                                                const MEDCouplingFieldDouble *f2, const std::vector<std::size_t>& ids2);
+    static void EigenValues6(const double *in, std::size_t nbOfTuples, double *out);
+  public:
+    static const std::size_t BLOCK_SIZE=256;
+    static const std::size_t CHUNK_SIZE=16384;
+  };
+}
+
+#endif
@@ -29,6 +29,11 @@
 #include "MEDCalculatorBrowserLiteStruct.hxx"
 #include "MEDCalculatorBrowserField.hxx"
 #include "MEDCalculatorDBField.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+#include "MEDCalculatorDBMeshCorrespondences.hxx"
+#include "MEDCalculatorDBMemoryBudget.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
+#include "MEDCalculatorDBCompiledExpr.hxx"
 #include "MEDCalculatorTypemaps.i"
 
 using namespace MEDCoupling;
@@ -63,6 +68,7 @@ using namespace INTERP_KERNEL;
 %newobject MEDCoupling::MEDCalculatorDBFieldReal::trace;
 %newobject MEDCoupling::MEDCalculatorDBFieldReal::deviator;
 %newobject MEDCoupling::MEDCalculatorDBFieldReal::magnitude;
+%newobject MEDCoupling::MEDCalculatorDBFieldReal::reduceOverTime;
 
 %feature("unref") MEDCalculatorDBField "$this->decrRef();"
 
@@ -75,6 +81,56 @@ namespace MEDCoupling
     const MEDCalculatorBrowserField& getField(int) const;
   };
 
+  class MEDCalculatorDBStepsRunner
+  {
+  public:
+    static void SetNumberOfThreads(int nbOfThreads) throw(INTERP_KERNEL::Exception);
+    static int GetNumberOfThreads();
+    static int GetNumberOfConcurrentRuns();
+    static void ResetStatistics();
+  };
+
+  class MEDCalculatorDBMeshCorrespondences
+  {
+  public:
+    static void Clear();
+    static int GetNumberOfEntries();
+    static int GetNumberOfHits();
+    static int GetNumberOfMisses();
+  };
+
+  class MEDCalculatorDBMemoryBudget
+  {
+  public:
+    static void SetBudget(std::size_t nbOfBytes);
+    static std::size_t GetBudget();
+    static std::size_t GetMemoryInUse();
+    static int GetNumberOfResidentSteps();
+    static int GetNumberOfEvictions();
+    static int GetNumberOfSpills();
+    static int GetNumberOfReloads();
+    static std::size_t GetScratchFileSize();
+    static std::string GetStatistics();
+    static void ResetStatistics();
+  };
+
+  class MEDCalculatorDBReadAhead
+  {
+  public:
+    static void SetDepth(int depth) throw(INTERP_KERNEL::Exception);
+    static int GetDepth();
+    static int GetNumberOfHits();
+    static int GetNumberOfMisses();
+    static void ResetStatistics();
+  };
+
+  class MEDCalculatorDBCompiledExpr
+  {
+  public:
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+  };
+
   class MEDCalculatorDBField : public RefCountObject
     {
     public:
@@ -92,8 +148,18 @@ namespace MEDCoupling
   class MEDCalculatorDBFieldReal : public MEDCalculatorDBField
   {
   public:
+    enum TimeReduction
+      {
+        TIME_MEAN = 0,
+        TIME_MIN = 1,
+        TIME_MAX = 2,
+        TIME_RMS = 3,
+        TIME_INTEGRAL = 4,
+        TIME_ARGMAX = 5
+      };
     MEDCalculatorDBFieldReal(const MEDCalculatorBrowserField& ls);
     ~MEDCalculatorDBFieldReal();
+    static std::string GetMemorySummary();
     MEDCalculatorDBFieldReal *buildCstFieldFromThis(double val) const;
     MEDCoupling::TypeOfField getType() const;
     void fetchData() const throw(INTERP_KERNEL::Exception);
@@ -118,6 +184,7 @@ namespace MEDCoupling
     MEDCalculatorDBField *trace() const throw(INTERP_KERNEL::Exception);
     MEDCalculatorDBField *deviator() const throw(INTERP_KERNEL::Exception);
     MEDCalculatorDBField *magnitude() const throw(INTERP_KERNEL::Exception);
+    MEDCalculatorDBField *reduceOverTime(TimeReduction red) const throw(INTERP_KERNEL::Exception);
     %extend
        {
          MEDCalculatorDBField *__radd__(double val)
@@ -158,6 +158,28 @@ class MEDCalculatorBasicsTest(unittest.TestCase):
         Power[:,:,1:].eigenValues()
         Power[:]=0.07
         pass
+
+    def test3(self):
+        e=MEDCalculatorBrowserLiteStruct("hfile1.med")
+        f=e.getField(0)
+        Power=MEDCalculatorDBFieldReal(f)
+        ref=(Power[:,:,2:4]*2+Power[:,:,3:5]).getValues()
+        refMag=Power[:,:,0:3].magnitude().getValues()
+        self.assertEqual(1,MEDCalculatorDBStepsRunner.GetNumberOfThreads())
+        MEDCalculatorDBStepsRunner.SetNumberOfThreads(3)
+        MEDCalculatorDBStepsRunner.ResetStatistics()
+        try:
+            Power=MEDCalculatorDBFieldReal(f)
+            v=(Power[:,:,2:4]*2+Power[:,:,3:5]).getValues()
+            self.assertEqual(ref,v)
+            self.assertEqual(refMag,Power[:,:,0:3].magnitude().getValues())
+            # the steps read from file share their mesh : they are dispatched on the threads all the same
+            self.assertTrue(MEDCalculatorDBStepsRunner.GetNumberOfConcurrentRuns()>0)
+        finally:
+            MEDCalculatorDBStepsRunner.SetNumberOfThreads(1)
+            pass
+        self.assertRaises(Exception,MEDCalculatorDBStepsRunner.SetNumberOfThreads,0)
+        pass
     def setUp(self):
         pass
     pass
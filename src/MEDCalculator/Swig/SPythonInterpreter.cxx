@@ -24,6 +24,7 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
 
 using namespace MEDCoupling;
 
@@ -31,17 +32,104 @@ const char *SPythonInterpreter::INDENT_TOKEN[]={"def","class","for","if","while"
 
 const char SPythonInterpreter::NUMBERS[]="0123456789";
 
-SPythonInterpreter::SPythonInterpreter(PyObject *globals, PyObject *locals):_indent_must_change(false),_glob(globals),_loc(locals)
+/*!
+ * Python source of the function used by collectNames. It walks the syntax tree of the code given, so that it doesn't
+ * depend on the bytecode of the python version. Returns the names used by the code, the names it may rebind (assigned,
+ * deleted, imported, defined, declared global or nonlocal anywhere, or whose attributes or items are assigned or
+ * deleted) and whether it may rebind anything : use of exec, eval, globals... or call of a python function, not known here.
+ */
+const char SPythonInterpreter::NAMES_COLLECTOR[]=
+  "import ast,types\n"
+  "def _spython_collect_names(src,glob,loc):\n"
+  "    dyn=set(['exec','eval','compile','globals','locals','vars','setattr','delattr','__import__','__builtins__'])\n"
+  "    names=set(); bound=set(); rebindsAll=False\n"
+  "    for node in ast.walk(ast.parse(src)):\n"
+  "        if isinstance(node,ast.Name):\n"
+  "            names.add(node.id)\n"
+  "            if not isinstance(node.ctx,ast.Load): bound.add(node.id)\n"
+  "            obj=loc.get(node.id,glob.get(node.id))\n"
+  "            if node.id in dyn or isinstance(obj,types.FunctionType): rebindsAll=True\n"
+  "        elif isinstance(node,(ast.Attribute,ast.Subscript)):\n"
+  "            if isinstance(node,ast.Attribute) and node.attr in ('__dict__','__class__','__globals__'): rebindsAll=True\n"
+  "            if not isinstance(node.ctx,ast.Load):\n"
+  "                base=node.value\n"
+  "                while isinstance(base,(ast.Attribute,ast.Subscript)): base=base.value\n"
+  "                if isinstance(base,ast.Name): bound.add(base.id)\n"
+  "                else: rebindsAll=True\n"
+  "        elif isinstance(node,(ast.Global,ast.Nonlocal)):\n"
+  "            bound.update(node.names)\n"
+  "        elif isinstance(node,(ast.FunctionDef,ast.AsyncFunctionDef,ast.ClassDef)):\n"
+  "            bound.add(node.name)\n"
+  "        elif isinstance(node,(ast.Import,ast.ImportFrom)):\n"
+  "            for alias in node.names:\n"
+  "                if alias.name=='*': rebindsAll=True\n"
+  "                bound.add((alias.asname or alias.name).split('.')[0])\n"
+  "    return (tuple(names),tuple(bound),rebindsAll)\n";
+
+SPythonInterpreter::SPythonInterpreter(PyObject *globals, PyObject *locals):_indent_must_change(false),_glob(globals),_loc(locals),
+                                                                          _nb_of_parse_hits(0),_nb_of_parse_misses(0),_batch(false),_pending_code(0),_pending_rebinds_all(false),
+                                                                          _names_collector(0)
 {
   _indent_pos.insert(0);
 }
 
+SPythonInterpreter::~SPythonInterpreter()
+{
+  Py_XDECREF(_pending_code);
+  Py_XDECREF(_names_collector);
+}
+
 void SPythonInterpreter::initialize()
 {
   _indent_pos.clear();
   _indent_pos.insert(0);
   _indent_must_change=false;
   _cmd.clear();
+  _pending.clear();
+  Py_XDECREF(_pending_code);
+  _pending_code=0;
+  _pending_names.clear();
+  _pending_bound_names.clear();
+  _pending_rebinds_all=false;
+}
+
+/*!
+ * In batch mode the statements are not run one by one : they are gathered and run as a single Python code
+ * by flush (to be called at the end of the input). The gathered code is only run before its end when a
+ * statement to parse involves a variable that it may rebind, the parsing depending on the type of the variables.
+ * Leaving the batch mode flushes.
+ */
+void SPythonInterpreter::setBatch(bool batch)
+{
+  if(_batch && !batch)
+    {
+      finishSession();
+      flush();
+    }
+  _batch=batch;
+}
+
+/*!
+ * Runs the code gathered in batch mode. Returns false if there was none.
+ */
+bool SPythonInterpreter::flush()
+{
+  if(_pending.empty())
+    return false;
+  PyObject *res=0;
+  if(_pending_code)
+    res=PyEval_EvalCode(_pending_code,_glob,_loc);
+  else
+    res=PyRun_String(_pending.c_str(),Py_file_input,_glob,_loc);
+  _pending.clear();
+  Py_XDECREF(_pending_code);
+  _pending_code=0;
+  _pending_names.clear();
+  _pending_bound_names.clear();
+  _pending_rebinds_all=false;
+  checkPythonInterp(res);
+  Py_XDECREF(res);
+  return true;
 }
 
 bool SPythonInterpreter::run(const char *str, bool& isSPython)
@@ -96,6 +184,11 @@ bool SPythonInterpreter::finishSession()
   PyObject *res=0;
   if(_cmd.empty())
     return false;
+  if(_batch)
+    {
+      appendToPending();
+      return true;
+    }
   res=PyRun_String(_cmd.c_str(),Py_file_input,_glob,_loc);
   _cmd.clear();
   checkPythonInterp(res);
@@ -184,7 +277,29 @@ std::string SPythonInterpreter::strip(const std::string& s)
   return ret;
 }
 
+/*!
+ * Parses \a s, unless it was already parsed with the same types of variables, and runs the python
+ * translation if \a s is an SPython expression.
+ */
 bool SPythonInterpreter::isSPythonExpression(const std::string& s)
+{
+  if(_batch)
+    appendToPending();
+  parsed_st parsed;
+  analyze(s,parsed);
+  if(_batch && mayBeRebound(parsed.types))
+    {//the types have to be those after the gathered code
+      flush();
+      analyze(s,parsed);
+    }
+  if(!parsed.isSPython)
+    return false;
+  _cmd+=parsed.result+"\n";
+  finishSession();
+  return true;
+}
+
+bool SPythonInterpreter::parseSPythonExpression(const std::string& s, std::string& result)
 {
   std::string w(s);
   if(w.find("import ")!=std::string::npos)
@@ -202,16 +317,162 @@ bool SPythonInterpreter::isSPythonExpression(const std::string& s)
       std::size_t p=w.find(PRINT);
       w=w.substr(p+sizeof(PRINT)-sizeof(ENDPRINT)-1);
     }
-  std::string result;
   if(!isSPythonExpressionLev1(w,result))
     return false;
   if(isPrint)
     result=std::string(PRINT)+result;
-  _cmd+=result+"\n";
-  finishSession();
   return true;
 }
 
+void SPythonInterpreter::analyze(const std::string& s, parsed_st& parsed)
+{
+  std::map< std::string, std::vector<parsed_st> >::const_iterator it=_parsed.find(s);
+  if(it!=_parsed.end())
+    for(std::vector<parsed_st>::const_iterator it2=(*it).second.begin();it2!=(*it).second.end();it2++)
+      if(areTypesUnchanged((*it2).types))
+        {
+          parsed=*it2;
+          _nb_of_parse_hits++;
+          return ;
+        }
+  _nb_of_parse_misses++;
+  parsed.types.clear();
+  parsed.result.clear();
+  std::vector< std::pair<std::string,TypeOfEntity> > types;
+  SPythonPredParser::setTypesRecorder(&types);
+  try
+    {
+      parsed.isSPython=parseSPythonExpression(s,parsed.result);
+    }
+  catch(...)
+    {
+      SPythonPredParser::setTypesRecorder(0);
+      throw;
+    }
+  SPythonPredParser::setTypesRecorder(0);
+  // literals have a constant type
+  for(std::vector< std::pair<std::string,TypeOfEntity> >::const_iterator it2=types.begin();it2!=types.end();it2++)
+    if(!(*it2).first.empty() && (isalpha((unsigned char)(*it2).first[0]) || (*it2).first[0]=='_'))
+      if(std::find(parsed.types.begin(),parsed.types.end(),*it2)==parsed.types.end())
+        parsed.types.push_back(*it2);
+  if(_parsed.size()>=MAX_NB_OF_PARSED)
+    _parsed.clear();
+  _parsed[s].push_back(parsed);
+}
+
+bool SPythonInterpreter::areTypesUnchanged(const std::vector< std::pair<std::string,TypeOfEntity> >& types) const
+{
+  for(std::vector< std::pair<std::string,TypeOfEntity> >::const_iterator it=types.begin();it!=types.end();it++)
+    if(SPythonPredParser::getTypeOfVar((*it).first,_glob,_loc)!=(*it).second)
+      return false;
+  return true;
+}
+
+/*!
+ * Returns true if the code gathered in batch mode may change the type of one of the variables in \a types.
+ */
+bool SPythonInterpreter::mayBeRebound(const std::vector< std::pair<std::string,TypeOfEntity> >& types) const
+{
+  if(_pending.empty())
+    return false;
+  if(_pending_rebinds_all)
+    return true;
+  for(std::vector< std::pair<std::string,TypeOfEntity> >::const_iterator it=types.begin();it!=types.end();it++)
+    {
+      const std::string& var=(*it).first;
+      if(SPythonPredParser::isIdentifier(var))
+        {
+          if(_pending_bound_names.find(var)!=_pending_bound_names.end())
+            return true;
+          continue;
+        }
+      // var[i], var.attr... : changed by any use of var
+      std::size_t end=0;
+      while(end<var.length() && (isalnum((unsigned char)var[end]) || var[end]=='_'))
+        end++;
+      if(_pending_names.find(var.substr(0,end))!=_pending_names.end())
+        return true;
+    }
+  return false;
+}
+
+/*!
+ * Moves _cmd to the code gathered in batch mode, noting the names it uses. If _cmd is not valid python, the
+ * gathered code is run then _cmd alone, so that the error is reported as out of batch mode.
+ */
+void SPythonInterpreter::appendToPending()
+{
+  if(_cmd.empty())
+    return ;
+  PyObject *code=Py_CompileString(_cmd.c_str(),"<string>",Py_file_input);
+  if(!code)
+    {
+      PyErr_Clear();
+      flush();
+      PyObject *res=PyRun_String(_cmd.c_str(),Py_file_input,_glob,_loc);
+      _cmd.clear();
+      checkPythonInterp(res);
+      Py_XDECREF(res);
+      return ;
+    }
+  collectNames(_cmd);
+  if(_pending.empty())
+    _pending_code=code;
+  else
+    {
+      Py_DECREF(code);
+      Py_XDECREF(_pending_code);
+      _pending_code=0;
+    }
+  _pending+=_cmd;
+  _cmd.clear();
+}
+
+/*!
+ * Adds to _pending_names the names used by \a code (its nested functions and classes included), and to
+ * _pending_bound_names the names it may rebind. The analysis is done by NAMES_COLLECTOR on the syntax tree. If it
+ * fails, \a code is considered as rebinding anything.
+ */
+void SPythonInterpreter::collectNames(const std::string& code)
+{
+  if(!_names_collector)
+    {
+      PyObject *dict=PyDict_New();
+      PyDict_SetItemString(dict,"__builtins__",PyEval_GetBuiltins());
+      PyObject *res=PyRun_String(NAMES_COLLECTOR,Py_file_input,dict,dict);
+      Py_XDECREF(res);
+      _names_collector=PyDict_GetItemString(dict,"_spython_collect_names");
+      Py_XINCREF(_names_collector);
+      Py_DECREF(dict);
+    }
+  PyObject *ret=_names_collector?PyObject_CallFunction(_names_collector,"sOO",code.c_str(),_glob,_loc):0;
+  if(!ret || !PyTuple_Check(ret) || PyTuple_Size(ret)!=3)
+    {
+      _pending_rebinds_all=true;
+      Py_XDECREF(ret);
+      PyErr_Clear();
+      return ;
+    }
+  for(int i=0;i<2;i++)
+    {
+      PyObject *names=PyTuple_GetItem(ret,i);
+      std::set<std::string>& target(i==0?_pending_names:_pending_bound_names);
+      for(Py_ssize_t j=0;j<PyTuple_Size(names);j++)
+        {
+          const char *name=PyUnicode_AsUTF8(PyTuple_GetItem(names,j));
+          if(name)
+            target.insert(name);
+          else
+            _pending_rebinds_all=true;
+        }
+    }
+  if(PyObject_IsTrue(PyTuple_GetItem(ret,2)))
+    _pending_rebinds_all=true;
+  Py_DECREF(ret);
+  PyErr_Clear();
+}
+
+
 bool SPythonInterpreter::isSPythonExpressionLev1(const std::string& s, std::string& result)
 {
   std::string sst=strip(s);
@@ -33,10 +33,12 @@
 #include <Python.h>
 
 #include "MedCalculatorSPythonDefines.hxx"
+#include "SPythonParser.hxx"
 
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 
 namespace MEDCoupling
 {
@@ -44,15 +46,35 @@ namespace MEDCoupling
   {
   public:
     SPythonInterpreter(PyObject *globals, PyObject *locals);
+    ~SPythonInterpreter();
     void initialize();
     bool run(const char *str, bool& isSPython);
     bool finishSession();
+    void setBatch(bool batch);
+    bool isBatch() const { return _batch; }
+    bool flush();
+    std::size_t getNumberOfParseHits() const { return _nb_of_parse_hits; }
+    std::size_t getNumberOfParseMisses() const { return _nb_of_parse_misses; }
   private:
+    typedef struct
+    {
+      bool isSPython;
+      //! python statement to run when isSPython
+      std::string result;
+      //! variables looked up by the parsing, with their type at that time
+      std::vector< std::pair<std::string,TypeOfEntity> > types;
+    } parsed_st;
     bool checkIndentCoherency(const std::string& s, std::size_t p);
     void checkPythonInterp(PyObject *r);
     bool isIndenter(const std::string& s, std::size_t p);
     bool isSPythonExpression(const std::string& s);
+    bool parseSPythonExpression(const std::string& s, std::string& result);
     bool isSPythonExpressionLev1(const std::string& s, std::string& result);
+    void analyze(const std::string& s, parsed_st& parsed);
+    bool areTypesUnchanged(const std::vector< std::pair<std::string,TypeOfEntity> >& types) const;
+    bool mayBeRebound(const std::vector< std::pair<std::string,TypeOfEntity> >& types) const;
+    void appendToPending();
+    void collectNames(const std::string& code);
   public:
     static std::string strip(const std::string& s);
     static bool isSpythonManipulationNeeded(const std::string& s, std::string& pythonLines);
@@ -61,12 +83,31 @@ namespace MEDCoupling
     static const int NB_OF_INDENT=7;
     static const char *INDENT_TOKEN[];
     static const char NUMBERS[];
+    static const std::size_t MAX_NB_OF_PARSED=4096;
+    static const char NAMES_COLLECTOR[];
   private:
     std::string _cmd;
     std::set<int> _indent_pos;
     bool _indent_must_change;
     PyObject *_glob;
     PyObject *_loc;
+    //! parsings of the statements already seen, one per set of types of the variables involved
+    std::map< std::string, std::vector<parsed_st> > _parsed;
+    std::size_t _nb_of_parse_hits;
+    std::size_t _nb_of_parse_misses;
+    //! in batch mode the statements are gathered in _pending and run in one go by flush
+    bool _batch;
+    std::string _pending;
+    //! compiled _pending when it is made of a single piece, else 0
+    PyObject *_pending_code;
+    //! names used by _pending
+    std::set<std::string> _pending_names;
+    //! names that _pending binds
+    std::set<std::string> _pending_bound_names;
+    //! true if _pending calls a function that may rebind any name
+    bool _pending_rebinds_all;
+    //! python function analyzing the code gathered in batch mode, built from NAMES_COLLECTOR when first needed
+    PyObject *_names_collector;
   };
 }
 
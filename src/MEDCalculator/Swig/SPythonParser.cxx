@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <cctype>
 
 using namespace MEDCoupling;
 
@@ -31,6 +32,8 @@ const char SPythonPredParser::FIELD_TYPE_STR[]="MEDCalculatorDBField";
 
 const char SPythonParser::NUMBERS[]="0123456789";
 
+std::vector< std::pair<std::string,TypeOfEntity> > *SPythonPredParser::_types_recorder=0;
+
 #if PY_VERSION_HEX < 0x03050000
 static char*
 Py_EncodeLocale(const wchar_t *text, size_t *error_pos)
@@ -447,12 +450,96 @@ bool SPythonPredParser::empty() const
 }
 
 TypeOfEntity SPythonPredParser::getTypeOfVar(const std::string& var, PyObject *glob, PyObject *loc)
+{
+  TypeOfEntity ret=isIdentifier(var)?getTypeOfIdentifier(var,glob,loc):getTypeOfExpression(var,glob,loc);
+  if(_types_recorder)
+    _types_recorder->push_back(std::pair<std::string,TypeOfEntity>(var,ret));
+  return ret;
+}
+
+/*!
+ * Sets the vector receiving the variables looked up by getTypeOfVar with their type, 0 to stop recording.
+ * The result of a parsing only depends on the statement and on these types.
+ */
+void SPythonPredParser::setTypesRecorder(std::vector< std::pair<std::string,TypeOfEntity> > *recorder)
+{
+  _types_recorder=recorder;
+}
+
+bool SPythonPredParser::isIdentifier(const std::string& s)
+{
+  if(s.empty() || (!isalpha((unsigned char)s[0]) && s[0]!='_'))
+    return false;
+  for(std::string::const_iterator it=s.begin();it!=s.end();it++)
+    if(!isalnum((unsigned char)*it) && *it!='_')
+      return false;
+  return true;
+}
+
+/*!
+ * Same result as getTypeOfExpression, without compiling anything : \a var is looked up as Python does for a name.
+ */
+TypeOfEntity SPythonPredParser::getTypeOfIdentifier(const std::string& var, PyObject *glob, PyObject *loc)
+{
+  PyObject *obj=lookUp(var.c_str(),glob,loc);
+  PyObject *cls=lookUp(FIELD_TYPE_STR,glob,loc);
+  if(!obj || !cls)
+    return UNKNOWN_TYPE;
+  int isInst=PyObject_IsInstance(obj,cls);
+  if(isInst<0)
+    {
+      PyErr_Clear();
+      return UNKNOWN_TYPE;
+    }
+  if(isInst)
+    return FIELDDB_TYPE;
+  PyObject *name=PyObject_GetAttrString((PyObject *)Py_TYPE(obj),"__name__");
+  if(!name)
+    {
+      PyErr_Clear();
+      return UNKNOWN_TYPE;
+    }
+  const char *type=PyUnicode_Check(name)?PyUnicode_AsUTF8(name):0;
+  std::string typecpp(type?type:"");
+  Py_DECREF(name);
+  if(typecpp=="function")
+    return FUNC_TYPE;
+  if(typecpp=="int")
+    return INT_TYPE;
+  if(typecpp=="float")
+    return FLOAT_TYPE;
+  return UNKNOWN_TYPE;
+}
+
+/*!
+ * Returns a borrowed reference on the object bound to \a name in \a loc, \a glob or the builtins, 0 if none.
+ */
+PyObject *SPythonPredParser::lookUp(const char *name, PyObject *glob, PyObject *loc)
+{
+  PyObject *ret=loc?PyDict_GetItemString(loc,name):0;
+  if(!ret)
+    ret=PyDict_GetItemString(glob,name);
+  if(!ret)
+    {
+      PyObject *builtins=PyDict_GetItemString(glob,"__builtins__");
+      if(builtins && PyModule_Check(builtins))
+        builtins=PyModule_GetDict(builtins);
+      if(builtins && PyDict_Check(builtins))
+        ret=PyDict_GetItemString(builtins,name);
+    }
+  return ret;
+}
+
+TypeOfEntity SPythonPredParser::getTypeOfExpression(const std::string& var, PyObject *glob, PyObject *loc)
 {
   static const char TMPVAR[]="tmpvvr37911022";
   std::ostringstream oss; oss << TMPVAR << "=isinstance(" << var << "," << FIELD_TYPE_STR << ")";
   PyObject *res=PyRun_String(oss.str().c_str(),Py_single_input,glob,loc);
   if(res==0)
-    return UNKNOWN_TYPE;
+    {
+      PyErr_Clear();
+      return UNKNOWN_TYPE;
+    }
   if(PyDict_GetItemString(glob,TMPVAR)==Py_True)
     return FIELDDB_TYPE;
   oss.str(std::string(TMPVAR));
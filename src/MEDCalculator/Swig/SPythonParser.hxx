@@ -61,12 +61,20 @@ namespace MEDCoupling
     std::string getRepr() const;
     bool empty() const;
     static TypeOfEntity getTypeOfVar(const std::string& var, PyObject *glob, PyObject *loc);
+    static void setTypesRecorder(std::vector< std::pair<std::string,TypeOfEntity> > *recorder);
+    static bool isIdentifier(const std::string& s);
+  private:
+    static TypeOfEntity getTypeOfIdentifier(const std::string& var, PyObject *glob, PyObject *loc);
+    static TypeOfEntity getTypeOfExpression(const std::string& var, PyObject *glob, PyObject *loc);
+    static PyObject *lookUp(const char *name, PyObject *glob, PyObject *loc);
   public:
     static const char FIELD_TYPE_STR[];
   private:
     std::string _var;
     std::string _method;
     TypeOfEntity _type;
+    //! if not null, receives the type of each variable looked up by getTypeOfVar
+    static std::vector< std::pair<std::string,TypeOfEntity> > *_types_recorder;
   };
 
   /*!
@@ -26,15 +26,21 @@
 #include <fstream>
 #include <float.h>
 #include <limits>
+#include <string>
 
 static const int MAX_LINE=1024;
 
-void runInFileAndQuit(PyObject *glob, PyObject *loc, const char *fileName)
+/*!
+ * In batch mode (-b option) the file is run as a single python code, only split where an SPython
+ * statement needs the type of a variable set by the code before it.
+ */
+void runInFileAndQuit(PyObject *glob, PyObject *loc, const char *fileName, bool batch)
 {
   std::ifstream ifs(fileName);
   ifs.exceptions( std::ifstream::badbit );
   char *line=new char[MAX_LINE+1];
   MEDCoupling::SPythonInterpreter interp(glob,loc);
+  interp.setBatch(batch);
   bool isspython;
   while(!ifs.eof())
     {
@@ -42,6 +48,7 @@ void runInFileAndQuit(PyObject *glob, PyObject *loc, const char *fileName)
       interp.run(line,isspython);
     }
   interp.finishSession();
+  interp.flush();
   delete [] line;
 }
 
@@ -97,7 +104,15 @@ int main(int argc, char *argv[])
   switch(argc)
     {
     case 2:
-      runInFileAndQuit(globals,globals,argv[1]);
+      runInFileAndQuit(globals,globals,argv[1],false);
+      break;
+    case 3:
+      if(std::string(argv[1])!="-b")
+        {
+          std::cerr << "Invalid usage of spython !" << std::endl;
+          return 1;
+        }
+      runInFileAndQuit(globals,globals,argv[2],true);
       break;
     case 1:
       runInInteractiveMode(globals,globals);
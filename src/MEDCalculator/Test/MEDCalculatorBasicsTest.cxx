@@ -22,6 +22,12 @@
 #include "MEDCalculatorBrowserLiteStruct.hxx"
 #include "MEDCalculatorDBRangeSelection.hxx"
 #include "MEDCalculatorDBField.hxx"
+#include "MEDCalculatorDBMeshCorrespondences.hxx"
+#include "MEDCalculatorDBMemoryBudget.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
+#include "MEDCalculatorDBCompiledExpr.hxx"
+#include "MEDCalculatorDBTensorKernels.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
 
 #include "SPythonParser.hxx"
 #include "SPythonInterpreter.hxx"
@@ -30,9 +36,15 @@
 
 #include "MEDCouplingMemArray.hxx"
 #include "MEDCouplingUMesh.hxx"
+#include "MEDCouplingCMesh.hxx"
 #include "MEDCouplingFieldDouble.hxx"
+#include "MCAuto.hxx"
 
+#include "InterpolationUtils.hxx"
+
+#include <algorithm>
 #include <iostream>
+#include <cmath>
 
 void MEDCoupling::MEDCalculatorBasicsTest::testLightStruct1()
 {
@@ -42,6 +54,35 @@ void MEDCoupling::MEDCalculatorBasicsTest::testLightStruct1()
   //std::cout << lt.str() << std::endl;
 }
 
+void MEDCoupling::MEDCalculatorBasicsTest::testLightStruct2()
+{
+  // browse tree built from the MED metadata only
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  CPPUNIT_ASSERT_EQUAL(1,(int)lt.getNumberOfMeshes());
+  CPPUNIT_ASSERT_EQUAL(std::string("AMesh"),lt.getMeshName(0));
+  CPPUNIT_ASSERT_EQUAL(1,(int)lt.getNumberOfFields());
+  const MEDCalculatorBrowserField& f=lt.getField(0);
+  CPPUNIT_ASSERT_EQUAL(std::string("Power"),f.getName());
+  CPPUNIT_ASSERT(f.getType()==ON_CELLS);
+  CPPUNIT_ASSERT_EQUAL(7,(int)f.getComponentsSize());
+  CPPUNIT_ASSERT_EQUAL(std::string("aaa [a]"),f.getComponents()[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("ggg [g]"),f.getComponents()[6]);
+  CPPUNIT_ASSERT_EQUAL(10,(int)f.getStepsSize());
+  CPPUNIT_ASSERT_EQUAL(3,f.getSteps()[3].getTimeStep());
+  CPPUNIT_ASSERT_EQUAL(-3,f.getSteps()[3].getOrder());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3,f.getSteps()[3].getTimeValue(),1e-14);
+  CPPUNIT_ASSERT_EQUAL(std::string("AMesh"),f.getCorrespondingMeshesFromField()[0]);
+  // same type and meshes as the MEDLoader queries
+  CPPUNIT_ASSERT(GetMeshNamesOnField(fName,"Power")==f.getCorrespondingMeshesFromField());
+  CPPUNIT_ASSERT(GetTypesOfField(fName,"AMesh","Power")[0]==f.getType());
+  // same tree as the field read alone
+  MEDCalculatorBrowserField f2(fName,"Power");
+  CPPUNIT_ASSERT(f2.getComponents()==f.getComponents());
+  CPPUNIT_ASSERT_EQUAL(f.getStepsSize(),f2.getStepsSize());
+}
+
 void MEDCoupling::MEDCalculatorBasicsTest::testRangeSelection1()
 {
   MEDCalculatorDBRangeSelection sel1(":");
@@ -108,7 +149,604 @@ void MEDCoupling::MEDCalculatorBasicsTest::testDBField1()
   Power->decrRef();
 }
 
-void MEDCoupling::MEDCalculatorBasicsTest::generateAFile1(const char *fName)
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldDeferred1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt.getField(0));
+  // eager reference of a*2+b/a-b
+  MCAuto<MEDCalculatorDBFieldReal> two=a->buildCstFieldFromThis(2.);
+  MCAuto<MEDCalculatorDBField> e1=a->multiply(*two);
+  MCAuto<MEDCalculatorDBField> e2=b->divide(*a);
+  MCAuto<MEDCalculatorDBField> e3=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)e1)->add(*static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)e2));
+  MCAuto<MEDCalculatorDBField> eager=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)e3)->substract(*b);
+  // same expression, deferred
+  MCAuto<MEDCalculatorDBFieldCst> cst2=new MEDCalculatorDBFieldCst(2.);
+  MCAuto<MEDCalculatorDBField> l1=(*a)*(*cst2);
+  MCAuto<MEDCalculatorDBField> l2=(*b)/(*a);
+  MCAuto<MEDCalculatorDBField> l3=(*l1)+(*l2);
+  MCAuto<MEDCalculatorDBField> lazy=(*l3)-(*b);
+  MEDCalculatorDBFieldReal *lazyr=dynamic_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)lazy);
+  CPPUNIT_ASSERT(lazyr);
+  CPPUNIT_ASSERT(lazyr->isDeferred());
+  CPPUNIT_ASSERT_EQUAL(10,lazyr->getNumberOfSteps());
+  CPPUNIT_ASSERT_EQUAL(0,lazyr->getNumberOfFetchedSteps());
+  CPPUNIT_ASSERT_EQUAL(7,lazyr->getNumberOfComponents());
+  // operands modified in place after the expression has been built must not change its result
+  a->applyFunc("x+1000.");
+  CPPUNIT_ASSERT(lazyr->isEqual(*eager,1e-12,1e-12));
+  CPPUNIT_ASSERT(!lazyr->isDeferred());
+  CPPUNIT_ASSERT_EQUAL(10,lazyr->getNumberOfFetchedSteps());
+  // scalar on the left
+  MCAuto<MEDCalculatorDBFieldCst> cst=new MEDCalculatorDBFieldCst(3.);
+  MCAuto<MEDCalculatorDBField> l4=(*cst)-(*b);
+  MCAuto<MEDCalculatorDBFieldReal> three=b->buildCstFieldFromThis(3.);
+  MCAuto<MEDCalculatorDBField> e4=three->substract(*b);
+  CPPUNIT_ASSERT(l4->isEqual(*e4,1e-12,1e-12));
+  // file operands are read step by step, not fetched, and the steps of the result keep the times of the operand
+  MCAuto<MEDCalculatorDBFieldReal> c=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBField> l5=(*c)*(*cst2);
+  std::vector<MEDCouplingFieldDouble *> fs=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)l5)->getFields();
+  CPPUNIT_ASSERT_EQUAL(0,c->getNumberOfFetchedSteps());
+  CPPUNIT_ASSERT_EQUAL(10,(int)fs.size());
+  int it,order;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3,fs[3]->getTime(it,order),1e-12);
+  CPPUNIT_ASSERT_EQUAL(3,it);
+  CPPUNIT_ASSERT_EQUAL(-3,order);
+  CPPUNIT_ASSERT(fs[3]->getMesh()==fs[7]->getMesh());
+  for(std::vector<MEDCouplingFieldDouble *>::iterator iter=fs.begin();iter!=fs.end();iter++)
+    (*iter)->decrRef();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldPermutation1()
+{
+  const char fName1[]="hfile1.med";
+  const char fName2[]="hfile2.med";
+  const mcIdType old2New[5]={2,0,4,1,3};
+  generateAFile1(fName1);
+  generateAFile1(fName2,old2New);
+  MEDCalculatorBrowserLiteStruct lt1(fName1),lt2(fName2);
+  lt1.selectAllFields();
+  lt2.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt1.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt2.getField(0));
+  MEDCalculatorDBMeshCorrespondences::Clear();
+  // same values on meshes equal up to a cell permutation
+  MCAuto<MEDCalculatorDBFieldReal> two=a->buildCstFieldFromThis(2.);
+  MCAuto<MEDCalculatorDBField> ref=a->multiply(*two);
+  MCAuto<MEDCalculatorDBField> e1=a->add(*b);
+  CPPUNIT_ASSERT(e1->isEqual(*ref,1e-12,1e-12));
+  CPPUNIT_ASSERT_EQUAL(1,MEDCalculatorDBMeshCorrespondences::GetNumberOfEntries());
+  MCAuto<MEDCalculatorDBField> e2=a->substract(*b);
+  CPPUNIT_ASSERT_EQUAL(1,MEDCalculatorDBMeshCorrespondences::GetNumberOfEntries());
+  MCAuto<MEDCalculatorDBField> zero=a->substract(*a);
+  CPPUNIT_ASSERT(e2->isEqual(*zero,1e-12,1e-12));
+  // deferred path
+  MCAuto<MEDCalculatorDBField> l1=(*a)+(*b);
+  CPPUNIT_ASSERT(l1->isEqual(*ref,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBField> l2=(*b)*(*a);
+  MCAuto<MEDCalculatorDBField> l3=b->multiply(*b);
+  CPPUNIT_ASSERT(l2->isEqual(*l3,1e-12,1e-12));
+  MEDCalculatorDBMeshCorrespondences::Clear();
+  CPPUNIT_ASSERT_EQUAL(0,MEDCalculatorDBMeshCorrespondences::GetNumberOfEntries());
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testMeshCorrespondences1()
+{
+  const char fName[]="hfile1.med";
+  const mcIdType old2New[5]={2,0,4,1,3};
+  const mcIdType new2Old[5]={1,3,0,4,2};
+  generateAFile1(fName);
+  MCAuto<MEDCouplingUMesh> m1=ReadUMeshFromFile(fName,"AMesh",0);
+  MCAuto<MEDCouplingUMesh> m2=m1->deepCopy();
+  m2->renumberCells(old2New,true);
+  MEDCalculatorDBMeshCorrespondences::Clear();
+  DataArrayIdType *cc(0),*nc(0);
+  for(int i=0;i<3;i++)
+    {
+      MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(m1,m2,1,1e-12,cc,nc);
+      MCAuto<DataArrayIdType> ccSafe(cc),ncSafe(nc);
+      CPPUNIT_ASSERT(cc);
+      CPPUNIT_ASSERT(std::equal(new2Old,new2Old+5,cc->begin()));//cell #i of m2 is cell #cc[i] of m1
+    }
+  CPPUNIT_ASSERT_EQUAL(1,MEDCalculatorDBMeshCorrespondences::GetNumberOfMisses());
+  CPPUNIT_ASSERT_EQUAL(2,MEDCalculatorDBMeshCorrespondences::GetNumberOfHits());
+  // m2 modified : the entry is recomputed and the negative result is cached too
+  double vec[2]={1.,0.};
+  m2->translate(vec);
+  CPPUNIT_ASSERT_THROW(MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(m1,m2,1,1e-12,cc,nc),INTERP_KERNEL::Exception);
+  CPPUNIT_ASSERT_EQUAL(2,MEDCalculatorDBMeshCorrespondences::GetNumberOfMisses());
+  CPPUNIT_ASSERT_THROW(MEDCalculatorDBMeshCorrespondences::CheckGeoEquivalWith(m1,m2,1,1e-12,cc,nc),INTERP_KERNEL::Exception);
+  CPPUNIT_ASSERT_EQUAL(2,MEDCalculatorDBMeshCorrespondences::GetNumberOfMisses());
+  CPPUNIT_ASSERT_EQUAL(3,MEDCalculatorDBMeshCorrespondences::GetNumberOfHits());
+  CPPUNIT_ASSERT_EQUAL(1,MEDCalculatorDBMeshCorrespondences::GetNumberOfEntries());
+  // the cache doesn't keep the meshes alive
+  CPPUNIT_ASSERT_EQUAL(1,m1->getRCValue());
+  CPPUNIT_ASSERT_EQUAL(1,m2->getRCValue());
+  MEDCalculatorDBMeshCorrespondences::Clear();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldMemoryBudget1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  const std::size_t stepSize=5*7*sizeof(double);
+  MCAuto<MEDCalculatorDBFieldReal> ref;
+  {
+    MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+    MCAuto<MEDCalculatorDBFieldReal> two=a->buildCstFieldFromThis(2.);
+    ref=static_cast<MEDCalculatorDBFieldReal *>(a->multiply(*two));
+  }
+  // same computation with room for 3 steps out of 10 per field
+  MEDCalculatorDBMemoryBudget::ResetStatistics();
+  MEDCalculatorDBMemoryBudget::SetBudget(3*stepSize);
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> two=a->buildCstFieldFromThis(2.);
+  MCAuto<MEDCalculatorDBField> res=a->multiply(*two);
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetMemoryInUse()<=3*stepSize);
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetNumberOfEvictions()>0);
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetNumberOfSpills()>0);
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetScratchFileSize()>=stepSize);
+  // evicted steps (read again from hfile1.med) and spilled ones (reloaded from the scratch file) are transparent
+  CPPUNIT_ASSERT(res->isEqual(*ref,1e-12,1e-12));
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetNumberOfReloads()>0);
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetMemoryInUse()<=3*stepSize);
+  // steps modified in place are spilled, not read again from the file
+  a->applyFunc("x+1.");
+  MCAuto<MEDCalculatorDBFieldReal> c=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldCst> one=new MEDCalculatorDBFieldCst(1.);
+  MCAuto<MEDCalculatorDBField> cp1=(*c)+(*one);
+  CPPUNIT_ASSERT(a->isEqual(*cp1,1e-12,1e-12));
+  CPPUNIT_ASSERT(!a->isEqual(*c,1e-12,1e-12));
+  // the regions of the scratch file of the steps modified since their spill are reused
+  std::size_t scratchSize(MEDCalculatorDBMemoryBudget::GetScratchFileSize());
+  a->applyFunc("x+1.");
+  a->applyFunc("x+1.");
+  a->applyFunc("x-2.");
+  CPPUNIT_ASSERT(MEDCalculatorDBMemoryBudget::GetScratchFileSize()<=scratchSize+3*stepSize);
+  CPPUNIT_ASSERT(a->isEqual(*cp1,1e-12,1e-12));
+  // the steps read in advance count against the budget until they are taken
+  MEDCalculatorDBReadAhead::SetDepth(4);
+  MCAuto<MEDCalculatorDBFieldReal> d=new MEDCalculatorDBFieldReal(lt.getField(0));
+  d->fetchData();
+  CPPUNIT_ASSERT(d->isEqual(*c,1e-12,1e-12));
+  CPPUNIT_ASSERT_EQUAL((std::size_t)0,MEDCalculatorDBReadAhead::GetMemoryInUse());
+  MEDCalculatorDBReadAhead::SetDepth(0);
+  MEDCalculatorDBReadAhead::ResetStatistics();
+  MEDCalculatorDBMemoryBudget::SetBudget(0);
+  MEDCalculatorDBMemoryBudget::ResetStatistics();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldMemory1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  const std::size_t stepSize=5*7*sizeof(double);
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  std::size_t before=a->getHeapMemorySize();
+  a->fetchData();
+  CPPUNIT_ASSERT(a->getHeapMemorySize()>=before+10*stepSize);
+  // a deferred result holds a copy of its operand sharing its steps
+  MCAuto<MEDCalculatorDBFieldCst> one=new MEDCalculatorDBFieldCst(1.);
+  MCAuto<MEDCalculatorDBField> res=(*a)+(*one);
+  CPPUNIT_ASSERT(res->getHeapMemorySize()>=10*stepSize);
+  std::string summary=MEDCalculatorDBFieldReal::GetMemorySummary();
+  CPPUNIT_ASSERT(summary.find("\"Power\" from \"hfile1.med\" : 10 steps, 10 fetched")!=std::string::npos);
+  CPPUNIT_ASSERT(summary.find("(computed)")!=std::string::npos);
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldScalar1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldCst> cst=new MEDCalculatorDBFieldCst(4.);
+  // scalar on both sides of each operator against the constant field based results
+  MCAuto<MEDCalculatorDBFieldReal> four=a->buildCstFieldFromThis(4.);
+  MCAuto<MEDCalculatorDBField> l1=(*cst)-(*a);
+  MCAuto<MEDCalculatorDBField> e1=four->substract(*a);
+  CPPUNIT_ASSERT(l1->isEqual(*e1,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBField> l2=(*cst)/(*a);
+  MCAuto<MEDCalculatorDBField> e2=four->divide(*a);
+  CPPUNIT_ASSERT(l2->isEqual(*e2,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBField> l3=(*a)/(*cst);
+  MCAuto<MEDCalculatorDBField> e3=a->divide(*four);
+  CPPUNIT_ASSERT(l3->isEqual(*e3,1e-12,1e-12));
+  // in place assignment of a scalar on a part of the components
+  MEDCalculatorDBRangeSelection t(":"),p(":"),c("1:3");
+  MCAuto<MEDCalculatorDBFieldReal> v=(*a)(t,p,c);
+  (*v)=7.;
+  MCAuto<MEDCalculatorDBFieldCst> seven=new MEDCalculatorDBFieldCst(7.);
+  CPPUNIT_ASSERT(v->isEqual(*seven,1e-12,1e-12));
+  CPPUNIT_ASSERT(seven->isEqual(*v,1e-12,1e-12));
+  CPPUNIT_ASSERT(!a->isEqual(*seven,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBFieldReal> v0=(*a)(t,p,MEDCalculatorDBRangeSelection("0:1"));
+  CPPUNIT_ASSERT(!v0->isEqual(*seven,1e-12,1e-12));
+  // a constant has no description
+  v->setDescription("described");
+  CPPUNIT_ASSERT(!v->isEqual(*seven,1e-12,1e-12));
+  CPPUNIT_ASSERT(!seven->isEqual(*v,1e-12,1e-12));
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldComponentsView1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MEDCalculatorDBRangeSelection t(":"),p(":"),c1("0:3"),c2("4:7");
+  MCAuto<MEDCalculatorDBFieldReal> v1=(*a)(t,p,c1);
+  MCAuto<MEDCalculatorDBFieldReal> v2=(*a)(t,p,c2);
+  // strided operators against the deferred ones working on copies of the components
+  MCAuto<MEDCalculatorDBField> r1=v1->add(*v2);
+  MCAuto<MEDCalculatorDBField> l1=(*v1)+(*v2);
+  CPPUNIT_ASSERT_EQUAL(3,static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)r1)->getNumberOfComponents());
+  CPPUNIT_ASSERT(r1->isEqual(*l1,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBField> r2=v2->divide(*v1);
+  MCAuto<MEDCalculatorDBField> l2=(*v2)/(*v1);
+  CPPUNIT_ASSERT(r2->isEqual(*l2,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBFieldCst> four=new MEDCalculatorDBFieldCst(4.);
+  MCAuto<MEDCalculatorDBField> r3=v2->substract(*v1);
+  CPPUNIT_ASSERT(r3->isEqual(*four,1e-12,1e-12));
+  // written back in place, component by component
+  (*v1)=(*v2);
+  MCAuto<MEDCalculatorDBFieldCst> zero=new MEDCalculatorDBFieldCst(0.);
+  MCAuto<MEDCalculatorDBField> r4=v2->substract(*v1);
+  CPPUNIT_ASSERT(r4->isEqual(*zero,1e-12,1e-12));
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldReadAhead1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> ref=new MEDCalculatorDBFieldReal(lt.getField(0));
+  ref->fetchData();
+  MEDCalculatorDBReadAhead::ResetStatistics();
+  MEDCalculatorDBReadAhead::SetDepth(3);
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  a->fetchData();
+  CPPUNIT_ASSERT_EQUAL(10,a->getNumberOfFetchedSteps());
+  MCAuto<MEDCalculatorDBFieldCst> two=new MEDCalculatorDBFieldCst(2.);
+  MCAuto<MEDCalculatorDBField> r1=a->multiply(*ref);
+  MCAuto<MEDCalculatorDBField> r2=ref->multiply(*ref);
+  CPPUNIT_ASSERT(r1->isEqual(*r2,1e-12,1e-12));
+  // each step is either taken from the background thread or read by the caller, never both
+  CPPUNIT_ASSERT_EQUAL(10,MEDCalculatorDBReadAhead::GetNumberOfHits()+MEDCalculatorDBReadAhead::GetNumberOfMisses());
+  // steps still being read when overwritten or destroyed
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt.getField(0));
+  b->fetchData();
+  (*b)=2.;
+  CPPUNIT_ASSERT(b->isEqual(*two,1e-12,1e-12));
+  MCAuto<MEDCalculatorDBFieldReal> c=new MEDCalculatorDBFieldReal(lt.getField(0));
+  c->fetchData();
+  c=0;
+  // several batches of 2 steps, each one on a mesh of its own, used by several threads
+  MEDCalculatorDBReadAhead::SetDepth(4);
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(4);
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+  MCAuto<MEDCalculatorDBFieldReal> d=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> e=new MEDCalculatorDBFieldReal(lt.getField(0));
+  d->fetchData();
+  e->fetchData();
+  MCAuto<MEDCalculatorDBField> r3=d->multiply(*e);
+  CPPUNIT_ASSERT(r3->isEqual(*r2,1e-12,1e-12));
+  d->applyFunc("u+1");
+  MCAuto<MEDCalculatorDBField> m4=d->magnitude();
+  CPPUNIT_ASSERT(MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns()>=3);
+  std::vector<MEDCouplingFieldDouble *> fs=e->getFields();
+  CPPUNIT_ASSERT(fs[0]->getMesh()!=fs[9]->getMesh());
+  for(std::size_t i=0;i<fs.size();i++)
+    fs[i]->decrRef();
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(1);
+  MCAuto<MEDCalculatorDBField> m1=d->magnitude();
+  CPPUNIT_ASSERT(m4->isEqual(*m1,1e-12,1e-12));
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+  MEDCalculatorDBReadAhead::SetDepth(0);
+  MEDCalculatorDBReadAhead::ResetStatistics();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldTimeReduction1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  // value of cell #2 component #3 at step #i (time 0.1*i) is 100*(i+1)+34
+  double sumOfSquares=0.;
+  for(int i=0;i<10;i++)
+    sumOfSquares+=(100.*(i+1)+34.)*(100.*(i+1)+34.);
+  const MEDCalculatorDBFieldReal::TimeReduction reds[6]={MEDCalculatorDBFieldReal::TIME_MEAN,MEDCalculatorDBFieldReal::TIME_MIN,MEDCalculatorDBFieldReal::TIME_MAX,
+                                                         MEDCalculatorDBFieldReal::TIME_RMS,MEDCalculatorDBFieldReal::TIME_INTEGRAL,MEDCalculatorDBFieldReal::TIME_ARGMAX};
+  const double expected[6]={584.,134.,1034.,sqrt(sumOfSquares/10.),525.6,9.};
+  for(int r=0;r<6;r++)
+    {
+      MCAuto<MEDCalculatorDBField> res=a->reduceOverTime(reds[r]);
+      MEDCalculatorDBFieldReal *resR=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)res);
+      CPPUNIT_ASSERT_EQUAL(1,resR->getNumberOfSteps());
+      CPPUNIT_ASSERT_EQUAL(7,resR->getNumberOfComponents());
+      std::vector<MEDCouplingFieldDouble *> fs=resR->getFields();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[r],fs[0]->getArray()->getIJ(2,3),1e-9);
+      fs[0]->decrRef();
+    }
+  // steps are read one by one and not kept
+  CPPUNIT_ASSERT_EQUAL(0,a->getNumberOfFetchedSteps());
+  // on a range of steps and components
+  MEDCalculatorDBRangeSelection t("2:5"),p(":"),c("3:4");
+  MCAuto<MEDCalculatorDBFieldReal> v=(*a)(t,p,c);
+  MCAuto<MEDCalculatorDBField> mean=v->reduceOverTime(MEDCalculatorDBFieldReal::TIME_MEAN);
+  std::vector<MEDCouplingFieldDouble *> fs=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)mean)->getFields();
+  CPPUNIT_ASSERT_EQUAL(1,(int)fs[0]->getNumberOfComponents());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(434.,fs[0]->getArray()->getIJ(2,0),1e-9);
+  // the result takes the iteration and order of the first selected step
+  int it,order;
+  fs[0]->getTime(it,order);
+  CPPUNIT_ASSERT_EQUAL(2,it);
+  CPPUNIT_ASSERT_EQUAL(-2,order);
+  fs[0]->decrRef();
+  // same on computed steps
+  MCAuto<MEDCalculatorDBField> m=v->magnitude();
+  MCAuto<MEDCalculatorDBField> meanM=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)m)->reduceOverTime(MEDCalculatorDBFieldReal::TIME_MEAN);
+  fs=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)meanM)->getFields();
+  fs[0]->getTime(it,order);
+  CPPUNIT_ASSERT_EQUAL(2,it);
+  CPPUNIT_ASSERT_EQUAL(-2,order);
+  fs[0]->decrRef();
+  // a deferred field is computed step by step and stays deferred
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldCst> two=new MEDCalculatorDBFieldCst(2.);
+  MCAuto<MEDCalculatorDBField> d=(*b)*(*two);
+  MEDCalculatorDBFieldReal *dR=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)d);
+  MCAuto<MEDCalculatorDBField> meanD=dR->reduceOverTime(MEDCalculatorDBFieldReal::TIME_MEAN);
+  CPPUNIT_ASSERT(dR->isDeferred());
+  CPPUNIT_ASSERT_EQUAL(0,dR->getNumberOfFetchedSteps());
+  CPPUNIT_ASSERT_EQUAL(0,b->getNumberOfFetchedSteps());
+  fs=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)meanD)->getFields();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1168.,fs[0]->getArray()->getIJ(2,3),1e-9);
+  fs[0]->decrRef();
+  // the sums do not depend on the number of threads
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(3);
+  MCAuto<MEDCalculatorDBField> rms3=a->reduceOverTime(MEDCalculatorDBFieldReal::TIME_RMS);
+  CPPUNIT_ASSERT_EQUAL(1,MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns());
+  // same on steps fetched on one mesh
+  MCAuto<MEDCalculatorDBFieldReal> d=new MEDCalculatorDBFieldReal(lt.getField(0));
+  d->fetchData();
+  MCAuto<MEDCalculatorDBField> rms3d=d->reduceOverTime(MEDCalculatorDBFieldReal::TIME_RMS);
+  CPPUNIT_ASSERT_EQUAL(2,MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns());
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(1);
+  MCAuto<MEDCalculatorDBField> rms1=a->reduceOverTime(MEDCalculatorDBFieldReal::TIME_RMS);
+  CPPUNIT_ASSERT_EQUAL(2,MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns());
+  CPPUNIT_ASSERT(rms3->isEqual(*rms1,0.,0.));
+  CPPUNIT_ASSERT(rms3d->isEqual(*rms1,0.,0.));
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldThreads1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt.getField(0));
+  a->fetchData();
+  b->fetchData();
+  // reference results on one thread
+  MCAuto<MEDCalculatorDBField> sum1=a->add(*b);
+  MCAuto<MEDCalculatorDBField> prod1=a->multiply(*b);
+  MCAuto<MEDCalculatorDBField> mag1=a->magnitude();
+  // the steps of a field read from file share one mesh : each call works on a copy of it
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(4);
+  MCAuto<MEDCalculatorDBField> sum4=a->add(*b);
+  MCAuto<MEDCalculatorDBField> prod4=a->multiply(*b);
+  MCAuto<MEDCalculatorDBField> mag4=a->magnitude();
+  CPPUNIT_ASSERT(sum4->isEqual(*sum1,0.,0.));
+  CPPUNIT_ASSERT(prod4->isEqual(*prod1,0.,0.));
+  CPPUNIT_ASSERT(mag4->isEqual(*mag1,0.,0.));
+  b->applyFunc("2*u");
+  MCAuto<MEDCalculatorDBFieldCst> two=new MEDCalculatorDBFieldCst(2.);
+  MCAuto<MEDCalculatorDBField> twoA=(*a)*(*two);
+  CPPUNIT_ASSERT(b->isEqual(*twoA,0.,0.));
+  // add, multiply, magnitude, applyFunc and the isEqual calls
+  CPPUNIT_ASSERT(MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns()>=6);
+  // the steps and the results are on the mesh of the file again
+  std::vector<MEDCouplingFieldDouble *> fsA=a->getFields();
+  std::vector<MEDCouplingFieldDouble *> fsS=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)sum4)->getFields();
+  for(std::size_t i=0;i<fsA.size();i++)
+    {
+      CPPUNIT_ASSERT(fsA[i]->getMesh()==fsA[0]->getMesh());
+      CPPUNIT_ASSERT(fsS[i]->getMesh()==fsA[0]->getMesh());
+      fsA[i]->decrRef();
+      fsS[i]->decrRef();
+    }
+  // a step used by two calls : sequential run
+  MEDCalculatorDBRangeSelection t1("1:10"),t2("0:9"),p,c;
+  MCAuto<MEDCalculatorDBFieldReal> a1=(*a)(t1,p,c);
+  MCAuto<MEDCalculatorDBFieldReal> a2=(*a)(t2,p,c);
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+  MCAuto<MEDCalculatorDBField> shifted4=a1->add(*a2);
+  CPPUNIT_ASSERT_EQUAL(0,MEDCalculatorDBStepsRunner::GetNumberOfConcurrentRuns());
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(1);
+  MCAuto<MEDCalculatorDBField> shifted1=a1->add(*a2);
+  CPPUNIT_ASSERT(shifted4->isEqual(*shifted1,0.,0.));
+  MEDCalculatorDBStepsRunner::ResetStatistics();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testDBFieldWrite1()
+{
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldCst> two=new MEDCalculatorDBFieldCst(2.);
+  MCAuto<MEDCalculatorDBField> b=(*a)*(*two);
+  MEDCalculatorDBFieldReal *bR=static_cast<MEDCalculatorDBFieldReal *>((MEDCalculatorDBField *)b);
+  bR->setName("Power2");
+  // all the steps in one chunk
+  const char fName2[]="hfile2.med";
+  bR->write(fName2,true);
+  MEDCalculatorBrowserLiteStruct lt2(fName2);
+  lt2.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> c=new MEDCalculatorDBFieldReal(lt2.getField(0));
+  CPPUNIT_ASSERT_EQUAL(10,c->getNumberOfSteps());
+  CPPUNIT_ASSERT(c->isEqual(*b,1e-12,1e-12));
+  // one step per chunk : chunks prepared in background while the previous one is written
+  MEDCalculatorDBMemoryBudget::SetBudget(3*5*7*sizeof(double));
+  const char fName3[]="hfile3.med";
+  bR->write(fName3,true);
+  MEDCalculatorDBMemoryBudget::SetBudget(0);
+  MEDCalculatorBrowserLiteStruct lt3(fName3);
+  lt3.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> d=new MEDCalculatorDBFieldReal(lt3.getField(0));
+  CPPUNIT_ASSERT_EQUAL(10,d->getNumberOfSteps());
+  CPPUNIT_ASSERT(d->isEqual(*b,1e-12,1e-12));
+  MEDCalculatorDBMemoryBudget::ResetStatistics();
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testCompiledExpr1()
+{
+  MCAuto<DataArrayDouble> arr=DataArrayDouble::New();
+  arr->alloc(1000,3);
+  for(int i=0;i<3000;i++)
+    arr->setIJ(i/3,i%3,0.25+0.013*(double)i);
+  // results must be bit to bit those of the interpreter, compiled or not
+  const char *funcs1[6]={"x+1000.","sqrt(x*x+1.)+exp(-x)*sin(x)","2*x-3/x","-x*log(x)+max(x,2.)","x^2.5","-x^2"};
+  for(int i=0;i<6;i++)
+    {
+      MCAuto<MEDCalculatorDBCompiledExpr> expr=MEDCalculatorDBCompiledExpr::New(funcs1[i]);
+      CPPUNIT_ASSERT_EQUAL(i!=5,expr->isCompiled());
+      MCAuto<DataArrayDouble> ref=arr->applyFunc(funcs1[i]);
+      MCAuto<DataArrayDouble> res=expr->apply(arr);
+      CPPUNIT_ASSERT(res->isEqual(*ref,0.));
+    }
+  const char *funcs2[3]={"sqrt(x*x+y*y)","z-x/y","atan(y)*2"};
+  for(int i=0;i<3;i++)
+    {
+      MCAuto<MEDCalculatorDBCompiledExpr> expr=MEDCalculatorDBCompiledExpr::New(funcs2[i]);
+      CPPUNIT_ASSERT(expr->isCompiled());
+      MCAuto<DataArrayDouble> ref=arr->applyFunc(2,funcs2[i]);
+      MCAuto<DataArrayDouble> res=expr->apply(2,arr);
+      CPPUNIT_ASSERT(res->isEqual(*ref,0.));
+    }
+  // out of the domain : same error as the interpreter
+  MCAuto<MEDCalculatorDBCompiledExpr> expr=MEDCalculatorDBCompiledExpr::New("sqrt(x-10.)");
+  CPPUNIT_ASSERT(expr->isCompiled());
+  CPPUNIT_ASSERT_THROW(MCAuto<DataArrayDouble>(expr->apply(arr)),INTERP_KERNEL::Exception);
+  MEDCalculatorDBCompiledExpr::SetEnabled(false);
+  expr=MEDCalculatorDBCompiledExpr::New("x+1.");
+  CPPUNIT_ASSERT(!expr->isCompiled());
+  MEDCalculatorDBCompiledExpr::SetEnabled(true);
+  // through MEDCalculatorDBFieldReal::applyFunc
+  const char fName[]="hfile1.med";
+  generateAFile1(fName);
+  MEDCalculatorBrowserLiteStruct lt(fName);
+  lt.selectAllFields();
+  MCAuto<MEDCalculatorDBFieldReal> a=new MEDCalculatorDBFieldReal(lt.getField(0));
+  MCAuto<MEDCalculatorDBFieldReal> b=new MEDCalculatorDBFieldReal(lt.getField(0));
+  a->applyFunc("sqrt(x*x+1.)");
+  MEDCalculatorDBCompiledExpr::SetEnabled(false);
+  b->applyFunc("sqrt(x*x+1.)");
+  MEDCalculatorDBCompiledExpr::SetEnabled(true);
+  CPPUNIT_ASSERT(a->isEqual(*b,0.,0.));
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::testTensorKernels1()
+{
+  // 40000 cells : several chunks of tuples
+  static const int nbOfCells=40000;
+  MCAuto<DataArrayDouble> xs=DataArrayDouble::New(),ys=DataArrayDouble::New();
+  xs->alloc(nbOfCells+1,1);
+  xs->iota(0.);
+  ys->alloc(2,1);
+  ys->iota(0.);
+  MCAuto<MEDCouplingCMesh> m=MEDCouplingCMesh::New();
+  m->setCoords(xs,ys);
+  MCAuto<DataArrayDouble> arr=DataArrayDouble::New();
+  arr->alloc(nbOfCells,7);
+  double *pt=arr->getPointer();
+  for(int i=0;i<7*nbOfCells;i++)
+    pt[i]=3.*sin(1.7*(double)i);
+  MCAuto<MEDCouplingFieldDouble> f7=MEDCouplingFieldDouble::New(ON_CELLS,ONE_TIME);
+  f7->setMesh(m);
+  f7->setArray(arr);
+  std::vector<std::size_t> ids6,ids3a,ids3b;
+  for(std::size_t i=0;i<6;i++)
+    ids6.push_back(i+1);
+  for(std::size_t i=0;i<3;i++)
+    { ids3a.push_back(i); ids3b.push_back(i+4); }
+  MCAuto<MEDCouplingFieldDouble> f6=f7->keepSelectedComponents(ids6);
+  MCAuto<MEDCouplingFieldDouble> fa=f7->keepSelectedComponents(ids3a),fb=f7->keepSelectedComponents(ids3b);
+  std::vector<std::size_t> all6(6);
+  for(std::size_t i=0;i<6;i++)
+    all6[i]=i;
+  for(int nbOfThreads=1;nbOfThreads<=4;nbOfThreads+=3)
+    {
+      MEDCalculatorDBStepsRunner::SetNumberOfThreads(nbOfThreads);
+      // components read in place (f7) or contiguous (f6) : same values as MEDCoupling
+      MCAuto<MEDCouplingFieldDouble> ref=f6->eigenValues();
+      MCAuto<MEDCouplingFieldDouble> res=MEDCalculatorDBTensorKernels::EigenValues(f7,ids6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),1e-12));
+      CPPUNIT_ASSERT(res->isEqualWithoutConsideringStr(ref,0.,1e-12));
+      CPPUNIT_ASSERT_EQUAL(ref->getName(),res->getName());
+      CPPUNIT_ASSERT_EQUAL(ref->getDescription(),res->getDescription());
+      CPPUNIT_ASSERT(ref->getNature()==res->getNature());
+      res=MEDCalculatorDBTensorKernels::EigenValues(f6,all6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),1e-12));
+      ref=f6->eigenVectors();
+      res=MEDCalculatorDBTensorKernels::EigenVectors(f7,ids6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),1e-12));
+      ref=f6->trace();
+      res=MEDCalculatorDBTensorKernels::Trace(f7,ids6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),0.));
+      ref=f6->deviator();
+      res=MEDCalculatorDBTensorKernels::Deviator(f7,ids6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),0.));
+      ref=f6->magnitude();
+      res=MEDCalculatorDBTensorKernels::Magnitude(f7,ids6);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),0.));
+      ref=fa->dot(*fb);
+      res=MEDCalculatorDBTensorKernels::Dot(f7,ids3a,f7,ids3b);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),0.));
+      ref=fa->crossProduct(*fb);
+      res=MEDCalculatorDBTensorKernels::CrossProduct(f7,ids3a,f7,ids3b);
+      CPPUNIT_ASSERT(res->getArray()->isEqual(*ref->getArray(),0.));
+      CPPUNIT_ASSERT(res->isEqualWithoutConsideringStr(ref,0.,0.));
+      CPPUNIT_ASSERT_EQUAL(ref->getName(),res->getName());
+      CPPUNIT_ASSERT(ref->getNature()==res->getNature());
+      CPPUNIT_ASSERT_EQUAL(nbOfCells,(int)res->getNumberOfTuples());
+    }
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(1);
+  // isotropic tensor : same values as MEDCoupling, NaN
+  double iso[6]={2.,2.,2.,0.,0.,0.},vals[3],refVals[3];
+  MEDCalculatorDBTensorKernels::EigenValues6(iso,1,vals);
+  INTERP_KERNEL::computeEigenValues6(iso,refVals);
+  for(int i=0;i<3;i++)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::isnan(refVals[i]),std::isnan(vals[i]));
+      if(!std::isnan(refVals[i]))
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(refVals[i],vals[i],1e-14);
+    }
+  // not computed in place : the caller uses MEDCoupling and its exceptions
+  CPPUNIT_ASSERT(!MEDCalculatorDBTensorKernels::EigenValues(f7,ids3a));
+  CPPUNIT_ASSERT(!MEDCalculatorDBTensorKernels::CrossProduct(f7,ids6,f7,ids3b));
+}
+
+void MEDCoupling::MEDCalculatorBasicsTest::generateAFile1(const char *fName, const mcIdType *old2New)
 {
   double targetCoords[18]={-0.3,-0.3, 0.2,-0.3, 0.7,-0.3, -0.3,0.2, 0.2,0.2, 0.7,0.2, -0.3,0.7, 0.2,0.7, 0.7,0.7 };
   mcIdType targetConn[18]={0,3,4,1, 1,4,2, 4,5,2, 6,7,4,3, 7,8,5,4};
@@ -129,6 +767,8 @@ void MEDCoupling::MEDCalculatorBasicsTest::generateAFile1(const char *fName)
   std::copy(targetCoords,targetCoords+18,myCoords->getPointer());
   m->setCoords(myCoords);
   myCoords->decrRef();
+  if(old2New)
+    m->renumberCells(old2New,true);
   //
   WriteUMesh(fName,m,true);
   static const int nbOfTimeSteps=10;
@@ -145,10 +785,12 @@ void MEDCoupling::MEDCalculatorBasicsTest::generateAFile1(const char *fName)
   f->checkConsistencyLight();
   for(int i=0;i<nbOfTimeSteps;i++)
     {
-      double *pt=da->getPointer();
       for(int j=0;j<5;j++)
-        for(int k=0;k<nbOfComponents;k++,pt++)
-          *pt=(i+1)*100.+(j+1)*10.+k+1;
+        {
+          double *pt=da->getPointer()+(old2New?old2New[j]:j)*nbOfComponents;
+          for(int k=0;k<nbOfComponents;k++,pt++)
+            *pt=(i+1)*100.+(j+1)*10.+k+1;
+        }
       f->setTime(i*0.1,i,-i);
       WriteFieldUsingAlreadyWrittenMesh(fName,f);
     }
@@ -230,3 +872,39 @@ void MEDCoupling::MEDCalculatorBasicsTest::testSPython3()
   s2=MEDCoupling::SPythonInterpreter::strip(s1);
   CPPUNIT_ASSERT_EQUAL(s2,std::string("(12:3,:,4)"));
 }
+
+void MEDCoupling::MEDCalculatorBasicsTest::testSPython4()
+{
+  if(!Py_IsInitialized())
+    Py_Initialize();
+  PyObject *glob=PyDict_New();
+  PyDict_SetItemString(glob,"__builtins__",PyEval_GetBuiltins());
+  bool isSPython;
+  {
+    MEDCoupling::SPythonInterpreter interp(glob,glob);
+    CPPUNIT_ASSERT(interp.run("a=3",isSPython));
+    CPPUNIT_ASSERT(!isSPython);
+    CPPUNIT_ASSERT(interp.run("b=a+4",isSPython));
+    std::size_t nbOfMisses=interp.getNumberOfParseMisses();
+    // same statement, same types : the parsing is taken from the cache
+    CPPUNIT_ASSERT(interp.run("b=a+4",isSPython));
+    CPPUNIT_ASSERT_EQUAL(nbOfMisses,interp.getNumberOfParseMisses());
+    CPPUNIT_ASSERT(interp.getNumberOfParseHits()>=1);
+    CPPUNIT_ASSERT_EQUAL(7L,PyLong_AsLong(PyDict_GetItemString(glob,"b")));
+    // in batch mode the statements are executed by flush
+    interp.setBatch(true);
+    CPPUNIT_ASSERT(interp.run("c=b*2",isSPython));
+    CPPUNIT_ASSERT(interp.run("d=c+1",isSPython));
+    CPPUNIT_ASSERT(!PyDict_GetItemString(glob,"d"));
+    CPPUNIT_ASSERT(interp.flush());
+    CPPUNIT_ASSERT_EQUAL(15L,PyLong_AsLong(PyDict_GetItemString(glob,"d")));
+    // names bound dynamically : the gathered code is run before parsing the next statement
+    CPPUNIT_ASSERT(interp.run("exec('e=d')",isSPython));
+    CPPUNIT_ASSERT(!PyDict_GetItemString(glob,"e"));
+    CPPUNIT_ASSERT(interp.run("f=e+1",isSPython));
+    CPPUNIT_ASSERT(PyDict_GetItemString(glob,"e"));
+    CPPUNIT_ASSERT(interp.flush());
+    CPPUNIT_ASSERT_EQUAL(16L,PyLong_AsLong(PyDict_GetItemString(glob,"f")));
+  }
+  Py_DECREF(glob);
+}
@@ -30,20 +30,50 @@ namespace MEDCoupling
     CPPUNIT_TEST_SUITE(MEDCalculatorBasicsTest);
     // CPPUNIT_TEST( testLightStruct1 );
     // CPPUNIT_TEST( testRangeSelection1 );
+    CPPUNIT_TEST( testLightStruct2 );
     CPPUNIT_TEST( testDBField1 );
+    CPPUNIT_TEST( testDBFieldDeferred1 );
+    CPPUNIT_TEST( testDBFieldPermutation1 );
+    CPPUNIT_TEST( testMeshCorrespondences1 );
+    CPPUNIT_TEST( testDBFieldMemoryBudget1 );
+    CPPUNIT_TEST( testDBFieldMemory1 );
+    CPPUNIT_TEST( testDBFieldScalar1 );
+    CPPUNIT_TEST( testDBFieldComponentsView1 );
+    CPPUNIT_TEST( testDBFieldReadAhead1 );
+    CPPUNIT_TEST( testDBFieldTimeReduction1 );
+    CPPUNIT_TEST( testDBFieldThreads1 );
+    CPPUNIT_TEST( testDBFieldWrite1 );
+    CPPUNIT_TEST( testCompiledExpr1 );
+    CPPUNIT_TEST( testTensorKernels1 );
     CPPUNIT_TEST( testSPython1 );
     CPPUNIT_TEST( testSPython2 );
     CPPUNIT_TEST( testSPython3 );
+    CPPUNIT_TEST( testSPython4 );
     CPPUNIT_TEST_SUITE_END();
   public:
     void testLightStruct1();
+    void testLightStruct2();
     void testRangeSelection1();
     void testDBField1();
+    void testDBFieldDeferred1();
+    void testDBFieldPermutation1();
+    void testMeshCorrespondences1();
+    void testDBFieldMemoryBudget1();
+    void testDBFieldMemory1();
+    void testDBFieldScalar1();
+    void testDBFieldComponentsView1();
+    void testDBFieldReadAhead1();
+    void testDBFieldTimeReduction1();
+    void testDBFieldThreads1();
+    void testDBFieldWrite1();
+    void testCompiledExpr1();
+    void testTensorKernels1();
     void testSPython1();
     void testSPython2();
     void testSPython3();
+    void testSPython4();
   private:
-    static void generateAFile1(const char *fName);
+    static void generateAFile1(const char *fName, const mcIdType *old2New=0);
   };
 }
 
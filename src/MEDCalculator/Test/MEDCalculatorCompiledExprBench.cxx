@@ -0,0 +1,67 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+// Compares the MEDCoupling interpreter with MEDCalculatorDBCompiledExpr on a few expressions applied to an array of
+// nbOfTuples tuples, and checks that both give the same values :
+//   MEDCalculatorCompiledExprBench 10000000
+
+#include "MEDCalculatorDBCompiledExpr.hxx"
+#include "MEDCalculatorPerfUtils.hxx"
+
+#include "MEDCouplingMemArray.hxx"
+#include "MCAuto.hxx"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace MEDCoupling;
+
+static void Run(const DataArrayDouble *arr, const char *func, int nbOfComp)
+{
+  double t0=MEDCalculatorPerfUtils::Now();
+  MCAuto<DataArrayDouble> ref=nbOfComp>0?arr->applyFunc(nbOfComp,func):arr->applyFunc(func);
+  double t1=MEDCalculatorPerfUtils::Now();
+  MCAuto<MEDCalculatorDBCompiledExpr> expr=MEDCalculatorDBCompiledExpr::New(func);
+  MCAuto<DataArrayDouble> res=nbOfComp>0?expr->apply(nbOfComp,arr):expr->apply(arr);
+  double t2=MEDCalculatorPerfUtils::Now();
+  std::cout << "\"" << func << "\" compiled=" << (expr->isCompiled()?1:0);
+  std::cout << " interpreted_wall_s=" << t1-t0 << " compiled_wall_s=" << t2-t1;
+  std::cout << " identical=" << (res->isEqual(*ref,0.)?1:0) << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  if(argc!=2)
+    {
+      std::cerr << "Usage : " << argv[0] << " nbOfTuples" << std::endl;
+      return 1;
+    }
+  mcIdType nbOfTuples=atol(argv[1]);
+  MCAuto<DataArrayDouble> arr=DataArrayDouble::New();
+  arr->alloc(nbOfTuples,2);
+  double *pt=arr->getPointer();
+  for(mcIdType i=0;i<2*nbOfTuples;i++)
+    pt[i]=1.+(double)(i%1013)*0.01;
+  Run(arr,"sqrt(x*x+y*y)",1);
+  Run(arr,"sqrt(x*x+1.)+exp(-x)*sin(x)",0);
+  Run(arr,"2.*x-3./x+max(x,4.)",0);
+  Run(arr,"x*y^2",1);
+  return 0;
+}
@@ -0,0 +1,296 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorPerfTest.hxx"
+#include "MEDCalculatorPerfUtils.hxx"
+#include "MEDCalculatorBrowserLiteStruct.hxx"
+#include "MEDCalculatorDBRangeSelection.hxx"
+#include "MEDCalculatorDBField.hxx"
+#include "MEDCalculatorDBStepsRunner.hxx"
+#include "MEDCalculatorDBTensorKernels.hxx"
+#include "MEDCalculatorDBReadAhead.hxx"
+
+#include "MEDCouplingMemArray.hxx"
+#include "MEDCouplingCMesh.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+#include "MCAuto.hxx"
+
+#include <cmath>
+#include <sstream>
+
+using namespace MEDCoupling;
+
+int MEDCalculatorPerfTest::_cells_per_dir=0;
+
+int MEDCalculatorPerfTest::_nb_of_steps=0;
+
+std::string MEDCalculatorPerfTest::_file_name;
+
+static MEDCalculatorDBFieldReal *AsReal(MEDCalculatorDBField *f)
+{
+  return static_cast<MEDCalculatorDBFieldReal *>(f);
+}
+
+typedef MEDCouplingFieldDouble *(MEDCouplingFieldDouble::*RefTensorOp)() const;
+
+typedef MEDCouplingFieldDouble *(*KernelTensorOp)(const MEDCouplingFieldDouble *, const std::vector<std::size_t>&);
+
+/*!
+ * Times the MEDCoupling operation \a refOp and the kernel \a op on 1 then \a nbOfThreads threads, checks that they give the
+ * same values and appends the JSON line of \a name.
+ */
+static void RunTensorKernel(const MEDCouplingFieldDouble *f, const char *name, RefTensorOp refOp, KernelTensorOp op, int nbOfThreads)
+{
+  std::vector<std::size_t> ids(f->getNumberOfComponents());
+  for(std::size_t i=0;i<ids.size();i++)
+    ids[i]=i;
+  double t0=MEDCalculatorPerfUtils::Now();
+  MCAuto<MEDCouplingFieldDouble> ref=(f->*refOp)();
+  double t1=MEDCalculatorPerfUtils::Now();
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(1);
+  MCAuto<MEDCouplingFieldDouble> res1=op(f,ids);
+  double t2=MEDCalculatorPerfUtils::Now();
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(nbOfThreads);
+  MCAuto<MEDCouplingFieldDouble> resN=op(f,ids);
+  double t3=MEDCalculatorPerfUtils::Now();
+  CPPUNIT_ASSERT(res1->getArray()->isEqual(*ref->getArray(),1e-12));
+  CPPUNIT_ASSERT(resN->getArray()->isEqual(*ref->getArray(),1e-12));
+  std::ostringstream oss;
+  oss << "{\"test\": \"tensor_kernel_" << name << "\", \"tuples\": " << f->getNumberOfTuples() << ", \"threads\": " << nbOfThreads;
+  oss << ", \"medcoupling_wall_s\": " << t1-t0 << ", \"kernel_1_thread_wall_s\": " << t2-t1;
+  oss << ", \"kernel_threads_wall_s\": " << t3-t2 << "}";
+  MEDCalculatorPerfUtils::WriteReportLine(oss.str());
+}
+
+//! Generates once for all the tests the file of MEDCalculatorPerfUtils::GenerateTensorFile
+void MEDCalculatorPerfTest::setUp()
+{
+  if(!_file_name.empty())
+    return ;
+  _cells_per_dir=MEDCalculatorPerfUtils::GetEnvInt("MEDCALCULATOR_PERF_CELLS_PER_DIR",200);
+  _nb_of_steps=MEDCalculatorPerfUtils::GetEnvInt("MEDCALCULATOR_PERF_STEPS",20);
+  const char fName[]="MEDCalculatorPerfTest.med";
+  MEDCalculatorPerfUtils::GenerateTensorFile(fName,_cells_per_dir,_nb_of_steps);
+  _file_name=fName;
+}
+
+MEDCalculatorDBFieldReal *MEDCalculatorPerfTest::loadField() const
+{
+  MEDCalculatorBrowserLiteStruct lt(_file_name.c_str());
+  lt.selectAllFields();
+  return new MEDCalculatorDBFieldReal(lt.getField(0));
+}
+
+void MEDCalculatorPerfTest::start()
+{
+  _rss_before=MEDCalculatorPerfUtils::PeakRSS();
+  _start=MEDCalculatorPerfUtils::Now();
+}
+
+/*!
+ * Appends the JSON line of \a name. \a nbOfComp is the number of components of each step processed, the throughput being
+ * given in values per second. \a res is the field holding the result, its heap size is reported too.
+ */
+void MEDCalculatorPerfTest::report(const char *name, const MEDCalculatorDBFieldReal *res, int nbOfComp) const
+{
+  double wall=MEDCalculatorPerfUtils::Now()-_start;
+  long rss=MEDCalculatorPerfUtils::PeakRSS();
+  CPPUNIT_ASSERT_EQUAL(_nb_of_steps,res->getNumberOfSteps());
+  CPPUNIT_ASSERT_EQUAL(_nb_of_steps,res->getNumberOfFetchedSteps());
+  double nbOfValues=(double)_cells_per_dir*(double)_cells_per_dir*(double)_nb_of_steps*(double)nbOfComp;
+  std::ostringstream oss;
+  oss << "{\"test\": \"" << name << "\", \"cells\": " << _cells_per_dir*_cells_per_dir << ", \"steps\": " << _nb_of_steps;
+  oss << ", \"components\": " << nbOfComp << ", \"threads\": " << MEDCalculatorDBStepsRunner::GetNumberOfThreads();
+  oss << ", \"wall_s\": " << wall << ", \"values_per_s\": " << (wall>0.?nbOfValues/wall:0.);
+  oss << ", \"result_bytes\": " << res->getHeapMemorySize();
+  oss << ", \"peak_rss_kB\": " << rss << ", \"peak_rss_increase_kB\": " << rss-_rss_before << "}";
+  MEDCalculatorPerfUtils::WriteReportLine(oss.str());
+}
+
+void MEDCalculatorPerfTest::testLoad()
+{
+  start();
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  report("load",a,6);
+}
+
+void MEDCalculatorPerfTest::testArithmetic()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  MCAuto<MEDCalculatorDBFieldReal> b=loadField();
+  a->fetchData(); b->fetchData();
+  start();
+  MCAuto<MEDCalculatorDBField> t1=(*a)*(*b);
+  MCAuto<MEDCalculatorDBField> t2=(*t1)-(*a);
+  MCAuto<MEDCalculatorDBField> res=(*t2)/(*b);
+  AsReal(res)->fetchData();
+  report("arithmetic",AsReal(res),6);
+}
+
+void MEDCalculatorPerfTest::testScalar()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  MCAuto<MEDCalculatorDBFieldCst> c1=new MEDCalculatorDBFieldCst(2.5);
+  MCAuto<MEDCalculatorDBFieldCst> c2=new MEDCalculatorDBFieldCst(1.);
+  start();
+  MCAuto<MEDCalculatorDBField> t1=(*a)*(*c1);
+  MCAuto<MEDCalculatorDBField> res=(*t1)+(*c2);
+  AsReal(res)->fetchData();
+  report("scalar",AsReal(res),6);
+}
+
+void MEDCalculatorPerfTest::testComponentsSelection()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  MEDCalculatorDBRangeSelection t(":"),p(":"),c1("0:3"),c2("3:6");
+  start();
+  MCAuto<MEDCalculatorDBFieldReal> v1=(*a)(t,p,c1);
+  MCAuto<MEDCalculatorDBFieldReal> v2=(*a)(t,p,c2);
+  MCAuto<MEDCalculatorDBField> res=v1->add(*v2);
+  AsReal(res)->fetchData();
+  report("components_selection",AsReal(res),3);
+}
+
+void MEDCalculatorPerfTest::testApplyFunc()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  start();
+  a->applyFunc("sqrt(x*x+1.)-2.*x");
+  report("apply_func",a,6);
+}
+
+void MEDCalculatorPerfTest::testTensor()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  start();
+  MCAuto<MEDCalculatorDBField> ev=a->eigenValues();
+  AsReal(ev)->fetchData();
+  report("eigen_values",AsReal(ev),6);
+  start();
+  MCAuto<MEDCalculatorDBField> tr=a->trace();
+  AsReal(tr)->fetchData();
+  report("trace",AsReal(tr),6);
+  start();
+  MCAuto<MEDCalculatorDBField> dev=a->deviator();
+  AsReal(dev)->fetchData();
+  report("deviator",AsReal(dev),6);
+}
+
+/*!
+ * a*b+b/c-a evaluated in one pass per step by the deferred operators, then eagerly with one temporary multi steps field per
+ * operator. The deferred evaluation goes first, the peak RSS of the process only growing.
+ */
+void MEDCalculatorPerfTest::testDeferred()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  MCAuto<MEDCalculatorDBFieldReal> b=loadField();
+  MCAuto<MEDCalculatorDBFieldReal> c=loadField();
+  a->fetchData(); b->fetchData(); c->fetchData();
+  start();
+  MCAuto<MEDCalculatorDBField> t1=(*a)*(*b);
+  MCAuto<MEDCalculatorDBField> t2=(*b)/(*c);
+  MCAuto<MEDCalculatorDBField> t3=(*t1)+(*t2);
+  MCAuto<MEDCalculatorDBField> deferred=(*t3)-(*a);
+  AsReal(deferred)->fetchData();
+  report("deferred_expression",AsReal(deferred),6);
+  start();
+  MCAuto<MEDCalculatorDBField> e1=a->multiply(*b);
+  MCAuto<MEDCalculatorDBField> e2=b->divide(*c);
+  MCAuto<MEDCalculatorDBField> e3=AsReal(e1)->add(*AsReal(e2));
+  MCAuto<MEDCalculatorDBField> eager=AsReal(e3)->substract(*a);
+  AsReal(eager)->fetchData();
+  report("eager_expression",AsReal(eager),6);
+  CPPUNIT_ASSERT(deferred->isEqual(*eager,1e-12,1e-12));
+}
+
+/*!
+ * applyFunc on all the steps, read on demand then read ahead in background by MEDCalculatorDBReadAhead with a depth of
+ * MEDCALCULATOR_PERF_READ_AHEAD_DEPTH. A first run puts the file system cache in the same state for both measured runs.
+ */
+void MEDCalculatorPerfTest::testReadAhead()
+{
+  const char func[]="sqrt(x*x+1.)+exp(-x)*sin(x)";
+  int depth=MEDCalculatorPerfUtils::GetEnvInt("MEDCALCULATOR_PERF_READ_AHEAD_DEPTH",4);
+  int depthBefore=MEDCalculatorDBReadAhead::GetDepth();
+  MEDCalculatorDBReadAhead::SetDepth(0);
+  MCAuto<MEDCalculatorDBFieldReal> warm=loadField();
+  warm->applyFunc(func);
+  start();
+  MCAuto<MEDCalculatorDBFieldReal> onDemand=loadField();
+  onDemand->applyFunc(func);
+  report("read_on_demand",onDemand,6);
+  MEDCalculatorDBReadAhead::ResetStatistics();
+  MEDCalculatorDBReadAhead::SetDepth(depth);
+  start();
+  MCAuto<MEDCalculatorDBFieldReal> ahead=loadField();
+  ahead->applyFunc(func);
+  report("read_ahead",ahead,6);
+  MEDCalculatorDBReadAhead::SetDepth(depthBefore);
+  std::ostringstream oss;
+  oss << "{\"test\": \"read_ahead_statistics\", \"depth\": " << depth << ", \"hits\": " << MEDCalculatorDBReadAhead::GetNumberOfHits();
+  oss << ", \"misses\": " << MEDCalculatorDBReadAhead::GetNumberOfMisses() << "}";
+  MEDCalculatorPerfUtils::WriteReportLine(oss.str());
+  CPPUNIT_ASSERT(ahead->isEqual(*onDemand,1e-12,1e-12));
+}
+
+/*!
+ * MEDCalculatorDBTensorKernels against the MEDCoupling tensor operations, on a field of symmetric tensors.
+ */
+void MEDCalculatorPerfTest::testTensorKernels()
+{
+  mcIdType nbOfTuples=MEDCalculatorPerfUtils::GetEnvInt("MEDCALCULATOR_PERF_TUPLES",1000000);
+  int nbOfThreads=MEDCalculatorPerfUtils::GetEnvInt("MEDCALCULATOR_PERF_THREADS",4);
+  MCAuto<DataArrayDouble> xs=DataArrayDouble::New(),ys=DataArrayDouble::New();
+  xs->alloc(nbOfTuples+1,1);
+  xs->iota(0.);
+  ys->alloc(2,1);
+  ys->iota(0.);
+  MCAuto<MEDCouplingCMesh> m=MEDCouplingCMesh::New();
+  m->setCoords(xs,ys);
+  MCAuto<DataArrayDouble> arr=DataArrayDouble::New();
+  arr->alloc(nbOfTuples,6);
+  double *pt=arr->getPointer();
+  for(mcIdType i=0;i<6*nbOfTuples;i++)
+    pt[i]=3.*sin(1.7*(double)i);
+  MCAuto<MEDCouplingFieldDouble> f=MEDCouplingFieldDouble::New(ON_CELLS,ONE_TIME);
+  f->setMesh(m);
+  f->setArray(arr);
+  int nbOfThreadsBefore=MEDCalculatorDBStepsRunner::GetNumberOfThreads();
+  RunTensorKernel(f,"eigen_values",&MEDCouplingFieldDouble::eigenValues,&MEDCalculatorDBTensorKernels::EigenValues,nbOfThreads);
+  RunTensorKernel(f,"eigen_vectors",&MEDCouplingFieldDouble::eigenVectors,&MEDCalculatorDBTensorKernels::EigenVectors,nbOfThreads);
+  RunTensorKernel(f,"trace",&MEDCouplingFieldDouble::trace,&MEDCalculatorDBTensorKernels::Trace,nbOfThreads);
+  RunTensorKernel(f,"deviator",&MEDCouplingFieldDouble::deviator,&MEDCalculatorDBTensorKernels::Deviator,nbOfThreads);
+  RunTensorKernel(f,"magnitude",&MEDCouplingFieldDouble::magnitude,&MEDCalculatorDBTensorKernels::Magnitude,nbOfThreads);
+  MEDCalculatorDBStepsRunner::SetNumberOfThreads(nbOfThreadsBefore);
+}
+
+void MEDCalculatorPerfTest::testWrite()
+{
+  MCAuto<MEDCalculatorDBFieldReal> a=loadField();
+  a->fetchData();
+  start();
+  a->write("MEDCalculatorPerfTestOut.med",true);
+  report("write",a,6);
+}
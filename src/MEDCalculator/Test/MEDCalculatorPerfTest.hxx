@@ -0,0 +1,78 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORPERFTEST_HXX__
+#define __MEDCALCULATORPERFTEST_HXX__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace MEDCoupling
+{
+  class MEDCalculatorDBFieldReal;
+
+  /*!
+   * Timings of the hot paths of MEDCalculator on a multi steps file generated on the fly. Each test appends one JSON
+   * line to the file given by MEDCALCULATOR_PERF_REPORT (to the standard output if not set). The size of the file is given
+   * by MEDCALCULATOR_PERF_CELLS_PER_DIR and MEDCALCULATOR_PERF_STEPS. testTensorKernels works on a single field of
+   * MEDCALCULATOR_PERF_TUPLES tensors, on 1 and MEDCALCULATOR_PERF_THREADS threads. testReadAhead reads the steps
+   * ahead with a depth of MEDCALCULATOR_PERF_READ_AHEAD_DEPTH.
+   */
+  class MEDCalculatorPerfTest : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(MEDCalculatorPerfTest);
+    CPPUNIT_TEST( testLoad );
+    CPPUNIT_TEST( testArithmetic );
+    CPPUNIT_TEST( testScalar );
+    CPPUNIT_TEST( testComponentsSelection );
+    CPPUNIT_TEST( testApplyFunc );
+    CPPUNIT_TEST( testTensor );
+    CPPUNIT_TEST( testTensorKernels );
+    CPPUNIT_TEST( testDeferred );
+    CPPUNIT_TEST( testReadAhead );
+    CPPUNIT_TEST( testWrite );
+    CPPUNIT_TEST_SUITE_END();
+  public:
+    void setUp();
+    void testLoad();
+    void testArithmetic();
+    void testScalar();
+    void testComponentsSelection();
+    void testApplyFunc();
+    void testTensor();
+    void testTensorKernels();
+    void testDeferred();
+    void testReadAhead();
+    void testWrite();
+  private:
+    MEDCalculatorDBFieldReal *loadField() const;
+    void start();
+    void report(const char *name, const MEDCalculatorDBFieldReal *res, int nbOfComp) const;
+  private:
+    double _start;
+    long _rss_before;
+    static int _cells_per_dir;
+    static int _nb_of_steps;
+    static std::string _file_name;
+  };
+}
+
+#endif
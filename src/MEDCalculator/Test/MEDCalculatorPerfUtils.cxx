@@ -0,0 +1,133 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "MEDCalculatorPerfUtils.hxx"
+
+#include "MEDLoader.hxx"
+
+#include "MEDCouplingMemArray.hxx"
+#include "MEDCouplingUMesh.hxx"
+#include "MEDCouplingCMesh.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+#include "MCAuto.hxx"
+
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace MEDCoupling;
+
+//! Wall clock time in seconds
+double MEDCalculatorPerfUtils::Now()
+{
+#ifdef WIN32
+  LARGE_INTEGER freq,count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart/(double)freq.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv,0);
+  return (double)tv.tv_sec+1e-6*(double)tv.tv_usec;
+#endif
+}
+
+//! Peak resident memory of the process in kB
+long MEDCalculatorPerfUtils::PeakRSS()
+{
+#ifdef WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(!GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc)))
+    return 0;
+  return (long)(pmc.PeakWorkingSetSize/1024);
+#else
+  struct rusage ru;
+  getrusage(RUSAGE_SELF,&ru);
+  return ru.ru_maxrss;
+#endif
+}
+
+//! Value of the environment variable \a name if set to a positive integer, \a defaultValue otherwise
+int MEDCalculatorPerfUtils::GetEnvInt(const char *name, int defaultValue)
+{
+  const char *val=getenv(name);
+  if(!val || atoi(val)<=0)
+    return defaultValue;
+  return atoi(val);
+}
+
+//! Appends \a line to the file given by MEDCALCULATOR_PERF_REPORT, or writes it on the standard output if not set
+void MEDCalculatorPerfUtils::WriteReportLine(const std::string& line)
+{
+  const char *reportFile=getenv("MEDCALCULATOR_PERF_REPORT");
+  if(reportFile && reportFile[0]!='\0')
+    {
+      std::ofstream ofs(reportFile,std::ios::app);
+      ofs << line << std::endl;
+    }
+  else
+    std::cout << line << std::endl;
+}
+
+/*!
+ * Writes in \a fName the field "Stress" of symmetric tensors (6 components) on the cells of the \a nbOfCellsPerDir x
+ * \a nbOfCellsPerDir cartesian mesh "PerfMesh", with \a nbOfSteps steps. The diagonal dominates so that the tensors
+ * are definite, and all the values are positive.
+ */
+void MEDCalculatorPerfUtils::GenerateTensorFile(const char *fName, int nbOfCellsPerDir, int nbOfSteps)
+{
+  MCAuto<DataArrayDouble> arr=DataArrayDouble::New();
+  arr->alloc(nbOfCellsPerDir+1,1);
+  arr->iota(0.);
+  MCAuto<MEDCouplingCMesh> cm=MEDCouplingCMesh::New();
+  cm->setCoords(arr,arr);
+  MCAuto<MEDCouplingUMesh> m=cm->buildUnstructured();
+  m->setName("PerfMesh");
+  WriteUMesh(fName,m,true);
+  mcIdType nbOfCells=m->getNumberOfCells();
+  MCAuto<MEDCouplingFieldDouble> f=MEDCouplingFieldDouble::New(ON_CELLS,ONE_TIME);
+  f->setName("Stress");
+  f->setMesh(m);
+  MCAuto<DataArrayDouble> da=DataArrayDouble::New();
+  da->alloc(nbOfCells,6);
+  da->setInfoOnComponent(0,"xx [Pa]"); da->setInfoOnComponent(1,"yy [Pa]"); da->setInfoOnComponent(2,"zz [Pa]");
+  da->setInfoOnComponent(3,"xy [Pa]"); da->setInfoOnComponent(4,"yz [Pa]"); da->setInfoOnComponent(5,"xz [Pa]");
+  f->setArray(da);
+  for(int i=0;i<nbOfSteps;i++)
+    {
+      double *pt=da->getPointer();
+      for(mcIdType j=0;j<nbOfCells;j++,pt+=6)
+        {
+          double v=(double)((j+i)%97);
+          pt[0]=20.+v; pt[1]=21.+0.5*v; pt[2]=22.+0.25*v;
+          pt[3]=1.+0.01*v; pt[4]=2.-0.01*v; pt[5]=0.5+0.02*v;
+        }
+      f->setTime(0.1*i,i,-1);
+      WriteFieldUsingAlreadyWrittenMesh(fName,f);
+    }
+}
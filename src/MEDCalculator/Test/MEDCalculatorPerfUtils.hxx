@@ -0,0 +1,43 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __MEDCALCULATORPERFUTILS_HXX__
+#define __MEDCALCULATORPERFUTILS_HXX__
+
+#include <string>
+
+namespace MEDCoupling
+{
+  /*!
+   * Helpers shared by the performance tests and benchmarks of MEDCalculator : clock, peak memory, settings from the
+   * environment, JSON report and generation of the test file.
+   */
+  class MEDCalculatorPerfUtils
+  {
+  public:
+    static double Now();
+    static long PeakRSS();
+    static int GetEnvInt(const char *name, int defaultValue);
+    static void WriteReportLine(const std::string& line);
+    static void GenerateTensorFile(const char *fName, int nbOfCellsPerDir, int nbOfSteps);
+  };
+}
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDCouplingFieldDoubleClient.hxx"
+#include "ParaMEDCouplingPartsFetcher.hxx"
+#include "MEDCouplingFieldDoubleClient.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+
+#include <vector>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  RefCountObject *FetchFieldPart(CORBA::Object_ptr part)
+  {
+    SALOME_MED::MEDCouplingFieldDoubleCorbaInterface_var fieldPtr=SALOME_MED::MEDCouplingFieldDoubleCorbaInterface::_narrow(part);
+    return MEDCouplingFieldDoubleClient::New(fieldPtr);
+  }
+}
+
+/*!
+ * Returns the parts of the distributed field \a fieldPtr, one per rank in rank order, all ranks being fetched concurrently.
+ * The caller takes the ownership of the returned fields.
+ */
+std::vector<MEDCouplingFieldDouble *> ParaMEDCouplingFieldDoubleClient::NewParts(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr)
+{
+  //the servant of rank 0 forwards Register/UnRegister to all the other ranks.
+  fieldPtr->Register();
+  std::vector<RefCountObject *> parts;
+  try
+    {
+      parts=ParaMEDCouplingPartsFetcher::FetchAll(fieldPtr,FetchFieldPart);
+    }
+  catch(...)
+    {
+      fieldPtr->UnRegister();
+      throw;
+    }
+  fieldPtr->UnRegister();
+  std::vector<MEDCouplingFieldDouble *> ret(parts.size());
+  for(std::size_t i=0;i<parts.size();i++)
+    ret[i]=static_cast<MEDCouplingFieldDouble *>(parts[i]);
+  return ret;
+}
+
+/*!
+ * Returns the global field gathering all the parts of the distributed field \a fieldPtr.
+ * The parts are fetched concurrently, then merged, and the nodes shared by several parts are merged once at the end with
+ * precision \a eps.
+ */
+MEDCouplingFieldDouble *ParaMEDCouplingFieldDoubleClient::New(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr, double eps)
+{
+  std::vector<MEDCouplingFieldDouble *> parts=NewParts(fieldPtr);
+  std::vector<const MEDCouplingFieldDouble *> partsC(parts.begin(),parts.end());
+  MEDCouplingFieldDouble *ret=0;
+  try
+    {
+      ret=MEDCouplingFieldDouble::MergeFields(partsC);
+      ret->mergeNodes(eps);
+    }
+  catch(...)
+    {
+      if(ret)
+        ret->decrRef();
+      for(std::vector<MEDCouplingFieldDouble *>::const_iterator it=parts.begin();it!=parts.end();it++)
+        (*it)->decrRef();
+      throw;
+    }
+  for(std::vector<MEDCouplingFieldDouble *>::const_iterator it=parts.begin();it!=parts.end();it++)
+    (*it)->decrRef();
+  return ret;
+}
@@ -0,0 +1,124 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDCouplingPartsFetcher.hxx"
+#include "MEDCouplingRefCountObject.hxx"
+#include "InterpKernelException.hxx"
+
+#include <pthread.h>
+#include <exception>
+#include <sstream>
+#include <string>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  typedef struct
+  {
+    CORBA::Object_ptr obj;
+    ParaMEDCouplingPartsFetcher::FetchPart fetch;
+    RefCountObject *part;
+    bool exception;
+    std::string msg;
+  } fetchpart_st;
+
+  void *th_fetchpart(void *s)
+  {
+    fetchpart_st *st = (fetchpart_st*)s;
+    try
+      {
+        st->part = st->fetch(st->obj);
+      }
+    catch(INTERP_KERNEL::Exception& ex)
+      {
+        st->exception = true;
+        st->msg = ex.what();
+      }
+    catch(const CORBA::Exception& ex)
+      {
+        std::ostringstream msg;
+        msg << "CORBA::Exception: " << ex;
+        st->exception = true;
+        st->msg = msg.str();
+      }
+    catch(std::exception& ex)
+      {
+        st->exception = true;
+        st->msg = ex.what();
+      }
+    catch(...)
+      {
+        st->exception = true;
+        st->msg = "unknown exception";
+      }
+    return 0;
+  }
+}
+
+/*!
+ * Returns one part per rank of \a obj, in rank order. The caller takes the ownership of the returned parts.
+ * \a fetch is invoked on the object of each rank as listed by Engines::MPIObject::tior.
+ * If one of the ranks fails, the parts already fetched are released and an INTERP_KERNEL::Exception is thrown.
+ */
+std::vector<RefCountObject *> ParaMEDCouplingPartsFetcher::FetchAll(Engines::MPIObject_ptr obj, FetchPart fetch)
+{
+  Engines::IORTab_var tior=obj->tior();
+  int nbOfParts=tior->length();
+  std::vector<pthread_t> th(nbOfParts);
+  std::vector<bool> started(nbOfParts,false);
+  std::vector<fetchpart_st> sts(nbOfParts);
+  for(int ip=0;ip<nbOfParts;ip++)
+    {
+      sts[ip].obj=tior[ip];
+      sts[ip].fetch=fetch;
+      sts[ip].part=0;
+      sts[ip].exception=false;
+      started[ip]=pthread_create(&th[ip],0,th_fetchpart,(void*)&sts[ip])==0;
+      if(!started[ip])
+        {
+          sts[ip].exception=true;
+          sts[ip].msg="impossible to start the fetching thread";
+        }
+    }
+  std::ostringstream msg;
+  bool failed=false;
+  for(int ip=0;ip<nbOfParts;ip++)
+    {
+      if(started[ip])
+        pthread_join(th[ip],0);
+      if(sts[ip].exception)
+        {
+          msg << "ParaMEDCouplingPartsFetcher::FetchAll : fetching part of rank " << ip << " failed : " << sts[ip].msg << " !";
+          failed=true;
+        }
+    }
+  std::vector<RefCountObject *> ret(nbOfParts);
+  for(int ip=0;ip<nbOfParts;ip++)
+    ret[ip]=sts[ip].part;
+  if(failed)
+    {
+      for(std::vector<RefCountObject *>::const_iterator it=ret.begin();it!=ret.end();it++)
+        if(*it)
+          (*it)->decrRef();
+      throw INTERP_KERNEL::Exception(msg.str().c_str());
+    }
+  return ret;
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __PARAMEDCOUPLINGPARTSFETCHER_HXX__
+#define __PARAMEDCOUPLINGPARTSFETCHER_HXX__
+
+#include "SALOMEconfig.h"
+#ifdef WIN32
+#define NOMINMAX
+#endif
+#include CORBA_SERVER_HEADER(SALOME_MPIObject)
+#include "MEDCouplingClient.hxx"
+
+#include <vector>
+
+namespace MEDCoupling
+{
+  class RefCountObject;
+
+  /*!
+   * Fetches the parts held by each rank of a distributed CORBA object, all ranks being
+   * requested concurrently, one thread per rank.
+   */
+  class MEDCOUPLINGCLIENT_EXPORT ParaMEDCouplingPartsFetcher
+  {
+  public:
+    typedef RefCountObject *(*FetchPart)(CORBA::Object_ptr part);
+    static std::vector<RefCountObject *> FetchAll(Engines::MPIObject_ptr obj, FetchPart fetch);
+  };
+}
+
+#endif
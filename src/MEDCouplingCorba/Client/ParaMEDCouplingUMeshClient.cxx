@@ -0,0 +1,93 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDCouplingUMeshClient.hxx"
+#include "ParaMEDCouplingPartsFetcher.hxx"
+#include "MEDCouplingUMeshClient.hxx"
+#include "MEDCouplingUMesh.hxx"
+
+#include <vector>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  RefCountObject *FetchUMeshPart(CORBA::Object_ptr part)
+  {
+    SALOME_MED::MEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::MEDCouplingUMeshCorbaInterface::_narrow(part);
+    return MEDCouplingUMeshClient::New(meshPtr);
+  }
+}
+
+/*!
+ * Returns the parts of the distributed mesh \a meshPtr, one per rank in rank order, all ranks being fetched concurrently.
+ * The caller takes the ownership of the returned meshes.
+ */
+std::vector<MEDCouplingUMesh *> ParaMEDCouplingUMeshClient::NewParts(SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr meshPtr)
+{
+  //the servant of rank 0 forwards Register/UnRegister to all the other ranks.
+  meshPtr->Register();
+  std::vector<RefCountObject *> parts;
+  try
+    {
+      parts=ParaMEDCouplingPartsFetcher::FetchAll(meshPtr,FetchUMeshPart);
+    }
+  catch(...)
+    {
+      meshPtr->UnRegister();
+      throw;
+    }
+  meshPtr->UnRegister();
+  std::vector<MEDCouplingUMesh *> ret(parts.size());
+  for(std::size_t i=0;i<parts.size();i++)
+    ret[i]=static_cast<MEDCouplingUMesh *>(parts[i]);
+  return ret;
+}
+
+/*!
+ * Returns the global mesh gathering all the parts of the distributed mesh \a meshPtr.
+ * The parts are fetched concurrently, then merged, and the nodes shared by several parts are merged once at the end with
+ * precision \a eps.
+ */
+MEDCouplingUMesh *ParaMEDCouplingUMeshClient::New(SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr meshPtr, double eps)
+{
+  std::vector<MEDCouplingUMesh *> parts=NewParts(meshPtr);
+  std::vector<const MEDCouplingUMesh *> partsC(parts.begin(),parts.end());
+  MEDCouplingUMesh *ret=0;
+  try
+    {
+      ret=MEDCouplingUMesh::MergeUMeshes(partsC);
+      bool areNodesMerged;
+      mcIdType newNbOfNodes;
+      DataArrayIdType *o2n=ret->mergeNodes(eps,areNodesMerged,newNbOfNodes);
+      o2n->decrRef();
+    }
+  catch(...)
+    {
+      if(ret)
+        ret->decrRef();
+      for(std::vector<MEDCouplingUMesh *>::const_iterator it=parts.begin();it!=parts.end();it++)
+        (*it)->decrRef();
+      throw;
+    }
+  for(std::vector<MEDCouplingUMesh *>::const_iterator it=parts.begin();it!=parts.end();it++)
+    (*it)->decrRef();
+  return ret;
+}
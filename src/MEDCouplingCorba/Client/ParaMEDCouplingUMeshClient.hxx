@@ -0,0 +1,45 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __PARAMEDCOUPLINGUMESHCLIENT_HXX__
+#define __PARAMEDCOUPLINGUMESHCLIENT_HXX__
+
+#include "SALOMEconfig.h"
+#ifdef WIN32
+#define NOMINMAX
+#endif
+#include CORBA_SERVER_HEADER(ParaMEDCouplingCorbaServant)
+#include "MEDCouplingClient.hxx"
+
+#include <vector>
+
+namespace MEDCoupling
+{
+  class MEDCouplingUMesh;
+
+  class MEDCOUPLINGCLIENT_EXPORT ParaMEDCouplingUMeshClient
+  {
+  public:
+    static std::vector<MEDCouplingUMesh *> NewParts(SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr mesh);
+    static MEDCouplingUMesh *New(SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr mesh, double eps=1e-12);
+  };
+}
+
+#endif
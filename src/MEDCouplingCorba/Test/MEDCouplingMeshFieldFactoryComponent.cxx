@@ -790,6 +790,67 @@ namespace SALOME_TEST
     return ret;
   }
 
+  /*!
+   * build2DMesh split in 3 parts of 1, 2 and 2 cells, as published by 3 ranks. Each part only has the nodes of its
+   * cells, the nodes at the boundary of two parts being duplicated.
+   */
+  std::vector<MEDCoupling::MEDCouplingUMesh *> MEDCouplingCorbaServBasicsTest::build2DMeshParts()
+  {
+    const mcIdType partBounds[4]={0,1,3,5};
+    MEDCoupling::MEDCouplingUMesh *mesh=build2DMesh();
+    std::vector<MEDCoupling::MEDCouplingUMesh *> ret(3);
+    for(int i=0;i<3;i++)
+      {
+        std::vector<mcIdType> ids;
+        for(mcIdType j=partBounds[i];j<partBounds[i+1];j++)
+          ids.push_back(j);
+        ret[i]=mesh->buildPartOfMySelf(&ids[0],&ids[0]+ids.size(),false);
+      }
+    mesh->decrRef();
+    return ret;
+  }
+
+  MEDCoupling::MEDCouplingFieldDouble *MEDCouplingCorbaServBasicsTest::buildFieldScalarOn2DPara()
+  {
+    MEDCoupling::MEDCouplingUMesh *mesh=build2DMesh();
+    MEDCoupling::MEDCouplingFieldDouble *fieldOnCells=MEDCoupling::MEDCouplingFieldDouble::New(MEDCoupling::ON_CELLS,MEDCoupling::NO_TIME);
+    fieldOnCells->setName("titi");
+    fieldOnCells->setMesh(mesh);
+    MEDCoupling::DataArrayDouble *array=MEDCoupling::DataArrayDouble::New();
+    array->alloc(mesh->getNumberOfCells(),2);
+    fieldOnCells->setArray(array);
+    double *tmp=array->getPointer();
+    array->decrRef();
+    for(mcIdType i=0;i<mesh->getNumberOfCells();i++)
+      {
+        tmp[2*i]=10.*(double)i;
+        tmp[2*i+1]=10.*(double)i+1.;
+      }
+    mesh->decrRef();
+    fieldOnCells->checkConsistencyLight();
+    return fieldOnCells;
+  }
+
+  //! buildFieldScalarOn2DPara on the parts of build2DMeshParts
+  std::vector<MEDCoupling::MEDCouplingFieldDouble *> MEDCouplingCorbaServBasicsTest::buildFieldScalarOn2DParaParts()
+  {
+    const mcIdType partBounds[4]={0,1,3,5};
+    MEDCoupling::MEDCouplingFieldDouble *field=buildFieldScalarOn2DPara();
+    std::vector<MEDCoupling::MEDCouplingUMesh *> meshes=build2DMeshParts();
+    std::vector<MEDCoupling::MEDCouplingFieldDouble *> ret(3);
+    for(int i=0;i<3;i++)
+      {
+        std::vector<mcIdType> ids;
+        for(mcIdType j=partBounds[i];j<partBounds[i+1];j++)
+          ids.push_back(j);
+        ret[i]=field->buildSubPart(&ids[0],&ids[0]+ids.size());
+        ret[i]->setMesh(meshes[i]);
+        meshes[i]->decrRef();
+      }
+    field->decrRef();
+    return ret;
+  }
+
   std::string MEDCouplingCorbaServBasicsTest::buildFileNameForIOR()
   {
     std::string tmpdir;
@@ -24,6 +24,7 @@
 #include "MCType.hxx"
 
 #include <string>
+#include <vector>
 
 namespace MEDCoupling
 {
@@ -81,6 +82,9 @@ namespace SALOME_TEST
     static MEDCoupling::DataArrayInt *buildArrayInt2();
     static MEDCoupling::DataArrayInt *buildArrayInt3();
     static MEDCoupling::MEDCouplingFieldOverTime *buildMultiFields2();
+    static std::vector<MEDCoupling::MEDCouplingUMesh *> build2DMeshParts();
+    static MEDCoupling::MEDCouplingFieldDouble *buildFieldScalarOn2DPara();
+    static std::vector<MEDCoupling::MEDCouplingFieldDouble *> buildFieldScalarOn2DParaParts();
     static std::string buildFileNameForIOR();
   };
 }
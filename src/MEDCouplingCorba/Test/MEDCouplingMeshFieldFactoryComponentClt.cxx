@@ -43,9 +43,38 @@
 #include "MEDCouplingFieldOverTimeClient.hxx"
 #include "DataArrayDoubleClient.hxx"
 #include "DataArrayIntClient.hxx"
+#include "ParaMEDCouplingUMeshClient.hxx"
+#include "ParaMEDCouplingFieldDoubleClient.hxx"
+#include "ParaMEDCouplingPartsFetcher.hxx"
+#include "MCAuto.hxx"
 #include <fstream>
+#include <vector>
 #include <pthread.h>
 
+namespace
+{
+  MEDCoupling::RefCountObject *FetchUMeshPartForTest(CORBA::Object_ptr part)
+  {
+    SALOME_MED::MEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::MEDCouplingUMeshCorbaInterface::_narrow(part);
+    return MEDCoupling::MEDCouplingUMeshClient::New(meshPtr);
+  }
+
+  //! Checks that \a mesh is \a refMesh up to the numbering of the nodes : same cells, in the same order, on the same points
+  void CheckSameCells(const MEDCoupling::MEDCouplingUMesh *refMesh, const MEDCoupling::MEDCouplingUMesh *mesh)
+  {
+    CPPUNIT_ASSERT_EQUAL(refMesh->getNumberOfCells(),mesh->getNumberOfCells());
+    CPPUNIT_ASSERT_EQUAL(refMesh->getNumberOfNodes(),mesh->getNumberOfNodes());
+    for(mcIdType i=0;i<refMesh->getNumberOfCells();i++)
+      CPPUNIT_ASSERT_EQUAL(refMesh->getTypeOfCell(i),mesh->getTypeOfCell(i));
+    MEDCoupling::MCAuto<MEDCoupling::DataArrayDouble> refCenters(refMesh->computeCellCenterOfMass());
+    MEDCoupling::MCAuto<MEDCoupling::DataArrayDouble> centers(mesh->computeCellCenterOfMass());
+    CPPUNIT_ASSERT(refCenters->isEqual(*centers,1e-12));
+    MEDCoupling::MCAuto<MEDCoupling::MEDCouplingFieldDouble> refAreas(refMesh->getMeasureField(true));
+    MEDCoupling::MCAuto<MEDCoupling::MEDCouplingFieldDouble> areas(mesh->getMeasureField(true));
+    CPPUNIT_ASSERT(refAreas->getArray()->isEqual(*areas->getArray(),1e-12));
+  }
+}
+
 SALOME_TEST::MEDCouplingMeshFieldFactory_ptr SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::_objC;
 
 MEDCoupling::MEDCouplingUMesh *SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::_mesh_from_distant=0;
@@ -655,6 +684,89 @@ void SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::checkCorbaMultiFields2()
   fotc->decrRef();
 }
 
+/*!
+ * Distributed mesh in 3 parts : fetching of the parts, and merging with the nodes at the boundaries of the parts.
+ */
+void SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::checkCorbaFetchingParaMesh()
+{
+  SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr meshPtr=_objC->get2DParaMesh();
+  std::vector<MEDCoupling::MEDCouplingUMesh *> refParts=SALOME_TEST::MEDCouplingCorbaServBasicsTest::build2DMeshParts();
+  // the parts, in rank order
+  std::vector<MEDCoupling::RefCountObject *> parts=MEDCoupling::ParaMEDCouplingPartsFetcher::FetchAll(meshPtr,FetchUMeshPartForTest);
+  CPPUNIT_ASSERT_EQUAL(refParts.size(),parts.size());
+  for(std::size_t i=0;i<parts.size();i++)
+    {
+      MEDCoupling::MEDCouplingUMesh *part=static_cast<MEDCoupling::MEDCouplingUMesh *>(parts[i]);
+      CPPUNIT_ASSERT(part->isEqual(refParts[i],1e-12));
+      part->decrRef();
+    }
+  std::vector<MEDCoupling::MEDCouplingUMesh *> parts2=MEDCoupling::ParaMEDCouplingUMeshClient::NewParts(meshPtr);
+  CPPUNIT_ASSERT_EQUAL(refParts.size(),parts2.size());
+  for(std::size_t i=0;i<parts2.size();i++)
+    {
+      CPPUNIT_ASSERT(parts2[i]->isEqual(refParts[i],1e-12));
+      parts2[i]->decrRef();
+    }
+  // the merged mesh : the duplicated nodes are merged
+  mcIdType nbOfNodesInParts(0);
+  for(std::size_t i=0;i<refParts.size();i++)
+    {
+      nbOfNodesInParts+=refParts[i]->getNumberOfNodes();
+      refParts[i]->decrRef();
+    }
+  MEDCoupling::MCAuto<MEDCoupling::MEDCouplingUMesh> meshCpp(MEDCoupling::ParaMEDCouplingUMeshClient::New(meshPtr));
+  MEDCoupling::MCAuto<MEDCoupling::MEDCouplingUMesh> refMesh(SALOME_TEST::MEDCouplingCorbaServBasicsTest::build2DMesh());
+  CPPUNIT_ASSERT(nbOfNodesInParts>refMesh->getNumberOfNodes());
+  CheckSameCells(refMesh,meshCpp);
+  meshPtr->UnRegister();
+  CORBA::release(meshPtr);
+}
+
+/*!
+ * The object of a rank is not a mesh : fetching fails with an INTERP_KERNEL::Exception, and the object is still usable.
+ */
+void SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::checkCorbaFetchingParaMeshBrokenPart()
+{
+  SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr meshPtr=_objC->get2DParaMeshWithBrokenPart();
+  CPPUNIT_ASSERT_THROW(MEDCoupling::ParaMEDCouplingPartsFetcher::FetchAll(meshPtr,FetchUMeshPartForTest),INTERP_KERNEL::Exception);
+  CPPUNIT_ASSERT_THROW(MEDCoupling::ParaMEDCouplingUMeshClient::NewParts(meshPtr),INTERP_KERNEL::Exception);
+  CPPUNIT_ASSERT_THROW(MEDCoupling::ParaMEDCouplingUMeshClient::New(meshPtr),INTERP_KERNEL::Exception);
+  // the failures left the object usable
+  MEDCoupling::MCAuto<MEDCoupling::MEDCouplingUMesh> part0(MEDCoupling::MEDCouplingUMeshClient::New(meshPtr));
+  std::vector<MEDCoupling::MEDCouplingUMesh *> refParts=SALOME_TEST::MEDCouplingCorbaServBasicsTest::build2DMeshParts();
+  CPPUNIT_ASSERT(part0->isEqual(refParts[0],1e-12));
+  for(std::size_t i=0;i<refParts.size();i++)
+    refParts[i]->decrRef();
+  meshPtr->UnRegister();
+  CORBA::release(meshPtr);
+}
+
+/*!
+ * Distributed field in 3 parts : NewParts and New, the values being in the order of the cells of the global mesh.
+ */
+void SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::checkCorbaFetchingParaField()
+{
+  SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr=_objC->getFieldScalarOn2DPara();
+  std::vector<MEDCoupling::MEDCouplingFieldDouble *> refParts=SALOME_TEST::MEDCouplingCorbaServBasicsTest::buildFieldScalarOn2DParaParts();
+  std::vector<MEDCoupling::MEDCouplingFieldDouble *> parts=MEDCoupling::ParaMEDCouplingFieldDoubleClient::NewParts(fieldPtr);
+  CPPUNIT_ASSERT_EQUAL(refParts.size(),parts.size());
+  for(std::size_t i=0;i<parts.size();i++)
+    {
+      CPPUNIT_ASSERT(parts[i]->isEqual(refParts[i],1e-12,1e-15));
+      parts[i]->decrRef();
+      refParts[i]->decrRef();
+    }
+  MEDCoupling::MCAuto<MEDCoupling::MEDCouplingFieldDouble> fieldCpp(MEDCoupling::ParaMEDCouplingFieldDoubleClient::New(fieldPtr));
+  MEDCoupling::MCAuto<MEDCoupling::MEDCouplingFieldDouble> refField(SALOME_TEST::MEDCouplingCorbaServBasicsTest::buildFieldScalarOn2DPara());
+  CPPUNIT_ASSERT_EQUAL(std::string(refField->getName()),std::string(fieldCpp->getName()));
+  CPPUNIT_ASSERT(refField->getArray()->isEqual(*fieldCpp->getArray(),1e-12));
+  const MEDCoupling::MEDCouplingUMesh *mesh=dynamic_cast<const MEDCoupling::MEDCouplingUMesh *>(fieldCpp->getMesh());
+  CPPUNIT_ASSERT(mesh!=0);
+  CheckSameCells(dynamic_cast<const MEDCoupling::MEDCouplingUMesh *>(refField->getMesh()),mesh);
+  fieldPtr->UnRegister();
+  CORBA::release(fieldPtr);
+}
+
 void SALOME_TEST::MEDCouplingCorbaServBasicsTestClt::shutdownServer()
 {
   _objC->shutdownOrb();
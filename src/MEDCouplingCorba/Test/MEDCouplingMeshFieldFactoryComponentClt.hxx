@@ -81,6 +81,9 @@ namespace SALOME_TEST
     CPPUNIT_TEST( checkCorbaArrayInt3 );
     CPPUNIT_TEST( checkCorbaFetchingCoords1 );
     CPPUNIT_TEST( checkCorbaMultiFields2 );
+    CPPUNIT_TEST( checkCorbaFetchingParaMesh );
+    CPPUNIT_TEST( checkCorbaFetchingParaMeshBrokenPart );
+    CPPUNIT_TEST( checkCorbaFetchingParaField );
     CPPUNIT_TEST( shutdownServer );
     CPPUNIT_TEST_SUITE_END();
   public:
@@ -126,6 +129,9 @@ namespace SALOME_TEST
     void checkCorbaArrayInt3();
     void checkCorbaFetchingCoords1();
     void checkCorbaMultiFields2();
+    void checkCorbaFetchingParaMesh();
+    void checkCorbaFetchingParaMeshBrokenPart();
+    void checkCorbaFetchingParaField();
     void shutdownServer();
   private:
     static void *checkCorbaField2DNTMultiFetchingMTStatic(void *stack);
@@ -44,6 +44,60 @@
 #include "MEDCouplingCMesh.hxx"
 #include "MEDCouplingIMesh.hxx"
 
+#include <vector>
+
+namespace
+{
+  //! Releases the parts of ranks 1 to n-1 of a distributed object published by this process
+  void UnRegisterOtherParts(const Engines::IORTab& tior)
+  {
+    for(CORBA::ULong ip=1;ip<tior.length();ip++)
+      {
+        SALOME_MED::MEDCouplingRefCountCorbaInterface_var part=SALOME_MED::MEDCouplingRefCountCorbaInterface::_narrow(tior[ip]);
+        part->UnRegister();
+      }
+  }
+
+  /*!
+   * Distributed mesh whose parts are all published by this process, without MPI : this servant holds the part of rank 0
+   * and lists all the parts in tior, as ParaMEDCouplingUMeshServant does. The other parts are released with it.
+   */
+  class ParaMEDCouplingUMeshPartsServant : public virtual POA_SALOME_MED::ParaMEDCouplingUMeshCorbaInterface,
+                                           public MEDCoupling::MEDCouplingUMeshServant
+  {
+  public:
+    ParaMEDCouplingUMeshPartsServant(const MEDCoupling::MEDCouplingUMesh *part0):MEDCoupling::MEDCouplingUMeshServant(part0) { }
+    Engines::IORTab *tior() { return new Engines::IORTab(_tior); }
+    void tior(const Engines::IORTab& ior) { _tior=ior; }
+    void UnRegister()
+    {
+      if(_ref_counter==1)
+        UnRegisterOtherParts(_tior);
+      MEDCoupling::MEDCouplingUMeshServant::UnRegister();
+    }
+  private:
+    Engines::IORTab _tior;
+  };
+
+  //! Same as ParaMEDCouplingUMeshPartsServant for a field
+  class ParaMEDCouplingFieldDoublePartsServant : public virtual POA_SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface,
+                                                 public MEDCoupling::MEDCouplingFieldDoubleServant
+  {
+  public:
+    ParaMEDCouplingFieldDoublePartsServant(const MEDCoupling::MEDCouplingFieldDouble *part0):MEDCoupling::MEDCouplingFieldDoubleServant(part0) { }
+    Engines::IORTab *tior() { return new Engines::IORTab(_tior); }
+    void tior(const Engines::IORTab& ior) { _tior=ior; }
+    void UnRegister()
+    {
+      if(_ref_counter==1)
+        UnRegisterOtherParts(_tior);
+      MEDCoupling::MEDCouplingFieldDoubleServant::UnRegister();
+    }
+  private:
+    Engines::IORTab _tior;
+  };
+}
+
 namespace SALOME_TEST
 {
   MEDCouplingMeshFieldFactoryComponent::MEDCouplingMeshFieldFactoryComponent(CORBA::ORB_ptr orb):_orb(orb)
@@ -362,4 +416,65 @@ namespace SALOME_TEST
     fot->decrRef();
     return retServ->_this();
   }
+
+  SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr MEDCouplingMeshFieldFactoryComponent::get2DParaMesh()
+  {
+    return build2DParaMesh(false);
+  }
+
+  SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr MEDCouplingMeshFieldFactoryComponent::get2DParaMeshWithBrokenPart()
+  {
+    return build2DParaMesh(true);
+  }
+
+  /*!
+   * The parts of build2DMeshParts on 3 ranks. If \a withBrokenPart, the object of rank 1 is an array instead of a mesh.
+   */
+  SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr MEDCouplingMeshFieldFactoryComponent::build2DParaMesh(bool withBrokenPart)
+  {
+    std::vector<MEDCoupling::MEDCouplingUMesh *> parts=MEDCouplingCorbaServBasicsTest::build2DMeshParts();
+    ParaMEDCouplingUMeshPartsServant *m=new ParaMEDCouplingUMeshPartsServant(parts[0]);
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr ret=m->_this();
+    Engines::IORTab tior;
+    tior.length((CORBA::ULong)parts.size());
+    tior[0]=SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_duplicate(ret);
+    for(std::size_t ip=1;ip<parts.size();ip++)
+      {
+        if(withBrokenPart && ip==1)
+          {
+            MEDCoupling::DataArrayDouble *retCpp=MEDCouplingCorbaServBasicsTest::buildArrayDouble1();
+            MEDCoupling::DataArrayDoubleServant *retServ=new MEDCoupling::DataArrayDoubleServant(retCpp);
+            retCpp->decrRef();
+            tior[(CORBA::ULong)ip]=retServ->_this();
+          }
+        else
+          {
+            MEDCoupling::MEDCouplingUMeshServant *p=new MEDCoupling::MEDCouplingUMeshServant(parts[ip]);
+            tior[(CORBA::ULong)ip]=p->_this();
+          }
+      }
+    m->tior(tior);
+    for(std::size_t ip=0;ip<parts.size();ip++)
+      parts[ip]->decrRef();
+    return ret;
+  }
+
+  SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr MEDCouplingMeshFieldFactoryComponent::getFieldScalarOn2DPara()
+  {
+    std::vector<MEDCoupling::MEDCouplingFieldDouble *> parts=MEDCouplingCorbaServBasicsTest::buildFieldScalarOn2DParaParts();
+    ParaMEDCouplingFieldDoublePartsServant *f=new ParaMEDCouplingFieldDoublePartsServant(parts[0]);
+    SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr ret=f->_this();
+    Engines::IORTab tior;
+    tior.length((CORBA::ULong)parts.size());
+    tior[0]=SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_duplicate(ret);
+    for(std::size_t ip=1;ip<parts.size();ip++)
+      {
+        MEDCoupling::MEDCouplingFieldDoubleServant *p=new MEDCoupling::MEDCouplingFieldDoubleServant(parts[ip]);
+        tior[(CORBA::ULong)ip]=p->_this();
+      }
+    f->tior(tior);
+    for(std::size_t ip=0;ip<parts.size();ip++)
+      parts[ip]->decrRef();
+    return ret;
+  }
 }
@@ -75,6 +75,11 @@ namespace SALOME_TEST
     SALOME_MED::DataArrayIntCorbaInterface_ptr getArrayInt2();
     SALOME_MED::DataArrayIntCorbaInterface_ptr getArrayInt3();
     SALOME_MED::MEDCouplingFieldOverTimeCorbaInterface_ptr getMultiFields2();
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr get2DParaMesh();
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr get2DParaMeshWithBrokenPart();
+    SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr getFieldScalarOn2DPara();
+  private:
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_ptr build2DParaMesh(bool withBrokenPart);
   private:
     CORBA::ORB_ptr _orb;
   };
@@ -69,6 +69,115 @@ Py_EncodeLocale(const wchar_t *text, size_t *error_pos)
 #endif
 %}
 
+#ifdef WITH_NUMPY
+%{
+static CORBA::Object_ptr ConvertPyCorbaRefToCpp(PyObject *pyPtr, const char *msgIfFailure)
+{
+  PyObject* pdict=PyDict_New();
+  PyDict_SetItemString(pdict,"__builtins__",PyEval_GetBuiltins());
+  PyRun_String("from salome.kernel import MEDCouplingCorbaServant_idl",Py_single_input,pdict, pdict);
+  PyRun_String("import CORBA",Py_single_input,pdict, pdict);
+  PyRun_String("orbTmp15634=CORBA.ORB_init([''])", Py_single_input,pdict, pdict);
+  PyObject *orbPython=PyDict_GetItemString(pdict,"orbTmp15634");
+  PyObject *iorPy=PyObject_CallMethod(orbPython,(char*)"object_to_string",(char*)"O",pyPtr);
+  if(!iorPy)
+    {
+      Py_DECREF(pdict);
+      throw INTERP_KERNEL::Exception(msgIfFailure);
+    }
+  wchar_t *iorW=PyUnicode_AsWideCharString(iorPy,NULL);
+  char *ior=iorW?Py_EncodeLocale(iorW,NULL):0;
+  PyMem_Free(iorW);
+  Py_DECREF(pdict);
+  Py_DECREF(iorPy);
+  if(!ior)
+    {
+      PyErr_Clear();
+      throw INTERP_KERNEL::Exception(msgIfFailure);
+    }
+  int argc=0;
+  CORBA::ORB_var orb=CORBA::ORB_init(argc,0);
+  CORBA::Object_ptr ret=orb->string_to_object(ior);
+  PyMem_Free(ior);
+  return ret;
+}
+
+static void FreeCorbaDoubleBuffer(PyObject *capsule)
+{
+  SALOME_TYPES::ListOfDouble::freebuf((CORBA::Double *)PyCapsule_GetPointer(capsule,"MEDCouplingClient.CorbaDoubleBuffer"));
+}
+
+/*!
+ * Returns a numpy array of shape (nbOfTuples,nbOfCompo) over the content of the CORBA reply \a seq.
+ * If \a out is a numpy array, the reply is copied once into it and \a out is returned. \a out must be a C contiguous
+ * and writable float64 array of nbOfTuples*nbOfCompo elements.
+ * Otherwise the buffer of \a seq is orphaned and becomes the memory of the returned array, without any copy. If \a seq
+ * doesn't own its buffer, it can't be orphaned and is copied into a new array.
+ */
+static PyObject *BuildNumPyArrayFromCorbaReply(SALOME_TYPES::ListOfDouble& seq, npy_intp nbOfTuples, npy_intp nbOfCompo, PyObject *out)
+{
+  npy_intp lgth=(npy_intp)seq.length();
+  if(lgth!=nbOfTuples*nbOfCompo)
+    throw INTERP_KERNEL::Exception("BuildNumPyArrayFromCorbaReply : size of CORBA reply mismatches the number of tuples and components !");
+  if(out && out!=Py_None)
+    {
+      if(!PyArray_Check(out))
+        throw INTERP_KERNEL::Exception("BuildNumPyArrayFromCorbaReply : out parameter is expected to be a numpy array !");
+      PyArrayObject *outC=(PyArrayObject *)out;
+      if(PyArray_TYPE(outC)!=NPY_DOUBLE || !PyArray_ISCARRAY(outC) || PyArray_SIZE(outC)!=lgth)
+        throw INTERP_KERNEL::Exception("BuildNumPyArrayFromCorbaReply : out parameter is expected to be a C contiguous writable float64 numpy array with the right number of elements !");
+      if(lgth!=0)
+        std::copy(seq.get_buffer(),seq.get_buffer()+lgth,(double *)PyArray_DATA(outC));
+      Py_INCREF(out);
+      return out;
+    }
+  npy_intp dims[2]={nbOfTuples,nbOfCompo};
+  if(lgth==0)
+    return PyArray_SimpleNew(2,dims,NPY_DOUBLE);
+  CORBA::Double *buf=seq.get_buffer(true);
+  if(!buf)
+    {
+      PyObject *ret=PyArray_SimpleNew(2,dims,NPY_DOUBLE);
+      if(ret)
+        std::copy(seq.get_buffer(),seq.get_buffer()+lgth,(double *)PyArray_DATA((PyArrayObject *)ret));
+      return ret;
+    }
+  PyObject *ret=PyArray_SimpleNewFromData(2,dims,NPY_DOUBLE,buf);
+  if(!ret)
+    {
+      SALOME_TYPES::ListOfDouble::freebuf(buf);
+      return 0;
+    }
+  PyObject *capsule=PyCapsule_New(buf,"MEDCouplingClient.CorbaDoubleBuffer",FreeCorbaDoubleBuffer);
+  PyArray_SetBaseObject((PyArrayObject *)ret,capsule);
+  return ret;
+}
+
+/*!
+ * Returns the content of the distant array \a arrPtr as a numpy array, without building a DataArrayDouble.
+ * See BuildNumPyArrayFromCorbaReply for the meaning of \a out.
+ */
+static PyObject *FetchDataArrayDoubleAsNumPy(SALOME_MED::DataArrayDoubleCorbaInterface_ptr arrPtr, PyObject *out)
+{
+  SALOME_TYPES::ListOfLong_var tinyL;
+  SALOME_TYPES::ListOfString_var tinyS;
+  SALOME_TYPES::ListOfDouble_var data;
+  arrPtr->Register();
+  arrPtr->getTinyInfo(tinyL,tinyS);
+  npy_intp nbOfTuples=tinyL->length()>=2?(npy_intp)tinyL[0]:-1;
+  npy_intp nbOfCompo=tinyL->length()>=2?(npy_intp)tinyL[1]:-1;
+  if(nbOfTuples<0 || nbOfCompo<0)
+    {
+      arrPtr->UnRegister();
+      throw INTERP_KERNEL::Exception("FetchDataArrayDoubleAsNumPy : distant array is not allocated !");
+    }
+  arrPtr->getSerialisationData(data);
+  arrPtr->UnRegister();
+  return BuildNumPyArrayFromCorbaReply(data.inout(),nbOfTuples,nbOfCompo,out);
+}
+%}
+#endif
+
 
 namespace MEDCoupling
 {
@@ -77,6 +186,70 @@ namespace MEDCoupling
   public:
     %extend
       {
+#ifdef WITH_NUMPY
+        /*!
+         * Returns the tuple (values,coords) of numpy arrays over the values of the distant field \a fieldPtr and the coordinates
+         * of its mesh, without building any MEDCouplingFieldDouble. coords is None if the mesh has no explicit coordinates.
+         * For fields with several arrays (linear time) only the first one is returned.
+         * If \a out is given, the values are copied once into this preallocated numpy array, else no copy is done.
+         */
+        static PyObject *NewNumPyViews(PyObject *fieldPtr, PyObject *out=0) throw(INTERP_KERNEL::Exception)
+        {
+          CORBA::Object_var fieldPtrCpp=ConvertPyCorbaRefToCpp(fieldPtr,"Error : the input parameter of MEDCouplingFieldDoubleClient.NewNumPyViews appears to differ from CORBA reference ! Expecting a FieldDouble CORBA reference !");
+          SALOME_MED::MEDCouplingFieldDoubleCorbaInterface_var fieldPtrCppC=SALOME_MED::MEDCouplingFieldDoubleCorbaInterface::_narrow(fieldPtrCpp);
+          if(CORBA::is_nil(fieldPtrCppC))
+            throw INTERP_KERNEL::Exception("error corba pointer is not a SALOME_MED.MEDCouplingFieldDoubleCorbaInterface_ptr !");
+          fieldPtrCppC->Register();
+          PyObject *values(0),*coords(0);
+          try
+            {
+              SALOME_TYPES::ListOfString_var compos=fieldPtrCppC->getInfoOnComponents();
+              SALOME_TYPES::ListOfLong_var bigArr0;
+              SALOME_TYPES::ListOfDouble2_var bigArr;
+              fieldPtrCppC->getSerialisationData(bigArr0,bigArr);
+              if(bigArr->length()==0)
+                throw INTERP_KERNEL::Exception("MEDCouplingFieldDoubleClient.NewNumPyViews : distant field has no array !");
+              npy_intp nbOfCompo=(npy_intp)compos->length();
+              npy_intp nbOfTuples=nbOfCompo!=0?(npy_intp)bigArr[(CORBA::ULong)0].length()/nbOfCompo:0;
+              values=BuildNumPyArrayFromCorbaReply(bigArr[(CORBA::ULong)0],nbOfTuples,nbOfCompo,out);
+              SALOME_MED::MEDCouplingMeshCorbaInterface_var meshPtr=fieldPtrCppC->getMesh();
+              SALOME_MED::MEDCouplingPointSetCorbaInterface_var psPtr=SALOME_MED::MEDCouplingPointSetCorbaInterface::_narrow(meshPtr);
+              if(!CORBA::is_nil(psPtr))
+                {
+                  SALOME_MED::DataArrayDoubleCorbaInterface_var coordsPtr=psPtr->getCoords();
+                  try
+                    {
+                      coords=FetchDataArrayDoubleAsNumPy(coordsPtr,0);
+                    }
+                  catch(...)
+                    {
+                      coordsPtr->UnRegister();
+                      meshPtr->UnRegister();
+                      throw;
+                    }
+                  coordsPtr->UnRegister();
+                }
+              meshPtr->UnRegister();
+            }
+          catch(...)
+            {
+              Py_XDECREF(values);
+              fieldPtrCppC->UnRegister();
+              throw;
+            }
+          fieldPtrCppC->UnRegister();
+          if(!coords)
+            {
+              Py_INCREF(Py_None);
+              coords=Py_None;
+            }
+          PyObject *ret=PyTuple_New(2);
+          PyTuple_SetItem(ret,0,values);
+          PyTuple_SetItem(ret,1,coords);
+          return ret;
+        }
+#endif
+
         static MEDCouplingFieldDouble *New(PyObject *fieldPtr) throw(INTERP_KERNEL::Exception)
         {
           PyObject* pdict=PyDict_New();
@@ -505,6 +678,22 @@ namespace MEDCoupling
   public:
     %extend
       {
+#ifdef WITH_NUMPY
+        /*!
+         * Returns a numpy array of shape (nbOfTuples,nbOfComponents) with the content of the distant array \a arrPtr,
+         * without building any DataArrayDouble. If \a out is given, the content is copied once into this preallocated numpy array,
+         * else the returned array directly owns the memory of the CORBA reply.
+         */
+        static PyObject *NewNumPyArray(PyObject *arrPtr, PyObject *out=0) throw(INTERP_KERNEL::Exception)
+        {
+          CORBA::Object_var arrPtrCpp=ConvertPyCorbaRefToCpp(arrPtr,"Error : the input parameter of DataArrayDoubleClient.NewNumPyArray appears to differ from CORBA reference ! Expecting a DataArrayDoubleCorbaInterface CORBA reference !");
+          SALOME_MED::DataArrayDoubleCorbaInterface_var arrPtrCppC=SALOME_MED::DataArrayDoubleCorbaInterface::_narrow(arrPtrCpp);
+          if(CORBA::is_nil(arrPtrCppC))
+            throw INTERP_KERNEL::Exception("error corba pointer is not a SALOME_MED.DataArrayDoubleInterface_ptr ");
+          return FetchDataArrayDoubleAsNumPy(arrPtrCppC,out);
+        }
+#endif
+
         static DataArrayDouble *New(PyObject *meshPtr) throw(INTERP_KERNEL::Exception)
         {
           PyObject* pdict=PyDict_New();
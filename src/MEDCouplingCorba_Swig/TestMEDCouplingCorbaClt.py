@@ -422,6 +422,33 @@ class MEDCouplingCorbaServBasicsTestClt(unittest.TestCase):
             self.assertAlmostEqual(expected[i],ts[i],12);
         pass
     
+    @unittest.skipUnless(MEDCouplingHasNumPyBindings(),"requires numpy")
+    def testCorbaNumPyArray1(self):
+        arrPtr=self._objC.getArrayDouble1()
+        arr=DataArrayDoubleClient.NewNumPyArray(arrPtr)
+        test=MEDCouplingCorbaSwigTest.MEDCouplingCorbaServBasicsTest()
+        ref=test.buildArrayDouble1()
+        self.assertEqual((ref.getNumberOfTuples(),ref.getNumberOfComponents()),arr.shape)
+        self.assertTrue(ref.isEqual(DataArrayDouble(arr.copy()),1e-14))
+        import numpy
+        out=numpy.zeros(arr.shape,dtype=numpy.float64)
+        out2=DataArrayDoubleClient.NewNumPyArray(arrPtr,out)
+        arrPtr.UnRegister()
+        self.assertTrue(out2 is out)
+        self.assertTrue(ref.isEqual(DataArrayDouble(out.copy()),1e-14))
+        pass
+
+    @unittest.skipUnless(MEDCouplingHasNumPyBindings(),"requires numpy")
+    def testCorbaNumPyField1(self):
+        fieldPtr=self._objC.getFieldScalarOn3DSurfWT()
+        vals,coords=MEDCouplingFieldDoubleClient.NewNumPyViews(fieldPtr)
+        fieldPtr.UnRegister()
+        test=MEDCouplingCorbaSwigTest.MEDCouplingCorbaServBasicsTest()
+        refField=test.buildFieldScalarOn3DSurfWT()
+        self.assertTrue(refField.getArray().isEqual(DataArrayDouble(vals.copy()),1e-14))
+        self.assertTrue(refField.getMesh().getCoords().isEqual(DataArrayDouble(coords.copy()),1e-14))
+        pass
+    
     def testShutdownServer(self):
         self._objC.shutdownOrb()
         pass
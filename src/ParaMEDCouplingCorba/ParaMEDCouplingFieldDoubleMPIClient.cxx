@@ -0,0 +1,463 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "ParaMEDCouplingFieldDoubleMPIClient.hxx"
+#include "MEDCouplingFieldDoubleClient.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingUMesh.hxx"
+#include "MCAuto.hxx"
+#include "InterpKernelException.hxx"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  template<class T>
+  void PackArray(std::vector<char>& buf, const T *pt, std::size_t nb)
+  {
+    long long nbl=(long long)nb;
+    const char *b=reinterpret_cast<const char *>(&nbl);
+    buf.insert(buf.end(),b,b+sizeof(long long));
+    if(nb==0)
+      return ;
+    const char *d=reinterpret_cast<const char *>(pt);
+    buf.insert(buf.end(),d,d+nb*sizeof(T));
+  }
+
+  template<class T>
+  void PackVector(std::vector<char>& buf, const std::vector<T>& v)
+  {
+    PackArray(buf,v.empty()?(const T *)0:&v[0],v.size());
+  }
+
+  void PackStrings(std::vector<char>& buf, const std::vector<std::string>& v)
+  {
+    long long nbl=(long long)v.size();
+    PackArray(buf,&nbl,1);
+    for(std::vector<std::string>::const_iterator it=v.begin();it!=v.end();it++)
+      PackArray(buf,(*it).c_str(),(*it).length());
+  }
+
+  template<class T>
+  const char *UnpackVector(const char *pos, std::vector<T>& v)
+  {
+    long long nb;
+    std::memcpy(&nb,pos,sizeof(long long));
+    pos+=sizeof(long long);
+    v.resize(nb);
+    if(nb!=0)
+      std::memcpy(&v[0],pos,nb*sizeof(T));
+    return pos+nb*sizeof(T);
+  }
+
+  const char *UnpackStrings(const char *pos, std::vector<std::string>& v)
+  {
+    std::vector<long long> nb;
+    pos=UnpackVector(pos,nb);
+    v.resize(nb[0]);
+    for(long long i=0;i<nb[0];i++)
+      {
+        std::vector<char> st;
+        pos=UnpackVector(pos,st);
+        v[i].assign(st.begin(),st.end());
+      }
+    return pos;
+  }
+
+  template<class T>
+  void FillArray(T *pt, std::size_t nbOfElems, const std::vector<T>& v)
+  {
+    if(nbOfElems!=v.size())
+      throw INTERP_KERNEL::Exception("ParaMEDCouplingFieldDoubleMPIClient : mismatch of sizes while unpacking a field !");
+    std::copy(v.begin(),v.end(),pt);
+  }
+
+  bool PieceComparator(const std::pair<long long, MCAuto<MEDCouplingFieldDouble> >& a, const std::pair<long long, MCAuto<MEDCouplingFieldDouble> >& b)
+  {
+    return a.first<b.first;
+  }
+
+  /*!
+   * Appends to \a buf the cells of \a part with local IDs \a localIds, preceded by the ID of the part.
+   * The layout follows the tiny info/serialization data exchanged by MEDCouplingFieldDoubleServant.
+   */
+  void PackSubPart(std::vector<char>& buf, long long partId, const MEDCouplingFieldDouble *part, const std::vector<mcIdType>& localIds)
+  {
+    MCAuto<MEDCouplingFieldDouble> sub(part->buildSubPart(&localIds[0],&localIds[0]+localIds.size()));
+    MCAuto<MEDCouplingUMesh> mesh(sub->getMesh()->buildUnstructured());
+    sub->setMesh(mesh);
+    PackArray(buf,&partId,1);
+    //
+    std::vector<mcIdType> tinyI;
+    std::vector<double> tinyD;
+    std::vector<std::string> tinyS;
+    sub->getTinySerializationIntInformation(tinyI);
+    sub->getTinySerializationDbleInformation(tinyD);
+    sub->getTinySerializationStrInformation(tinyS);
+    PackVector(buf,tinyI);
+    PackVector(buf,tinyD);
+    PackStrings(buf,tinyS);
+    //
+    std::vector<double> meshTinyD;
+    std::vector<mcIdType> meshTinyI;
+    std::vector<std::string> meshTinyS;
+    mesh->getTinySerializationInformation(meshTinyD,meshTinyI,meshTinyS);
+    PackVector(buf,meshTinyD);
+    PackVector(buf,meshTinyI);
+    PackStrings(buf,meshTinyS);
+    DataArrayIdType *a1Tmp(0);
+    DataArrayDouble *a2Tmp(0);
+    mesh->serialize(a1Tmp,a2Tmp);
+    MCAuto<DataArrayIdType> a1(a1Tmp);
+    MCAuto<DataArrayDouble> a2(a2Tmp);
+    PackArray(buf,a1.isNotNull()?a1->begin():(const mcIdType *)0,a1.isNotNull()?a1->getNbOfElems():0);
+    PackArray(buf,a2.isNotNull()?a2->begin():(const double *)0,a2.isNotNull()?a2->getNbOfElems():0);
+    //
+    DataArrayIdType *dataInt(0);
+    std::vector<DataArrayDouble *> arrays;
+    sub->serialize(dataInt,arrays);
+    PackArray(buf,dataInt?dataInt->begin():(const mcIdType *)0,dataInt?dataInt->getNbOfElems():0);
+    long long nbOfArrays=(long long)arrays.size();
+    PackArray(buf,&nbOfArrays,1);
+    for(std::vector<DataArrayDouble *>::const_iterator it=arrays.begin();it!=arrays.end();it++)
+      PackArray(buf,(*it)->begin(),(*it)->getNbOfElems());
+  }
+
+  const char *UnpackSubPart(const char *pos, long long& partId, MCAuto<MEDCouplingFieldDouble>& ret)
+  {
+    std::vector<long long> pid;
+    pos=UnpackVector(pos,pid);
+    partId=pid[0];
+    //
+    std::vector<mcIdType> tinyI;
+    std::vector<double> tinyD;
+    std::vector<std::string> tinyS;
+    pos=UnpackVector(pos,tinyI);
+    pos=UnpackVector(pos,tinyD);
+    pos=UnpackStrings(pos,tinyS);
+    //
+    std::vector<double> meshTinyD;
+    std::vector<mcIdType> meshTinyI;
+    std::vector<std::string> meshTinyS;
+    std::vector<mcIdType> meshData1;
+    std::vector<double> meshData2;
+    pos=UnpackVector(pos,meshTinyD);
+    pos=UnpackVector(pos,meshTinyI);
+    pos=UnpackStrings(pos,meshTinyS);
+    pos=UnpackVector(pos,meshData1);
+    pos=UnpackVector(pos,meshData2);
+    MCAuto<MEDCouplingUMesh> mesh(MEDCouplingUMesh::New());
+    MCAuto<DataArrayIdType> a1(DataArrayIdType::New());
+    MCAuto<DataArrayDouble> a2(DataArrayDouble::New());
+    std::vector<std::string> uselessVector;
+    mesh->resizeForUnserialization(meshTinyI,a1,a2,uselessVector);
+    FillArray(a1->getPointer(),a1->getNbOfElems(),meshData1);
+    FillArray(a2->getPointer(),a2->getNbOfElems(),meshData2);
+    mesh->unserialization(meshTinyD,meshTinyI,a1,a2,meshTinyS);
+    //
+    std::vector<mcIdType> dataInt;
+    std::vector<long long> nbOfArrays;
+    pos=UnpackVector(pos,dataInt);
+    pos=UnpackVector(pos,nbOfArrays);
+    ret=MEDCouplingFieldDouble::New((TypeOfField)tinyI[0],(TypeOfTimeDiscretization)tinyI[1]);
+    ret->setMesh(mesh);
+    DataArrayIdType *array0(0);
+    std::vector<DataArrayDouble *> arrays;
+    ret->resizeForUnserialization(tinyI,array0,arrays);
+    if(array0 && !dataInt.empty())
+      FillArray(array0->getPointer(),array0->getNbOfElems(),dataInt);
+    if((long long)arrays.size()!=nbOfArrays[0])
+      throw INTERP_KERNEL::Exception("ParaMEDCouplingFieldDoubleMPIClient : mismatch of number of arrays while unpacking a field !");
+    for(std::vector<DataArrayDouble *>::const_iterator it=arrays.begin();it!=arrays.end();it++)
+      {
+        std::vector<double> data;
+        pos=UnpackVector(pos,data);
+        FillArray((*it)->getPointer(),(*it)->getNbOfElems(),data);
+      }
+    ret->finishUnserialization(tinyI,tinyD,tinyS);
+    return pos;
+  }
+
+  std::vector<int> ComputeDisplacements(const std::vector<int>& counts)
+  {
+    std::vector<int> ret(counts.size(),0);
+    for(std::size_t i=1;i<counts.size();i++)
+      ret[i]=ret[i-1]+counts[i-1];
+    return ret;
+  }
+
+  /*!
+   * Returns \a sz as a count of MPI call. If it does not fit, sets \a error and returns 0 : the caller has to
+   * agree with the other ranks on the error before the collective call.
+   */
+  int CheckedCount(std::size_t sz, std::string& error)
+  {
+    if(sz>(std::size_t)INT_MAX)
+      {
+        if(error.empty())
+          error="ParaMEDCouplingFieldDoubleMPIClient : message between two ranks exceeds 2GB ! Use more consumer ranks !";
+        return 0;
+      }
+    return (int)sz;
+  }
+}
+
+/*!
+ * The rank \c r of \a comm, made of M ranks, receives the global cells [r*n/M,(r+1)*n/M) of the distributed field \a fieldPtr
+ * holding n cells. The nodes shared by several parts are merged with precision \a eps.
+ * Returns 0 if no cell is assigned to the calling rank.
+ */
+MEDCouplingFieldDouble *ParaMEDCouplingFieldDoubleMPIClient::New(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr, MPI_Comm comm, double eps)
+{
+  std::vector< MCAuto<MEDCouplingFieldDouble> > parts;
+  FetchParts(fieldPtr,comm,parts);
+  return Redistribute(parts,comm,0,eps);
+}
+
+/*!
+ * The calling rank receives the cells of the distributed field \a fieldPtr whose global IDs are in \a globalCellIds.
+ * The returned field holds the requested cells in increasing global ID order, duplicates being ignored.
+ * The nodes shared by several parts are merged with precision \a eps.
+ * Returns 0 if \a globalCellIds is empty.
+ */
+MEDCouplingFieldDouble *ParaMEDCouplingFieldDoubleMPIClient::New(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr, MPI_Comm comm, const DataArrayIdType *globalCellIds, double eps)
+{
+  if(!globalCellIds)
+    throw INTERP_KERNEL::Exception("ParaMEDCouplingFieldDoubleMPIClient::New : null array of global cell ids !");
+  globalCellIds->checkAllocated();
+  std::vector< MCAuto<MEDCouplingFieldDouble> > parts;
+  FetchParts(fieldPtr,comm,parts);
+  return Redistribute(parts,comm,globalCellIds,eps);
+}
+
+/*!
+ * Collective on \a comm. Throws on all the ranks if \a localError is not empty on at least one of them, so that no rank is
+ * left waiting in a collective call the failing ranks will never enter. The message thrown is the one of the first failing rank.
+ */
+void ParaMEDCouplingFieldDoubleMPIClient::SynchronizeError(MPI_Comm comm, const std::string& localError)
+{
+  int failed(localError.empty()?0:1),anyFailed(0);
+  MPI_Allreduce(&failed,&anyFailed,1,MPI_INT,MPI_LOR,comm);
+  if(!anyFailed)
+    return ;
+  int rank,size;
+  MPI_Comm_rank(comm,&rank);
+  MPI_Comm_size(comm,&size);
+  int candidate(failed?rank:size),first(size);
+  MPI_Allreduce(&candidate,&first,1,MPI_INT,MPI_MIN,comm);
+  int len((int)localError.length());
+  MPI_Bcast(&len,1,MPI_INT,first,comm);
+  std::vector<char> msg(len+1,'\0');
+  if(rank==first)
+    std::copy(localError.begin(),localError.end(),msg.begin());
+  if(len>0)
+    MPI_Bcast(&msg[0],len,MPI_CHAR,first,comm);
+  throw INTERP_KERNEL::Exception(&msg[0]);
+}
+
+/*!
+ * Fetches in \a parts, of size the number of parts of \a fieldPtr, the parts \c ip such as \c ip%M is the calling rank. The other
+ * parts are left null. Throws on all the ranks if a fetch fails on one of them.
+ */
+void ParaMEDCouplingFieldDoubleMPIClient::FetchParts(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr fieldPtr, MPI_Comm comm, std::vector< MCAuto<MEDCouplingFieldDouble> >& parts)
+{
+  int rank,size;
+  MPI_Comm_rank(comm,&rank);
+  MPI_Comm_size(comm,&size);
+  std::string error;
+  parts.clear();
+  try
+    {
+      Engines::IORTab_var tior=fieldPtr->tior();
+      int nbOfParts=tior->length();
+      if(nbOfParts==0)
+        throw INTERP_KERNEL::Exception("ParaMEDCouplingFieldDoubleMPIClient::New : distributed field has no part !");
+      parts.resize(nbOfParts);
+      for(int ip=rank;ip<nbOfParts;ip+=size)
+        {
+          SALOME_MED::MEDCouplingFieldDoubleCorbaInterface_var partPtr=SALOME_MED::MEDCouplingFieldDoubleCorbaInterface::_narrow(tior[ip]);
+          parts[ip]=MEDCouplingFieldDoubleClient::New(partPtr);
+        }
+    }
+  catch(std::exception& e)
+    {
+      error=e.what();
+    }
+  catch(CORBA::Exception&)
+    {
+      std::ostringstream oss; oss << "ParaMEDCouplingFieldDoubleMPIClient::New : CORBA error while fetching the parts on rank " << rank << " !";
+      error=oss.str();
+    }
+  SynchronizeError(comm,error);
+}
+
+/*!
+ * Routes the cells of a field split in N parts to the M ranks of \a comm. \a parts has the same size N on all the ranks, and only
+ * holds the parts \c ip such as \c ip%M is the calling rank, the others being null. The parts are released once their cells are sent.
+ * Global cell IDs and the cells received by each rank are the ones of the two New methods, \a globalCellIds being null for the
+ * contiguous partition.
+ *
+ * Each step that can fail on some ranks only (check of the parts, check of the ids, sizes of the messages) is followed by
+ * SynchronizeError before the next collective call.
+ */
+MEDCouplingFieldDouble *ParaMEDCouplingFieldDoubleMPIClient::Redistribute(std::vector< MCAuto<MEDCouplingFieldDouble> >& parts, MPI_Comm comm, const DataArrayIdType *globalCellIds, double eps)
+{
+  int rank,size;
+  MPI_Comm_rank(comm,&rank);
+  MPI_Comm_size(comm,&size);
+  std::string error;
+  int nbOfParts((int)parts.size());
+  std::vector<long long> partSizes(nbOfParts,0);
+  for(int ip=0;ip<nbOfParts && error.empty();ip++)
+    {
+      bool owned(ip%size==rank);
+      if(owned!=(parts[ip].isNotNull() && parts[ip]->getMesh()!=0))
+        {
+          std::ostringstream oss; oss << "ParaMEDCouplingFieldDoubleMPIClient::Redistribute : part " << ip << " must be given with its mesh by rank " << ip%size << " only !";
+          error=oss.str();
+        }
+      else if(owned)
+        partSizes[ip]=parts[ip]->getMesh()->getNumberOfCells();
+    }
+  int minNbOfParts(0),maxNbOfParts(0);
+  MPI_Allreduce(&nbOfParts,&minNbOfParts,1,MPI_INT,MPI_MIN,comm);
+  MPI_Allreduce(&nbOfParts,&maxNbOfParts,1,MPI_INT,MPI_MAX,comm);
+  if(minNbOfParts!=maxNbOfParts)
+    error="ParaMEDCouplingFieldDoubleMPIClient::Redistribute : the number of parts differs between the ranks !";
+  else if(nbOfParts==0)
+    error="ParaMEDCouplingFieldDoubleMPIClient::Redistribute : distributed field has no part !";
+  SynchronizeError(comm,error);
+  MPI_Allreduce(MPI_IN_PLACE,&partSizes[0],nbOfParts,MPI_LONG_LONG,MPI_SUM,comm);
+  std::vector<long long> offsets(nbOfParts+1,0);
+  for(int ip=0;ip<nbOfParts;ip++)
+    offsets[ip+1]=offsets[ip]+partSizes[ip];
+  long long nbOfCells=offsets[nbOfParts];
+  //global cell ids wanted by this rank, sorted
+  std::vector<long long> wanted;
+  if(globalCellIds)
+    {
+      wanted.assign(globalCellIds->begin(),globalCellIds->end());
+      std::sort(wanted.begin(),wanted.end());
+      wanted.erase(std::unique(wanted.begin(),wanted.end()),wanted.end());
+      if(!wanted.empty() && (wanted.front()<0 || wanted.back()>=nbOfCells))
+        {
+          std::ostringstream oss; oss << "ParaMEDCouplingFieldDoubleMPIClient::New : global cell ids must be in [0," << nbOfCells << ") on rank " << rank << " !";
+          error=oss.str();
+          wanted.clear();
+        }
+    }
+  else
+    {
+      long long bg=(nbOfCells*rank)/size,end=(nbOfCells*(rank+1))/size;
+      wanted.resize(end-bg);
+      for(long long i=bg;i<end;i++)
+        wanted[i-bg]=i;
+    }
+  //requests : global cell ids sent to the rank that fetched the owning part
+  std::vector< std::vector<long long> > requests(size);
+  for(std::vector<long long>::const_iterator it=wanted.begin();it!=wanted.end();it++)
+    {
+      int ip=(int)(std::upper_bound(offsets.begin(),offsets.end(),*it)-offsets.begin())-1;
+      requests[ip%size].push_back(*it);
+    }
+  std::vector<int> reqSendCounts(size),reqRecvCounts(size);
+  std::vector<long long> reqSend;
+  for(int r=0;r<size;r++)
+    {
+      reqSendCounts[r]=CheckedCount(requests[r].size(),error);
+      reqSend.insert(reqSend.end(),requests[r].begin(),requests[r].end());
+    }
+  CheckedCount(reqSend.size(),error);
+  SynchronizeError(comm,error);
+  MPI_Alltoall(&reqSendCounts[0],1,MPI_INT,&reqRecvCounts[0],1,MPI_INT,comm);
+  std::vector<int> reqSendDispls(ComputeDisplacements(reqSendCounts)),reqRecvDispls(ComputeDisplacements(reqRecvCounts));
+  std::vector<long long> reqRecv(reqRecvDispls[size-1]+reqRecvCounts[size-1]);
+  MPI_Alltoallv(reqSend.empty()?0:&reqSend[0],&reqSendCounts[0],&reqSendDispls[0],MPI_LONG_LONG,
+                reqRecv.empty()?0:&reqRecv[0],&reqRecvCounts[0],&reqRecvDispls[0],MPI_LONG_LONG,comm);
+  //replies : for each requesting rank, the requested cells of each owned part
+  std::vector<char> repSend;
+  std::vector<int> repSendCounts(size,0),repRecvCounts(size);
+  try
+    {
+      for(int r=0;r<size;r++)
+        {
+          std::size_t bg=repSend.size();
+          const long long *ids=reqRecv.empty()?0:&reqRecv[0]+reqRecvDispls[r];
+          int nbOfIds=reqRecvCounts[r];
+          for(int i=0;i<nbOfIds;)
+            {
+              int ip=(int)(std::upper_bound(offsets.begin(),offsets.end(),ids[i])-offsets.begin())-1;
+              std::vector<mcIdType> localIds;
+              for(;i<nbOfIds && ids[i]<offsets[ip+1];i++)
+                localIds.push_back((mcIdType)(ids[i]-offsets[ip]));
+              PackSubPart(repSend,ip,parts[ip],localIds);
+            }
+          repSendCounts[r]=CheckedCount(repSend.size()-bg,error);
+        }
+      //displacements are int too
+      CheckedCount(repSend.size(),error);
+    }
+  catch(std::exception& e)
+    {
+      error=e.what();
+    }
+  parts.clear();
+  SynchronizeError(comm,error);
+  MPI_Alltoall(&repSendCounts[0],1,MPI_INT,&repRecvCounts[0],1,MPI_INT,comm);
+  std::vector<int> repSendDispls(ComputeDisplacements(repSendCounts)),repRecvDispls(ComputeDisplacements(repRecvCounts));
+  std::size_t nbOfBytes(0);
+  for(int r=0;r<size;r++)
+    nbOfBytes+=(std::size_t)repRecvCounts[r];
+  CheckedCount(nbOfBytes,error);
+  SynchronizeError(comm,error);
+  std::vector<char> repRecv(nbOfBytes);
+  MPI_Alltoallv(repSend.empty()?0:&repSend[0],&repSendCounts[0],&repSendDispls[0],MPI_BYTE,
+                repRecv.empty()?0:&repRecv[0],&repRecvCounts[0],&repRecvDispls[0],MPI_BYTE,comm);
+  std::vector<char>().swap(repSend);
+  //the received pieces are put back in global cell id order, that is to say in part order
+  std::vector< std::pair<long long, MCAuto<MEDCouplingFieldDouble> > > pieces;
+  const char *pos=repRecv.empty()?0:&repRecv[0];
+  const char *end=pos+repRecv.size();
+  while(pos!=end)
+    {
+      long long ip;
+      MCAuto<MEDCouplingFieldDouble> piece;
+      pos=UnpackSubPart(pos,ip,piece);
+      pieces.push_back(std::pair<long long, MCAuto<MEDCouplingFieldDouble> >(ip,piece));
+    }
+  std::vector<char>().swap(repRecv);
+  if(pieces.empty())
+    return 0;
+  std::sort(pieces.begin(),pieces.end(),PieceComparator);
+  if(pieces.size()==1)
+    return pieces[0].second.retn();
+  std::vector<const MEDCouplingFieldDouble *> piecesC(pieces.size());
+  for(std::size_t i=0;i<pieces.size();i++)
+    piecesC[i]=pieces[i].second;
+  MCAuto<MEDCouplingFieldDouble> ret(MEDCouplingFieldDouble::MergeFields(piecesC));
+  ret->mergeNodes(eps);
+  return ret.retn();
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef __PARAMEDCOUPLINGFIELDDOUBLEMPICLIENT_HXX__
+#define __PARAMEDCOUPLINGFIELDDOUBLEMPICLIENT_HXX__
+
+#include "ParaMEDCouplingCorba.hxx"
+#include "SALOMEconfig.h"
+#include CORBA_SERVER_HEADER(ParaMEDCouplingCorbaServant)
+#include "MEDCouplingMemArray.hxx"
+#include "MCAuto.hxx"
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+namespace MEDCoupling
+{
+  class MEDCouplingFieldDouble;
+
+  /*!
+   * Client of a field published on N ranks by ParaMEDCouplingFieldDoubleServant, for a consumer running on the M ranks of a
+   * communicator. Global cell IDs are the cell IDs of the parts concatenated in rank order of the publisher.
+   * Each part is fetched once, by the consumer rank \c ip%M, which then sends to each consumer rank only the cells it asked for.
+   * Redistribute does this routing of the cells once the parts are fetched, without CORBA.
+   * All the methods are collective on the communicator.
+   */
+  class PARAMEDCOUPLINGCORBA_EXPORT ParaMEDCouplingFieldDoubleMPIClient
+  {
+  public:
+    static MEDCouplingFieldDouble *New(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr field, MPI_Comm comm, double eps=1e-12);
+    static MEDCouplingFieldDouble *New(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr field, MPI_Comm comm, const DataArrayIdType *globalCellIds, double eps=1e-12);
+    static MEDCouplingFieldDouble *Redistribute(std::vector< MCAuto<MEDCouplingFieldDouble> >& parts, MPI_Comm comm, const DataArrayIdType *globalCellIds, double eps=1e-12);
+    static void SynchronizeError(MPI_Comm comm, const std::string& localError);
+  private:
+    static void FetchParts(SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_ptr field, MPI_Comm comm, std::vector< MCAuto<MEDCouplingFieldDouble> >& parts);
+  };
+}
+
+#endif
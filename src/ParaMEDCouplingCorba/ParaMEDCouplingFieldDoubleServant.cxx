@@ -18,9 +18,25 @@
 //
 
 #include "ParaMEDCouplingFieldDoubleServant.hxx"
+#include "ParaMEDCouplingRanksCaller.hxx"
 #include "utilities.h"
 using namespace MEDCoupling;
 
+namespace
+{
+  void registerOnRank(CORBA::Object_ptr obj)
+  {
+    SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_var fieldPtr=SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_narrow(obj);
+    fieldPtr->Register();
+  }
+
+  void unRegisterOnRank(CORBA::Object_ptr obj)
+  {
+    SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_var fieldPtr=SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_narrow(obj);
+    fieldPtr->UnRegister();
+  }
+}
+
 ParaMEDCouplingFieldDoubleServant::ParaMEDCouplingFieldDoubleServant(CORBA::ORB_ptr orb,MEDCouplingFieldDouble* field):MEDCouplingFieldDoubleServant(field)
 {
   Engines::MPIObject_var pobj = POA_SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_this();
@@ -30,21 +46,26 @@ ParaMEDCouplingFieldDoubleServant::ParaMEDCouplingFieldDoubleServant(CORBA::ORB_
 void ParaMEDCouplingFieldDoubleServant::Register()
 {
   if(_numproc == 0)
-    for(int ip=1;ip<_nbproc;ip++)
-      {
-        SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_var fieldPtr=SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_narrow((*_tior)[ip]);
-        fieldPtr->Register();
-      }
+    CallOnOtherRanks(_tior,_nbproc,registerOnRank,unRegisterOnRank);
   MEDCouplingFieldDoubleServant::Register();
 }
 
+/*!
+ * The reference held on this rank is released even if the release fails on another rank, the exception being then rethrown.
+ */
 void ParaMEDCouplingFieldDoubleServant::UnRegister()
 {
   if(_numproc == 0)
-    for(int ip=1;ip<_nbproc;ip++)
-      {
-        SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface_var fieldPtr=SALOME_MED::ParaMEDCouplingFieldDoubleCorbaInterface::_narrow((*_tior)[ip]);
-        fieldPtr->UnRegister();
-      }
+    {
+      try
+        {
+          CallOnOtherRanks(_tior,_nbproc,unRegisterOnRank);
+        }
+      catch(...)
+        {
+          MEDCouplingFieldDoubleServant::UnRegister();
+          throw;
+        }
+    }
   MEDCouplingFieldDoubleServant::UnRegister();
 }
@@ -0,0 +1,132 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "ParaMEDCouplingRanksCaller.hxx"
+#include "Utils_CorbaException.hxx"
+#include "utilities.h"
+
+#include <pthread.h>
+#include <exception>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  typedef struct
+  {
+    CORBA::Object_ptr obj;
+    ParaMEDCouplingRankCall call;
+    bool exception;
+    std::string msg;
+  } rankcall_st;
+
+  void *th_callonrank(void *s)
+  {
+    rankcall_st *st = (rankcall_st*)s;
+    try
+      {
+        st->call(st->obj);
+      }
+    catch(const SALOME_CMOD::SALOME_Exception &ex)
+      {
+        st->exception = true;
+        st->msg = ex.details.text;
+      }
+    catch(const CORBA::Exception &ex)
+      {
+        std::ostringstream msg;
+        msg << "CORBA::Exception: " << ex;
+        st->exception = true;
+        st->msg = msg.str();
+      }
+    catch(std::exception &ex)
+      {
+        st->exception = true;
+        st->msg = ex.what();
+      }
+    catch(...)
+      {
+        st->exception = true;
+        st->msg = "unknown exception";
+      }
+    return 0;
+  }
+
+  /*!
+   * Invokes \a call on the objects of \a ranks of \a tior, one thread per rank. Returns in \a sts the outcome of each
+   * invocation. A rank whose thread can't be started is reported as failed without being invoked.
+   */
+  void CallOnRanks(Engines::IORTab *tior, const std::vector<int>& ranks, ParaMEDCouplingRankCall call, std::vector<rankcall_st>& sts)
+  {
+    std::size_t nbOfRanks(ranks.size());
+    std::vector<pthread_t> th(nbOfRanks);
+    std::vector<bool> started(nbOfRanks,false);
+    sts.resize(nbOfRanks);
+    for(std::size_t i=0;i<nbOfRanks;i++)
+      {
+        sts[i].obj = (*tior)[ranks[i]];
+        sts[i].call = call;
+        sts[i].exception = false;
+        started[i] = pthread_create(&th[i],NULL,th_callonrank,(void*)&sts[i])==0;
+        if(!started[i])
+          {
+            sts[i].exception = true;
+            sts[i].msg = "impossible to start the calling thread";
+          }
+      }
+    for(std::size_t i=0;i<nbOfRanks;i++)
+      if(started[i])
+        pthread_join(th[i],NULL);
+  }
+}
+
+void MEDCoupling::CallOnOtherRanks(Engines::IORTab *tior, int nbproc, ParaMEDCouplingRankCall call, ParaMEDCouplingRankCall undo)
+{
+  if(nbproc<=1)
+    return ;
+  std::vector<int> ranks;
+  for(int ip=1;ip<nbproc;ip++)
+    ranks.push_back(ip);
+  std::vector<rankcall_st> sts;
+  CallOnRanks(tior,ranks,call,sts);
+  std::ostringstream msg;
+  std::vector<int> succeeded;
+  for(std::size_t i=0;i<ranks.size();i++)
+    {
+      if(sts[i].exception)
+        msg << "[" << ranks[i] << "] " << sts[i].msg << std::endl;
+      else
+        succeeded.push_back(ranks[i]);
+    }
+  if(succeeded.size()==ranks.size())
+    return ;
+  if(undo && !succeeded.empty())
+    {// best effort : the failure of call is the one reported
+      std::vector<rankcall_st> undoSts;
+      CallOnRanks(tior,succeeded,undo,undoSts);
+      for(std::size_t i=0;i<succeeded.size();i++)
+        if(undoSts[i].exception)
+          MESSAGE("CallOnOtherRanks : undo failed on rank " << succeeded[i] << " : " << undoSts[i].msg);
+    }
+  MESSAGE(msg.str());
+  THROW_SALOME_CORBA_EXCEPTION(msg.str().c_str(),SALOME_CMOD::INTERNAL_ERROR);
+}
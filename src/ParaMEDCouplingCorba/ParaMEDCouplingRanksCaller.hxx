@@ -0,0 +1,40 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef __PARAMEDCOUPLINGRANKSCALLER_HXX__
+#define __PARAMEDCOUPLINGRANKSCALLER_HXX__
+
+#include "SALOMEconfig.h"
+#include CORBA_SERVER_HEADER(SALOME_MPIObject)
+
+namespace MEDCoupling
+{
+  typedef void (*ParaMEDCouplingRankCall)(CORBA::Object_ptr obj);
+
+  /*!
+   * Invokes \a call on the objects of ranks 1 to \a nbproc - 1 of \a tior, one thread per rank,
+   * so that the blocking CORBA invocations are all in flight at the same time.
+   * All the threads started are joined before returning. If one or more invocations failed (or could not be started), \a undo,
+   * if not null, is invoked the same way on the ranks where \a call succeeded, and a SALOME_CMOD::SALOME_Exception
+   * gathering the messages is thrown.
+   */
+  void CallOnOtherRanks(Engines::IORTab *tior, int nbproc, ParaMEDCouplingRankCall call, ParaMEDCouplingRankCall undo=0);
+}
+
+#endif
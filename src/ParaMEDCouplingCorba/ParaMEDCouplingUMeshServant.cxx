@@ -18,9 +18,25 @@
 //
 
 #include "ParaMEDCouplingUMeshServant.hxx"
+#include "ParaMEDCouplingRanksCaller.hxx"
 #include "utilities.h"
 using namespace MEDCoupling;
 
+namespace
+{
+  void registerOnRank(CORBA::Object_ptr obj)
+  {
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_narrow(obj);
+    meshPtr->Register();
+  }
+
+  void unRegisterOnRank(CORBA::Object_ptr obj)
+  {
+    SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_narrow(obj);
+    meshPtr->UnRegister();
+  }
+}
+
 ParaMEDCouplingUMeshServant::ParaMEDCouplingUMeshServant(CORBA::ORB_ptr orb,MEDCouplingUMesh* mesh):MEDCouplingUMeshServant(mesh),MPIObject_i()
 {
   Engines::MPIObject_var pobj = POA_SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_this();
@@ -30,21 +46,26 @@ ParaMEDCouplingUMeshServant::ParaMEDCouplingUMeshServant(CORBA::ORB_ptr orb,MEDC
 void ParaMEDCouplingUMeshServant::Register()
 {
   if(_numproc == 0)
-    for(int ip=1;ip<_nbproc;ip++)
-      {
-        SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_narrow((*_tior)[ip]);
-        meshPtr->Register();
-      }
+    CallOnOtherRanks(_tior,_nbproc,registerOnRank,unRegisterOnRank);
   MEDCouplingUMeshServant::Register();
 }
 
+/*!
+ * The reference held on this rank is released even if the release fails on another rank, the exception being then rethrown.
+ */
 void ParaMEDCouplingUMeshServant::UnRegister()
 {
   if(_numproc == 0)
-    for(int ip=1;ip<_nbproc;ip++)
-      {
-        SALOME_MED::ParaMEDCouplingUMeshCorbaInterface_var meshPtr=SALOME_MED::ParaMEDCouplingUMeshCorbaInterface::_narrow((*_tior)[ip]);
-        meshPtr->UnRegister();
-      }
+    {
+      try
+        {
+          CallOnOtherRanks(_tior,_nbproc,unRegisterOnRank);
+        }
+      catch(...)
+        {
+          MEDCouplingUMeshServant::UnRegister();
+          throw;
+        }
+    }
   MEDCouplingUMeshServant::UnRegister();
 }
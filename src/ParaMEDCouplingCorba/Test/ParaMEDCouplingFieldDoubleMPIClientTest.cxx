@@ -0,0 +1,252 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDCouplingFieldDoubleMPIClientTest.hxx"
+#include "ParaMEDCouplingFieldDoubleMPIClient.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingUMesh.hxx"
+#include "MCAuto.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MEDCoupling;
+
+namespace
+{
+  /*!
+   * Part \a ip of a strip of unit squares, the global cell \c g lying on [g,g+1]x[0,1] and having the value \c g. Part \a ip holds
+   * the ip+1 global cells following the ones of the previous parts, with its own nodes : the nodes at the boundary of two parts
+   * are duplicated.
+   */
+  MEDCouplingFieldDouble *BuildPart(int ip)
+  {
+    int nbOfCells(ip+1),first((ip*(ip+1))/2);
+    MCAuto<MEDCouplingUMesh> mesh(MEDCouplingUMesh::New("strip",2));
+    MCAuto<DataArrayDouble> coords(DataArrayDouble::New());
+    coords->alloc(2*(nbOfCells+1),2);
+    double *pt(coords->getPointer());
+    for(int i=0;i<=nbOfCells;i++)
+      {
+        pt[4*i]=(double)(first+i); pt[4*i+1]=0.;
+        pt[4*i+2]=(double)(first+i); pt[4*i+3]=1.;
+      }
+    mesh->setCoords(coords);
+    mesh->allocateCells(nbOfCells);
+    for(int i=0;i<nbOfCells;i++)
+      {
+        mcIdType conn[4]={2*i,2*i+2,2*i+3,2*i+1};
+        mesh->insertNextCell(INTERP_KERNEL::NORM_QUAD4,4,conn);
+      }
+    mesh->finishInsertingCells();
+    MCAuto<MEDCouplingFieldDouble> ret(MEDCouplingFieldDouble::New(ON_CELLS,ONE_TIME));
+    ret->setName("values");
+    ret->setMesh(mesh);
+    ret->setTime(1.5,2,3);
+    MCAuto<DataArrayDouble> values(DataArrayDouble::New());
+    values->alloc(nbOfCells,1);
+    for(int i=0;i<nbOfCells;i++)
+      values->setIJ(i,0,(double)(first+i));
+    ret->setArray(values);
+    return ret.retn();
+  }
+
+  //! The parts of a strip of \a nbOfParts parts given by the calling rank, that is to say the parts ip such as ip%size==rank
+  std::vector< MCAuto<MEDCouplingFieldDouble> > BuildParts(int nbOfParts, MPI_Comm comm)
+  {
+    int rank,size;
+    MPI_Comm_rank(comm,&rank);
+    MPI_Comm_size(comm,&size);
+    std::vector< MCAuto<MEDCouplingFieldDouble> > ret(nbOfParts);
+    for(int ip=rank;ip<nbOfParts;ip+=size)
+      ret[ip]=BuildPart(ip);
+    return ret;
+  }
+
+  //! Checks that \a f holds exactly the global cells \a ids, sorted, with the nodes shared by two adjacent cells merged
+  void CheckCells(const MEDCouplingFieldDouble *f, const std::vector<int>& ids)
+  {
+    if(ids.empty())
+      {
+        CPPUNIT_ASSERT(f==0);
+        return ;
+      }
+    CPPUNIT_ASSERT(f!=0);
+    CPPUNIT_ASSERT_EQUAL(std::string("values"),std::string(f->getName()));
+    CPPUNIT_ASSERT_EQUAL((mcIdType)ids.size(),f->getMesh()->getNumberOfCells());
+    CPPUNIT_ASSERT_EQUAL((mcIdType)ids.size(),f->getArray()->getNumberOfTuples());
+    mcIdType nbOfNodes(4*(mcIdType)ids.size());
+    for(std::size_t i=0;i<ids.size();i++)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL((double)ids[i],f->getArray()->getIJ((mcIdType)i,0),1e-14);
+        if(i>0 && ids[i]==ids[i-1]+1)
+          nbOfNodes-=2;
+      }
+    CPPUNIT_ASSERT_EQUAL(nbOfNodes,f->getMesh()->getNumberOfNodes());
+    // each cell still lies on [g,g+1]x[0,1]
+    MCAuto<MEDCouplingFieldDouble> areas(f->getMesh()->getMeasureField(true));
+    MCAuto<DataArrayDouble> centers(f->getMesh()->computeCellCenterOfMass());
+    for(std::size_t i=0;i<ids.size();i++)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.,areas->getArray()->getIJ((mcIdType)i,0),1e-12);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL((double)ids[i]+0.5,centers->getIJ((mcIdType)i,0),1e-12);
+      }
+  }
+}
+
+void MEDCoupling::ParaMEDCouplingFieldDoubleMPIClientTest::testSynchronizeError1()
+{
+  int rank,size;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&size);
+  // no error on any rank : nothing thrown
+  ParaMEDCouplingFieldDoubleMPIClient::SynchronizeError(MPI_COMM_WORLD,std::string());
+  // error on the last rank only : thrown on all the ranks with its message
+  bool thrown(false);
+  try
+    {
+      ParaMEDCouplingFieldDoubleMPIClient::SynchronizeError(MPI_COMM_WORLD,rank==size-1?std::string("failure on the last rank"):std::string());
+    }
+  catch(INTERP_KERNEL::Exception& e)
+    {
+      thrown=true;
+      CPPUNIT_ASSERT_EQUAL(std::string("failure on the last rank"),std::string(e.what()));
+    }
+  CPPUNIT_ASSERT(thrown);
+  // errors on several ranks : the message of the first failing one
+  std::ostringstream local; local << "failure on rank " << rank;
+  std::ostringstream expected; expected << "failure on rank " << size/2;
+  thrown=false;
+  try
+    {
+      ParaMEDCouplingFieldDoubleMPIClient::SynchronizeError(MPI_COMM_WORLD,rank>=size/2?local.str():std::string());
+    }
+  catch(INTERP_KERNEL::Exception& e)
+    {
+      thrown=true;
+      CPPUNIT_ASSERT_EQUAL(expected.str(),std::string(e.what()));
+    }
+  CPPUNIT_ASSERT(thrown);
+  // no rank has been left behind in a collective call
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/*!
+ * Contiguous partition of N parts on the M ranks of the test, with N>M and N<M when run on 3 ranks.
+ */
+void MEDCoupling::ParaMEDCouplingFieldDoubleMPIClientTest::testRedistribute1()
+{
+  int rank,size;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&size);
+  const int nbOfPartsTab[2]={5,2};
+  for(int t=0;t<2;t++)
+    {
+      int nbOfParts(nbOfPartsTab[t]);
+      int nbOfCells((nbOfParts*(nbOfParts+1))/2);
+      std::vector< MCAuto<MEDCouplingFieldDouble> > parts(BuildParts(nbOfParts,MPI_COMM_WORLD));
+      MCAuto<MEDCouplingFieldDouble> f(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,0));
+      CPPUNIT_ASSERT(parts.empty());
+      std::vector<int> expected;
+      for(int i=(nbOfCells*rank)/size;i<(nbOfCells*(rank+1))/size;i++)
+        expected.push_back(i);
+      CheckCells(f,expected);
+      // all the cells are received once
+      int nbOfCellsReceived(f.isNull()?0:(int)f->getMesh()->getNumberOfCells()),total(0);
+      MPI_Allreduce(&nbOfCellsReceived,&total,1,MPI_INT,MPI_SUM,MPI_COMM_WORLD);
+      CPPUNIT_ASSERT_EQUAL(nbOfCells,total);
+    }
+}
+
+/*!
+ * User partition : unsorted ids with duplicates, spread over several parts, the same cell being asked by several ranks.
+ * The result is sorted and de-duplicated.
+ */
+void MEDCoupling::ParaMEDCouplingFieldDoubleMPIClientTest::testRedistribute2()
+{
+  int rank,size;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&size);
+  const int nbOfParts=5;
+  const int nbOfCells=(nbOfParts*(nbOfParts+1))/2;
+  std::vector<int> asked;
+  asked.push_back(nbOfCells-1-rank);
+  asked.push_back((2*rank+1)%nbOfCells);
+  asked.push_back(7);
+  asked.push_back(nbOfCells-1-rank);
+  asked.push_back((2*rank+2)%nbOfCells);
+  asked.push_back(0);
+  asked.push_back(6);
+  MCAuto<DataArrayIdType> ids(DataArrayIdType::New());
+  ids->alloc(asked.size(),1);
+  std::copy(asked.begin(),asked.end(),ids->getPointer());
+  std::vector< MCAuto<MEDCouplingFieldDouble> > parts(BuildParts(nbOfParts,MPI_COMM_WORLD));
+  MCAuto<MEDCouplingFieldDouble> f(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,ids));
+  std::sort(asked.begin(),asked.end());
+  asked.erase(std::unique(asked.begin(),asked.end()),asked.end());
+  CheckCells(f,asked);
+  // a rank asking for no cell gets nothing, the others are served
+  MCAuto<DataArrayIdType> ids2(DataArrayIdType::New());
+  std::vector<int> asked2;
+  if(rank!=0)
+    {
+      asked2.push_back(nbOfCells-1);
+      asked2.push_back(rank);
+    }
+  ids2->alloc(asked2.size(),1);
+  std::copy(asked2.begin(),asked2.end(),ids2->getPointer());
+  parts=BuildParts(nbOfParts,MPI_COMM_WORLD);
+  MCAuto<MEDCouplingFieldDouble> f2(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,ids2));
+  std::sort(asked2.begin(),asked2.end());
+  CheckCells(f2,asked2);
+}
+
+/*!
+ * Wrong input on one rank only : all the ranks throw, none being left behind in a collective call.
+ */
+void MEDCoupling::ParaMEDCouplingFieldDoubleMPIClientTest::testRedistribute3()
+{
+  int rank,size;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&size);
+  const int nbOfParts=5;
+  const int nbOfCells=(nbOfParts*(nbOfParts+1))/2;
+  // global cell id out of range on the last rank
+  MCAuto<DataArrayIdType> ids(DataArrayIdType::New());
+  ids->alloc(1,1);
+  ids->setIJ(0,0,rank==size-1?nbOfCells:0);
+  std::vector< MCAuto<MEDCouplingFieldDouble> > parts(BuildParts(nbOfParts,MPI_COMM_WORLD));
+  CPPUNIT_ASSERT_THROW(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,ids),INTERP_KERNEL::Exception);
+  // a part missing on the rank that has to give it
+  parts=BuildParts(nbOfParts,MPI_COMM_WORLD);
+  if(rank==0)
+    parts[0]=0;
+  CPPUNIT_ASSERT_THROW(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,0),INTERP_KERNEL::Exception);
+  // not the same number of parts on all the ranks
+  parts=BuildParts(rank==size-1?nbOfParts+size:nbOfParts,MPI_COMM_WORLD);
+  CPPUNIT_ASSERT_THROW(ParaMEDCouplingFieldDoubleMPIClient::Redistribute(parts,MPI_COMM_WORLD,0),INTERP_KERNEL::Exception);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
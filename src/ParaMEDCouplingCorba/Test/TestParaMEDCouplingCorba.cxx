@@ -0,0 +1,69 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDCouplingFieldDoubleMPIClientTest.hxx"
+
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TextTestProgressListener.h>
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestRunner.h>
+
+#include <mpi.h>
+
+#include <fstream>
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MEDCoupling::ParaMEDCouplingFieldDoubleMPIClientTest );
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc,&argv);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+#ifdef WIN32
+  CPPUNIT_NS::TextTestProgressListener progress;
+#else
+  CPPUNIT_NS::BriefTestProgressListener progress;
+#endif
+  if(rank==0)
+    controller.addListener( &progress );
+  CPPUNIT_NS::Test *suite = CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest();
+  CPPUNIT_NS::TestRunner runner;
+  runner.addTest( suite );
+  runner.run( controller);
+  // ---  Print test in a compiler compatible format, one file per rank.
+  std::ostringstream fileName; fileName << "UnitTestsResult_" << rank;
+  std::ofstream testFile;
+  testFile.open(fileName.str().c_str(), std::ios::out |  std::ios::trunc);
+  CPPUNIT_NS::CompilerOutputter outputter( &result, testFile );
+  outputter.write();
+  testFile.close();
+  // ---  Return error code 1 if the one of test failed on one of the ranks.
+  int failed(result.wasSuccessful()?0:1),anyFailed(0);
+  MPI_Allreduce(&failed,&anyFailed,1,MPI_INT,MPI_LOR,MPI_COMM_WORLD);
+  MPI_Finalize();
+  return anyFailed ? 1 : 0;
+}
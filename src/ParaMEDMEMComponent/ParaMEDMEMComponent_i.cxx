@@ -104,21 +104,22 @@ void ParaMEDMEMComponent_i::initializeCoupling(const char * coupling, const char
     // Creation of processors group for ParaMEDMEM
     // source is always the lower processor numbers
     // target is always the upper processor numbers
+    // interpolation options may already have been set for this coupling
+    Coupling& c = _couplings[service];
     if(_numproc==grank)
       {
-        _source[coupling] = new MPIProcessorGroup(*_interface,0,_nbproc-1,_gcom[coupling]);
-        _target[coupling] = new MPIProcessorGroup(*_interface,_nbproc,gsize-1,_gcom[coupling]);
-        _commgroup[coupling] = _source[coupling];
+        c._source = new MPIProcessorGroup(*_interface,0,_nbproc-1,_gcom[coupling]);
+        c._target = new MPIProcessorGroup(*_interface,_nbproc,gsize-1,_gcom[coupling]);
+        c._commgroup = c._source;
       }
     else
       {
-        _source[coupling] = new MPIProcessorGroup(*_interface,0,gsize-_nbproc-1,_gcom[coupling]);
-        _target[coupling] = new MPIProcessorGroup(*_interface,gsize-_nbproc,gsize-1,_gcom[coupling]);
-        _commgroup[coupling] = _target[coupling];
+        c._source = new MPIProcessorGroup(*_interface,0,gsize-_nbproc-1,_gcom[coupling]);
+        c._target = new MPIProcessorGroup(*_interface,gsize-_nbproc,gsize-1,_gcom[coupling]);
+        c._commgroup = c._target;
       }
-    _connectto [coupling] = ior;
-    _dec[coupling] = NULL;
-    _dec_options[coupling] = NULL;
+    c._dec = NULL;
+    registerConnection(service,ior);
     
   }
   catch(const std::exception &ex)
@@ -185,19 +186,17 @@ void ParaMEDMEMComponent_i::terminateCoupling(const char * coupling)
 #endif
 
     /* Processors groups and DEC destruction */
-    delete _source[coupling];
-    _source.erase(coupling);
-    delete _target[coupling];
-    _target.erase(coupling);
-    delete _dec[coupling];
-    _dec.erase(coupling);
-    _commgroup.erase(coupling);
-    if(_dec_options[coupling])
+    std::map<std::string,Coupling>::iterator it = _couplings.find(service);
+    if( it != _couplings.end() )
       {
-        delete _dec_options[coupling];
-        _dec_options.erase(coupling);
+        Coupling& c = (*it).second;
+        delete c._source;
+        delete c._target;
+        delete c._dec;
+        delete c._dec_options;
+        unregisterConnection(service,c._connectto);
+        _couplings.erase(it);
       }
-    _connectto.erase(coupling);
   }
   catch(const std::exception &ex)
     {
@@ -265,10 +264,11 @@ void ParaMEDMEMComponent_i::setInterpolationOptions(const char * coupling,
         }
     }
 
-  if(!_dec_options[coupling])
-    _dec_options[coupling] = new INTERP_KERNEL::InterpolationOptions;
+  Coupling& c = _couplings[coupling];
+  if(!c._dec_options)
+    c._dec_options = new INTERP_KERNEL::InterpolationOptions;
 
-  bool ret = _dec_options[coupling]->setInterpolationOptions(print_level,
+  bool ret = c._dec_options->setInterpolationOptions(print_level,
                                                              intersection_type,
                                                              precision,
                                                              median_plane,
@@ -310,12 +310,9 @@ void ParaMEDMEMComponent_i::_setInputField(SALOME_MED::MPIMEDCouplingFieldDouble
   void *ret_th;
   pthread_t th;
   ostringstream msg;
-  string coupling;
-  
-  std::map<std::string,std::string>::const_iterator it = mapSearchByValue(_connectto, fieldptr->getRef());
-  if(it != _connectto.end())
-    coupling = (*it).first.c_str();
-  else
+  CORBA::String_var ref = fieldptr->getRef();
+  string coupling = findCouplingConnectedTo(ref.in());
+  if( coupling.empty() )
     throw SALOME_Exception("Reference of remote component doesn't find in connectto map !");
 
   if(_numproc == 0)
@@ -335,7 +332,8 @@ void ParaMEDMEMComponent_i::_setInputField(SALOME_MED::MPIMEDCouplingFieldDouble
       throw SALOME_Exception(msg.str().c_str());
     }
 
-  if(!_dec[coupling])
+  Coupling& c = getCoupling(coupling);
+  if(!c._dec)
     {
 
       MPI_Comm_rank( _gcom[coupling], &grank );
@@ -343,26 +341,26 @@ void ParaMEDMEMComponent_i::_setInputField(SALOME_MED::MPIMEDCouplingFieldDouble
       // Creating the intersection Data Exchange Channel
       // Processors which received the field are always the second argument of InterpKernelDEC object
       if(_numproc==grank)
-        _dec[coupling] = new InterpKernelDEC(*_target[coupling], *_source[coupling]);
+        c._dec = new InterpKernelDEC(*c._target, *c._source);
       else
-        _dec[coupling] = new InterpKernelDEC(*_source[coupling], *_target[coupling]);
+        c._dec = new InterpKernelDEC(*c._source, *c._target);
 
-      if(_dec_options[coupling])
-        _dec[coupling]->copyOptions(*(_dec_options[coupling]));
+      if(c._dec_options)
+        c._dec->copyOptions(*(c._dec_options));
       
       //Attaching the field to the DEC
-      _dec[coupling]->attachLocalField(field);
+      c._dec->attachLocalField(field);
 
       // computing the interpolation matrix
-      _dec[coupling]->synchronize();
+      c._dec->synchronize();
 
     }
   else
     //Attaching the field to the DEC
-    _dec[coupling]->attachLocalField(field);
+    c._dec->attachLocalField(field);
   
   //Receiving data
-  _dec[coupling]->recvData();
+  c._dec->recvData();
 
   if(_numproc == 0)
     {
@@ -390,7 +388,8 @@ void ParaMEDMEMComponent_i::_getOutputField(const char * coupling, MEDCouplingFi
       throw SALOME_Exception(msg.str().c_str());
     }
 
-  if(!_dec[coupling])
+  Coupling& c = getCoupling(service);
+  if(!c._dec)
     {
 
       MPI_Comm_rank( _gcom[coupling], &grank );
@@ -398,25 +397,25 @@ void ParaMEDMEMComponent_i::_getOutputField(const char * coupling, MEDCouplingFi
       // Creating the intersection Data Exchange Channel
       // Processors which sent the field are always the first argument of InterpKernelDEC object
       if(_numproc==grank)
-        _dec[coupling] = new InterpKernelDEC(*_source[coupling], *_target[coupling]);
+        c._dec = new InterpKernelDEC(*c._source, *c._target);
       else
-        _dec[coupling] = new InterpKernelDEC(*_target[coupling], *_source[coupling]);
+        c._dec = new InterpKernelDEC(*c._target, *c._source);
   
-      if(_dec_options[coupling])
-        _dec[coupling]->copyOptions(*(_dec_options[coupling]));
+      if(c._dec_options)
+        c._dec->copyOptions(*(c._dec_options));
       
       //Attaching the field to the DEC
-      _dec[coupling]->attachLocalField(field);
+      c._dec->attachLocalField(field);
     
       // computing the interpolation matrix
-      _dec[coupling]->synchronize();
+      c._dec->synchronize();
     }
   else
     //Attaching the field to the DEC
-    _dec[coupling]->attachLocalField(field);
+    c._dec->attachLocalField(field);
 
   //Sending data
-  _dec[coupling]->sendData();
+  c._dec->sendData();
 }
 
 void ParaMEDMEMComponent_i::_initializeCoupling(SALOME_MED::MPIMEDCouplingFieldDoubleCorbaInterface_ptr fieldptr)
@@ -427,7 +426,8 @@ void ParaMEDMEMComponent_i::_initializeCoupling(SALOME_MED::MPIMEDCouplingFieldD
   //this string specifies the coupling
   string coupling;
   //getting IOR string of the remote object
-  string rcompo = fieldptr->getRef();
+  CORBA::String_var rref = fieldptr->getRef();
+  string rcompo = rref.in();
   if(_numproc == 0){
     //getting IOR string of the local object
     CORBA::Object_var my_ref = _poa->servant_to_reference (_thisObj);
@@ -436,9 +436,8 @@ void ParaMEDMEMComponent_i::_initializeCoupling(SALOME_MED::MPIMEDCouplingFieldD
     if( rcompo.find(lcompo) == std::string::npos ){
       th = new pthread_t[1];
       //finding the IOR of the remote object in the map
-      std::map<std::string,std::string>::const_iterator it = mapSearchByValue(_connectto, rcompo);
       //if it is not found : connecting two objects : this is the first (and the only) connection between these objects
-      if (it == _connectto.end()){
+      if (findCouplingConnectedTo(rcompo).empty()){
         //generating the coupling string : concatenation of two IOR strings
         coupling = lcompo + rcompo;
 
@@ -465,27 +464,45 @@ void ParaMEDMEMComponent_i::_initializeCoupling(SALOME_MED::MPIMEDCouplingFieldD
   }
 }
 
-std::map<std::string,std::string>::const_iterator ParaMEDMEMComponent_i::mapSearchByValue(std::map<std::string,std::string> & search_map, std::string search_val)
+ParaMEDMEMComponent_i::Coupling& ParaMEDMEMComponent_i::getCoupling(const std::string& coupling)
 {
-  std::map<std::string,std::string>::const_iterator iRet = search_map.end();
-  for (std::map<std::string,std::string>::const_iterator iTer = search_map.begin(); iTer != search_map.end(); iTer ++)
+  std::map<std::string,Coupling>::iterator it = _couplings.find(coupling);
+  if( it == _couplings.end() )
     {
-      if( iTer->second.find(search_val) != std::string::npos )
-        {
-          iRet = iTer;
-          break;
-        }
+      ostringstream msg;
+      msg << "service " << coupling << " doesn't exist !";
+      throw SALOME_Exception(msg.str().c_str());
     }
-  return iRet;
+  return (*it).second;
 }
 
+/*!
+ * Returns the name of the coupling connected to the distant object whose IOR is \a ior, or an empty string if none.
+ * \sa ParaMEDMEMCouplingIndex::find
+ */
+std::string ParaMEDMEMComponent_i::findCouplingConnectedTo(const std::string& ior) const
+{
+  return _couplingsByIOR.find(ior);
+}
+
+void ParaMEDMEMComponent_i::registerConnection(const std::string& coupling, const std::string& ior)
+{
+  Coupling& c = getCoupling(coupling);
+  if( !c._connectto.empty() )
+    unregisterConnection(coupling,c._connectto);
+  c._connectto = ior;
+  _couplingsByIOR.insert(coupling,ior);
+}
+
+void ParaMEDMEMComponent_i::unregisterConnection(const std::string& coupling, const std::string& ior)
+{
+  _couplingsByIOR.erase(coupling,ior);
+}
+
+// cref may be a part of the IOR of the distant component
 bool ParaMEDMEMComponent_i::amICoupledWithThisComponent(const char* cref)
 {
-  std::map<std::string,std::string>::const_iterator it = mapSearchByValue(_connectto, cref);
-  if(it != _connectto.end())
-    return true;
-  else
-    return false;
+  return !_couplingsByIOR.findContaining(cref).empty();
 }
 
 void *th_setinterpolationoptions(void *s)
@@ -32,6 +32,7 @@
 #include "CommInterface.hxx"
 #include "MEDCouplingFieldDoubleServant.hxx"
 #include "Utils_CorbaException.hxx"
+#include "ParaMEDMEMCouplingIndex.hxx"
 #include <map>
 
 void * th_setinterpolationoptions(void *st);
@@ -101,14 +102,25 @@ namespace MEDCoupling
     bool amICoupledWithThisComponent(const char * cref);
 
   private:
-    std::map<std::string,std::string>::const_iterator mapSearchByValue(std::map<std::string,std::string> & search_map, std::string search_val);
+    //! State of one coupling, gathered in a single record indexed by the coupling name.
+    struct Coupling
+    {
+      Coupling():_source(0),_target(0),_commgroup(0),_dec(0),_dec_options(0) { }
+      MPIProcessorGroup *_source;
+      MPIProcessorGroup *_target;
+      ProcessorGroup *_commgroup;
+      InterpKernelDEC *_dec;
+      INTERP_KERNEL::InterpolationOptions *_dec_options;
+      std::string _connectto;  //IOR of distant object
+    };
+    Coupling& getCoupling(const std::string& coupling);
+    std::string findCouplingConnectedTo(const std::string& ior) const;
+    void registerConnection(const std::string& coupling, const std::string& ior);
+    void unregisterConnection(const std::string& coupling, const std::string& ior);
     
     CommInterface* _interface;
-    std::map<std::string,InterpKernelDEC*> _dec;
-    std::map<std::string,MPIProcessorGroup*> _source, _target;
-    std::map<std::string,ProcessorGroup*> _commgroup;
-    std::map<std::string,INTERP_KERNEL::InterpolationOptions*> _dec_options;
-    std::map<std::string,std::string> _connectto;  //IOR of distant objects
+    std::map<std::string,Coupling> _couplings;
+    ParaMEDMEMCouplingIndex _couplingsByIOR;  //reverse index : IOR of distant object -> couplings
   };
 }
 #endif
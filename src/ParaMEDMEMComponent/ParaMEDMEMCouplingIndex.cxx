@@ -0,0 +1,72 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDMEMCouplingIndex.hxx"
+
+using namespace MEDCoupling;
+
+void ParaMEDMEMCouplingIndex::insert(const std::string& coupling, const std::string& ior)
+{
+  _couplings_by_ior[ior].insert(coupling);
+}
+
+void ParaMEDMEMCouplingIndex::erase(const std::string& coupling, const std::string& ior)
+{
+  std::map< std::string, std::set<std::string> >::iterator it = _couplings_by_ior.find(ior);
+  if( it == _couplings_by_ior.end() )
+    return ;
+  (*it).second.erase(coupling);
+  if( (*it).second.empty() )
+    _couplings_by_ior.erase(it);
+}
+
+/*!
+ * Returns the name of a coupling connected to the distant object whose IOR is exactly \a ior, or an empty
+ * string if none. If several couplings are connected to this object, the first one in name order is returned.
+ * Logarithmic lookup.
+ */
+std::string ParaMEDMEMCouplingIndex::find(const std::string& ior) const
+{
+  std::map< std::string, std::set<std::string> >::const_iterator it = _couplings_by_ior.find(ior);
+  if( it == _couplings_by_ior.end() )
+    return std::string();
+  return *((*it).second.begin());
+}
+
+/*!
+ * Same as find for a part \a ior of the IOR of the distant object : as the former linear search did, a coupling
+ * whose registered IOR contains \a ior is looked for if none is registered with exactly \a ior. Among several
+ * candidates, the first one in name order is returned. Linear in the number of distant objects on a miss.
+ */
+std::string ParaMEDMEMCouplingIndex::findContaining(const std::string& ior) const
+{
+  std::string ret(find(ior));
+  if( !ret.empty() )
+    return ret;
+  std::map< std::string, std::set<std::string> >::const_iterator it;
+  for(it = _couplings_by_ior.begin(); it != _couplings_by_ior.end(); it++)
+    if( (*it).first.find(ior) != std::string::npos )
+      {
+        const std::string& candidate = *((*it).second.begin());
+        if( ret.empty() || candidate < ret )
+          ret = candidate;
+      }
+  return ret;
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#ifndef __PARAMEDMEMCOUPLINGINDEX_HXX__
+#define __PARAMEDMEMCOUPLINGINDEX_HXX__
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace MEDCoupling
+{
+  /*!
+   * Reverse index of the couplings of a ParaMEDMEMComponent_i : IOR of the distant object -> names of the couplings
+   * connected to it. It does not depend on MPI nor CORBA.
+   */
+  class ParaMEDMEMCouplingIndex
+  {
+  public:
+    void insert(const std::string& coupling, const std::string& ior);
+    void erase(const std::string& coupling, const std::string& ior);
+    std::string find(const std::string& ior) const;
+    std::string findContaining(const std::string& ior) const;
+    bool empty() const { return _couplings_by_ior.empty(); }
+  private:
+    std::map< std::string, std::set<std::string> > _couplings_by_ior;
+  };
+}
+
+#endif
@@ -0,0 +1,102 @@
+// Copyright (C) 2007-2025  CEA, EDF
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// Author : Anthony Geay (CEA/DEN)
+
+#include "ParaMEDMEMCouplingIndexTest.hxx"
+#include "ParaMEDMEMCouplingIndex.hxx"
+
+#include <string>
+#include <sstream>
+
+void MEDCoupling::ParaMEDMEMCouplingIndexTest::testCouplingIndex1()
+{
+  // insert, lookup and removal by IOR
+  ParaMEDMEMCouplingIndex idx;
+  CPPUNIT_ASSERT(idx.empty());
+  CPPUNIT_ASSERT(idx.find("IOR:0001").empty());
+  idx.insert("IOR:0000IOR:0001","IOR:0001");
+  idx.insert("IOR:0000IOR:0002","IOR:0002");
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0001"),idx.find("IOR:0001"));
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0002"),idx.find("IOR:0002"));
+  CPPUNIT_ASSERT(idx.find("IOR:0003").empty());
+  // two couplings with the same distant object : the first in name order is returned
+  idx.insert("IOR:0000IOR:0001bis","IOR:0001");
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0001"),idx.find("IOR:0001"));
+  idx.erase("IOR:0000IOR:0001","IOR:0001");
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0001bis"),idx.find("IOR:0001"));
+  idx.erase("IOR:0000IOR:0001bis","IOR:0001");
+  CPPUNIT_ASSERT(idx.find("IOR:0001").empty());
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0002"),idx.find("IOR:0002"));
+  // removing an unknown coupling or IOR is a no-op
+  idx.erase("IOR:0000IOR:0002","IOR:0001");
+  idx.erase("unknown","IOR:0002");
+  CPPUNIT_ASSERT_EQUAL(std::string("IOR:0000IOR:0002"),idx.find("IOR:0002"));
+  idx.erase("IOR:0000IOR:0002","IOR:0002");
+  CPPUNIT_ASSERT(idx.empty());
+}
+
+void MEDCoupling::ParaMEDMEMCouplingIndexTest::testCouplingIndex2()
+{
+  // a part of a registered IOR is found by findContaining only, as with the former linear search
+  ParaMEDMEMCouplingIndex idx;
+  idx.insert("c2","IOR:010000002a");
+  idx.insert("c1","IOR:020000002a");
+  CPPUNIT_ASSERT(idx.find("IOR:0100").empty());
+  CPPUNIT_ASSERT_EQUAL(std::string("c2"),idx.findContaining("IOR:0100"));
+  CPPUNIT_ASSERT_EQUAL(std::string("c1"),idx.findContaining("0200"));
+  CPPUNIT_ASSERT_EQUAL(std::string("c2"),idx.findContaining("IOR:010000002a"));
+  // several registered IORs contain it : the first coupling in name order
+  CPPUNIT_ASSERT_EQUAL(std::string("c1"),idx.findContaining("002a"));
+  // an exact match wins over a longer IOR containing it
+  idx.insert("c3","002a");
+  CPPUNIT_ASSERT_EQUAL(std::string("c3"),idx.find("002a"));
+  CPPUNIT_ASSERT_EQUAL(std::string("c3"),idx.findContaining("002a"));
+  CPPUNIT_ASSERT(idx.findContaining("IOR:03").empty());
+}
+
+void MEDCoupling::ParaMEDMEMCouplingIndexTest::testCouplingIndex3()
+{
+  // many couplings : each one is set up and found by its exact IOR, then removed
+  const int nbOfCouplings=20000;
+  ParaMEDMEMCouplingIndex idx;
+  for(int i=0;i<nbOfCouplings;i++)
+    {
+      std::ostringstream ior; ior << "IOR:" << i;
+      std::ostringstream coupling; coupling << "IOR:local" << ior.str();
+      CPPUNIT_ASSERT(idx.find(ior.str()).empty());
+      idx.insert(coupling.str(),ior.str());
+    }
+  for(int i=0;i<nbOfCouplings;i++)
+    {
+      std::ostringstream ior; ior << "IOR:" << i;
+      std::ostringstream coupling; coupling << "IOR:local" << ior.str();
+      CPPUNIT_ASSERT_EQUAL(coupling.str(),idx.find(ior.str()));
+      CPPUNIT_ASSERT_EQUAL(coupling.str(),idx.findContaining(ior.str()));
+    }
+  CPPUNIT_ASSERT(idx.find("IOR:local").empty());
+  CPPUNIT_ASSERT(!idx.findContaining("IOR:1999").empty());
+  for(int i=0;i<nbOfCouplings;i++)
+    {
+      std::ostringstream ior; ior << "IOR:" << i;
+      std::ostringstream coupling; coupling << "IOR:local" << ior.str();
+      idx.erase(coupling.str(),ior.str());
+      CPPUNIT_ASSERT(idx.find(ior.str()).empty());
+    }
+  CPPUNIT_ASSERT(idx.empty());
+}